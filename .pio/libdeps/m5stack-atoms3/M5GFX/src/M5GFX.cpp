@@ -2291,6 +2291,11 @@ init_clear:
   board_t M5GFX::autodetect(bool use_reset, board_t board)
   {
     (void)use_reset;
+#if !defined (SDL_h_)
+    // No SDL (e.g. LGFX_LINUX_FB): nothing to detect, the panel is given with setPanel()
+    (void)board;
+    return board_t::board_unknown;
+#else
     auto p = new Panel_sdl();
     _panel_last.reset(p);
     auto pnl_cfg = p->config();
@@ -2456,6 +2461,7 @@ init_clear:
     panel(_panel_last.get());
 
     return board;
+#endif
   }
 
 
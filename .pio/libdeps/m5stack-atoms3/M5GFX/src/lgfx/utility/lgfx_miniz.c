@@ -846,6 +846,13 @@ void *tdefl_write_image_to_png_file_in_memory_ex_with_cb(const void *pImage, int
 // Output stream interface. The compressor uses this interface to write compressed data. It'll typically be called TDEFL_OUT_BUF_SIZE at a time.
 typedef lgfx_mz_bool (*tdefl_put_buf_func_ptr)(const void* pBuf, int len, void *pUser);
 
+// Streaming variant of tdefl_write_image_to_png_file_in_memory_ex_with_cb(): the PNG is handed to put_buf_func piece by
+// piece (signature, IHDR, one IDAT chunk per compressor output block, IEND) instead of being collected in memory.
+// pRow_buf must hold one scanline (w*num_chans bytes) and is passed to get_row. Heap use is one tdefl_compressor,
+// independent of the image size.
+// Returns the number of bytes written, or 0 on failure (allocation failed, or put_buf_func returned false).
+size_t tdefl_write_image_to_png_stream_with_cb(void *pRow_buf, int w, int h, int num_chans, lgfx_mz_uint level, lgfx_mz_bool flip, tdefl_get_png_row_func get_row, void *target, tdefl_put_buf_func_ptr put_buf_func, void *pPut_buf_user);
+
 // tdefl_compress_mem_to_output() compresses a block to an output stream. The above helpers use this function internally.
 lgfx_mz_bool tdefl_compress_mem_to_output(const void *pBuf, size_t buf_len, tdefl_put_buf_func_ptr pPut_buf_func, void *pPut_buf_user, int flags);
 
@@ -853,7 +860,11 @@ enum { TDEFL_MAX_HUFF_TABLES = 3, TDEFL_MAX_HUFF_SYMBOLS_0 = 288, TDEFL_MAX_HUFF
 
 // TDEFL_OUT_BUF_SIZE MUST be large enough to hold a single entire compressed output block (using static/fixed Huffman codes).
 #if TDEFL_LESS_MEMORY
-enum { TDEFL_LZ_CODE_BUF_SIZE = 24 * 1024, TDEFL_OUT_BUF_SIZE = (TDEFL_LZ_CODE_BUF_SIZE * 13 ) / 10, TDEFL_MAX_HUFF_SYMBOLS = 288, TDEFL_LZ_HASH_BITS = 12, TDEFL_LEVEL1_HASH_SIZE_MASK = 4095, TDEFL_LZ_HASH_SHIFT = (TDEFL_LZ_HASH_BITS + 2) / 3, TDEFL_LZ_HASH_SIZE = 1 << TDEFL_LZ_HASH_BITS };
+// LZ codes per block, the compressor's size follows it (24 KB: ~82 KB, 8 KB: ~45 KB). Smaller flushes blocks more often.
+#ifndef LGFX_MINIZ_LZ_CODE_BUF_SIZE
+#define LGFX_MINIZ_LZ_CODE_BUF_SIZE (24 * 1024)
+#endif
+enum { TDEFL_LZ_CODE_BUF_SIZE = LGFX_MINIZ_LZ_CODE_BUF_SIZE, TDEFL_OUT_BUF_SIZE = (TDEFL_LZ_CODE_BUF_SIZE * 13 ) / 10, TDEFL_MAX_HUFF_SYMBOLS = 288, TDEFL_LZ_HASH_BITS = 12, TDEFL_LEVEL1_HASH_SIZE_MASK = 4095, TDEFL_LZ_HASH_SHIFT = (TDEFL_LZ_HASH_BITS + 2) / 3, TDEFL_LZ_HASH_SIZE = 1 << TDEFL_LZ_HASH_BITS };
 #else
 enum { TDEFL_LZ_CODE_BUF_SIZE = 64 * 1024, TDEFL_OUT_BUF_SIZE = (TDEFL_LZ_CODE_BUF_SIZE * 13 ) / 10, TDEFL_MAX_HUFF_SYMBOLS = 288, TDEFL_LZ_HASH_BITS = 15, TDEFL_LEVEL1_HASH_SIZE_MASK = 4095, TDEFL_LZ_HASH_SHIFT = (TDEFL_LZ_HASH_BITS + 2) / 3, TDEFL_LZ_HASH_SIZE = 1 << TDEFL_LZ_HASH_BITS };
 #endif
@@ -2882,6 +2893,74 @@ void *tdefl_write_image_to_png_file_in_memory(const void *pImage, int w, int h,
   return tdefl_write_image_to_png_file_in_memory_ex(pImage, w, h, num_chans, pLen_out, 6, MZ_FALSE);
 }
 
+typedef struct
+{
+  tdefl_put_buf_func_ptr m_pPut_buf_func;
+  void *m_pPut_buf_user;
+  size_t m_total;
+  lgfx_mz_bool m_ok;
+} tdefl_png_stream;
+
+static void tdefl_png_stream_write(tdefl_png_stream *s, const void *pBuf, int len)
+{
+  if (!s->m_ok || len <= 0) return;
+  if (!s->m_pPut_buf_func(pBuf, len, s->m_pPut_buf_user)) { s->m_ok = MZ_FALSE; return; }
+  s->m_total += len;
+}
+
+static void tdefl_png_stream_chunk(tdefl_png_stream *s, const char *type, const void *pBuf, int len)
+{
+  lgfx_mz_uint8 hdr[8] = { (lgfx_mz_uint8)(len >> 24), (lgfx_mz_uint8)(len >> 16), (lgfx_mz_uint8)(len >> 8), (lgfx_mz_uint8)len,
+    (lgfx_mz_uint8)type[0], (lgfx_mz_uint8)type[1], (lgfx_mz_uint8)type[2], (lgfx_mz_uint8)type[3] };
+  lgfx_mz_uint32 c = (lgfx_mz_uint32)lgfx_mz_crc32(MZ_CRC32_INIT, hdr + 4, 4);
+  lgfx_mz_uint8 crc[4];
+  if (len) c = (lgfx_mz_uint32)lgfx_mz_crc32(c, (const lgfx_mz_uint8*)pBuf, len);
+  crc[0] = (lgfx_mz_uint8)(c >> 24); crc[1] = (lgfx_mz_uint8)(c >> 16); crc[2] = (lgfx_mz_uint8)(c >> 8); crc[3] = (lgfx_mz_uint8)c;
+  tdefl_png_stream_write(s, hdr, 8);
+  tdefl_png_stream_write(s, pBuf, len);
+  tdefl_png_stream_write(s, crc, 4);
+}
+
+static lgfx_mz_bool tdefl_png_stream_idat(const void *pBuf, int len, void *pUser)
+{
+  tdefl_png_stream *s = (tdefl_png_stream*)pUser;
+  tdefl_png_stream_chunk(s, "IDAT", pBuf, len);
+  return s->m_ok;
+}
+
+size_t tdefl_write_image_to_png_stream_with_cb(void *pRow_buf, int w, int h, int num_chans, lgfx_mz_uint level, lgfx_mz_bool flip, tdefl_get_png_row_func get_row, void *target, tdefl_put_buf_func_ptr put_buf_func, void *pPut_buf_user)
+{
+  static const lgfx_mz_uint s_tdefl_png_num_probes[11] = { 0, 1, 6, 32,  16, 32, 128, 256,  512, 768, 1500 };
+  static const lgfx_mz_uint8 sig[8] = { 0x89,0x50,0x4e,0x47,0x0d,0x0a,0x1a,0x0a };
+  static const lgfx_mz_uint8 chans[] = { 0x00, 0x00, 0x04, 0x02, 0x06 };
+  tdefl_png_stream s = { put_buf_func, pPut_buf_user, 0, MZ_TRUE };
+  const lgfx_mz_uint8 filter = 0;
+  int y, bpl = w * num_chans;
+  tdefl_compressor *pComp;
+  if (!put_buf_func || !pRow_buf || w <= 0 || h <= 0 || num_chans < 1 || num_chans > 4) return 0;
+  pComp = (tdefl_compressor *)MZ_MALLOC(sizeof(tdefl_compressor));
+  if (!pComp) return 0;
+
+  tdefl_png_stream_write(&s, sig, 8);
+  {
+    lgfx_mz_uint8 ihdr[13] = { (lgfx_mz_uint8)(w >> 24), (lgfx_mz_uint8)(w >> 16), (lgfx_mz_uint8)(w >> 8), (lgfx_mz_uint8)w,
+      (lgfx_mz_uint8)(h >> 24), (lgfx_mz_uint8)(h >> 16), (lgfx_mz_uint8)(h >> 8), (lgfx_mz_uint8)h, 8, chans[num_chans], 0, 0, 0 };
+    tdefl_png_stream_chunk(&s, "IHDR", ihdr, 13);
+  }
+
+  tdefl_init(pComp, tdefl_png_stream_idat, &s, s_tdefl_png_num_probes[MZ_MIN(10, level)] | TDEFL_WRITE_ZLIB_HEADER);
+  for (y = 0; y < h && s.m_ok; ++y)
+  {
+    tdefl_compress_buffer(pComp, &filter, 1, TDEFL_NO_FLUSH);
+    tdefl_compress_buffer(pComp, get_row((lgfx_mz_uint8*)pRow_buf, flip, w, h, y, bpl, target), bpl, TDEFL_NO_FLUSH);
+  }
+  if (s.m_ok && tdefl_compress_buffer(pComp, NULL, 0, TDEFL_FINISH) != TDEFL_STATUS_DONE) s.m_ok = MZ_FALSE;
+  MZ_FREE(pComp);
+
+  tdefl_png_stream_chunk(&s, "IEND", NULL, 0);
+  return s.m_ok ? s.m_total : 0;
+}
+
 #endif // MINIZ_NO_COMPRESSION
 
 #ifdef _MSC_VER
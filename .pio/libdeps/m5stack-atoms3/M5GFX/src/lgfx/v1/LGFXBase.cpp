@@ -197,6 +197,7 @@ namespace lgfx
 
   void LGFXBase::fillRect(int32_t x, int32_t y, int32_t w, int32_t h)
   {
+    LGFX_PROFILE_SCOPE(prof_fill_rect);
     _adjust_abs(x, w);
     _adjust_abs(y, h);
     startWrite();
@@ -1073,6 +1074,147 @@ namespace lgfx
     draw_gradient_wedgeline(ax, ay, bx, by, ar, br, gradient ); // dispatch
   }
 
+  void LGFXBase::draw_polyline(const polyline_point_t* points, size_t count, float r, const uint32_t fg_color)
+  {
+    LGFX_PROFILE_SCOPE(prof_draw_polyline);
+    if (!points || count == 0 || r < 0.0f) return;
+
+    const float ar = r + 0.5f; // center pixel, as in draw_gradient_wedgeline
+    // Farthest a pixel center can be from the path and still get some alpha
+    const float reach = ar - LoAlphaTheshold + 0.001f;
+
+    // Bounding box of the whole path, clipped once
+    float fx0 = points[0].x, fx1 = fx0, fy0 = points[0].y, fy1 = fy0;
+    for (size_t i = 1; i < count; ++i)
+    {
+      fx0 = fminf(fx0, points[i].x); fx1 = fmaxf(fx1, points[i].x);
+      fy0 = fminf(fy0, points[i].y); fy1 = fmaxf(fy1, points[i].y);
+    }
+    int32_t x0 = std::max<int32_t>(_clip_l, floorf(fx0 - r));
+    int32_t x1 = std::min<int32_t>(_clip_r,  ceilf(fx1 + r));
+    int32_t y0 = std::max<int32_t>(_clip_t, floorf(fy0 - r));
+    int32_t y1 = std::min<int32_t>(_clip_b,  ceilf(fy1 + r));
+    if (x0 > x1 || y0 > y1) return;
+
+    uint32_t segments = count > 1 ? count - 1 : 1;
+    int32_t h = y1 - y0 + 1;
+    auto order = (uint32_t*)heap_alloc((segments + h + 1) * sizeof(uint32_t));
+    if (!order)
+    { // No memory for the scan order: fall back to one wedge per segment
+      for (uint32_t i = 0; i < segments; ++i)
+      {
+        auto& a = points[i];
+        auto& b = points[count > 1 ? i + 1 : i];
+        draw_wedgeline(a.x, a.y, b.x, b.y, r, r, fg_color);
+      }
+      return;
+    }
+
+    // Bucket the segments by the first row they can touch (counting sort),
+    // so each row only visits the segments that reach it.
+    auto first_row = [&](uint32_t i)
+    {
+      float top = fminf(points[i].y, points[count > 1 ? i + 1 : i].y) - reach;
+      int32_t row = (int32_t)floorf(top) + 1 - y0;
+      return row < 0 ? 0 : row > h ? h : row;
+    };
+    uint32_t* bucket = order + segments; // h + 1 entries, row h = never
+    memset(bucket, 0, (h + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < segments; ++i) { ++bucket[first_row(i)]; }
+    for (int32_t row = 0, sum = 0; row <= h; ++row) { uint32_t n = bucket[row]; bucket[row] = sum; sum += n; }
+    for (uint32_t i = 0; i < segments; ++i) { order[bucket[first_row(i)]++] = i; }
+    // bucket[row] is now the end of that row's entries in order[]
+
+    // Coverage of one row; every pixel keeps its strongest segment so a
+    // joint is blended once instead of once per overlapping wedge.
+    int32_t w = x1 - x0 + 1;
+    auto cov = (uint8_t*)alloca(w);
+    memset(cov, 0, w);
+
+    constexpr float PixelAlphaGain = 255.0f;
+    uint32_t active = 0, pending = 0;
+
+    startWrite();
+    setColor(fg_color);
+    for (int32_t yp = y0; yp <= y1; ++yp)
+    {
+      // The front of order[] holds the segments touching this row, the
+      // back the ones not reached yet.
+      for (uint32_t end = bucket[yp - y0]; pending < end; ) { order[active++] = order[pending++]; }
+
+      int32_t cl = w, cr = -1;
+      uint32_t keep = 0;
+      for (uint32_t k = 0; k < active; ++k)
+      {
+        uint32_t i = order[k];
+        float ax = points[i].x, ay = points[i].y;
+        float bx = points[count > 1 ? i + 1 : i].x, by = points[count > 1 ? i + 1 : i].y;
+        if (fmaxf(ay, by) + reach < yp) continue; // above this row for good
+        order[keep++] = i;
+
+        if ((fabsf(ax - bx) < 0.01f) && (fabsf(ay - by) < 0.01f)) bx += 0.01f; // Avoid divide by zero
+        float bax = bx - ax, bay = by - ay;
+
+        // Part of the segment within reach of this row, widened by reach.
+        // Short segments (dense traces) just use their own x extent.
+        float xa = ax, xb = bx;
+        if (fabsf(bax) > 2.0f && fabsf(bay) >= 0.01f)
+        {
+          float inv = 1.0f / bay;
+          float t0 = (yp - reach - ay) * inv;
+          float t1 = (yp + reach - ay) * inv;
+          if (t0 > t1) std::swap(t0, t1);
+          t0 = fmaxf(t0, 0.0f);
+          t1 = fminf(t1, 1.0f);
+          if (t0 > t1) continue;
+          xa = ax + bax * t0;
+          xb = ax + bax * t1;
+        }
+        int32_t xl = std::max<int32_t>(x0,  ceilf(fminf(xa, xb) - reach)) - x0;
+        int32_t xr = std::min<int32_t>(x1, floorf(fmaxf(xa, xb) + reach)) - x0;
+        if (xl > xr) continue;
+        if (cl > xl) cl = xl;
+        if (cr < xr) cr = xr;
+
+        float ypay = yp - ay;
+        for (int32_t xp = xl; xp <= xr; ++xp)
+        {
+          float alpha = ar - wedgeLineDistance(xp + x0 - ax, ypay, bax, bay);
+          if (alpha <= LoAlphaTheshold) continue;
+          uint8_t a = (alpha > HiAlphaTheshold) ? 255 : (uint8_t)(alpha * PixelAlphaGain);
+          if (cov[xp] < a) cov[xp] = a;
+        }
+      }
+      active = keep;
+
+      // Solid runs in one fill, edge pixels blended one by one
+      for (int32_t i = cl; i <= cr; ++i)
+      {
+        if (!(i & 7) && i + 7 <= cr)
+        { // A row crossed in several places is mostly empty: skip by words
+          uint64_t word;
+          memcpy(&word, &cov[i], sizeof(word));
+          if (!word) { i += 7; continue; }
+        }
+        uint8_t a = cov[i];
+        if (!a) continue;
+        cov[i] = 0;
+        if (a == 255)
+        {
+          int32_t end = i;
+          while (end < cr && cov[end + 1] == 255) { cov[++end] = 0; }
+          writeFillRectPreclipped(x0 + i, yp, end - i + 1, 1);
+          i = end;
+          continue;
+        }
+        _panel->writeFillRectAlphaPreclipped(x0 + i, yp, 1, 1, fg_color | a << 24);
+      }
+    }
+    endWrite();
+
+    heap_free(order);
+  }
+
   void LGFXBase::fill_rect_radial_gradient(int32_t x, int32_t y, uint32_t w, uint32_t h, const colors_t gradient)
   {
       if( w<=1 || h<=1 || !gradient.colors || gradient.count==0 ) return;
@@ -1424,6 +1566,7 @@ namespace lgfx
 
   void LGFXBase::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, pixelcopy_t *param, bool use_dma)
   {
+    LGFX_PROFILE_SCOPE(prof_push_image);
     uint32_t x_mask = 7 >> (param->src_bits >> 1);
     param->src_bitwidth = (w + x_mask) & (~x_mask);
 
@@ -2218,6 +2361,7 @@ namespace lgfx
 
   size_t LGFXBase::draw_string(const char *string, int32_t x, int32_t y, textdatum_t datum, const IFont* font)
   {
+    LGFX_PROFILE_SCOPE(prof_draw_string);
     auto metrics = _font_metrics;
     if (font == nullptr)
     {
@@ -2309,6 +2453,7 @@ namespace lgfx
 
   size_t LGFXBase::write(uint8_t utf8)
   {
+    LGFX_PROFILE_SCOPE(prof_print);
     if (utf8 == '\r') return 1;
     int32_t sy = 65536 * _text_style.size_y;
     if (utf8 == '\n') {
@@ -2447,9 +2592,24 @@ namespace lgfx
     font->getDefaultMetric(&_font_metrics);
   }
 
-  /// load VLW font
+  /// load VLW font or LFA atlas
   bool LGFXBase::loadFont(const uint8_t* array)
   {
+    if (LFAfont::isAtlas(array) && LFAfont::isAligned(array))
+    { // atlas in flash or RAM: use it in place, no copy
+      this->unloadFont();
+      auto font = new LFAfont();
+      if (!font->setData(array))
+      {
+        delete font;
+        return false;
+      }
+      this->_runtime_font.reset(font);
+      this->_font = font;
+      font->getDefaultMetric(&this->_font_metrics);
+      return true;
+    }
+    // VLW, or a misaligned atlas that load_font() copies into the heap
     _font_data.set(array);
     return load_font(&_font_data);
   }
@@ -2492,12 +2652,17 @@ namespace lgfx
     this->unloadFont();
     bool result = false;
 
-#ifdef LGFX_TTFFONT_HPP_
-// TTF support.
-    uint8_t buf[4];
+    uint8_t buf[4] = { 0 };
     data->seek(0);
     data->read(buf, 4);
     data->seek(0);
+    if (memcmp(buf, "LFA1", 4) == 0)
+    {
+      this->_runtime_font.reset(new LFAfont());
+    }
+    else
+#ifdef LGFX_TTFFONT_HPP_
+// TTF support.
     if ((buf[0] == 0 && buf[1] == 1 && buf[2] == 0 && buf[3] == 0)    // ttf
      || (buf[0] == 't' && buf[1] == 't' && buf[2] == 'c' && buf[3] == 'f'))  // ttc
     {
@@ -3481,6 +3646,44 @@ namespace lgfx
     return res;
   }
 
+  struct png_stream_t
+  {
+    bool (*writer)(const void* data, size_t len, void* user);
+    void* user;
+  };
+
+  static int png_stream_put(const void* buf, int len, void* target)
+  {
+    auto stream = static_cast<png_stream_t*>(target);
+    return stream->writer(buf, len, stream->user);
+  }
+
+  size_t LGFXBase::writePng(bool (*writer)(const void* data, size_t len, void* user), void* user, int32_t x, int32_t y, int32_t w, int32_t h)
+  {
+    if (writer == nullptr) return 0;
+    if (w == 0) w = width()  - x;
+    if (h == 0) h = height() - y;
+    if (_adjust_abs(x, w)||_adjust_abs(y, h)) return 0;
+    if (x < 0) { w += x; x = 0; }
+    if (w > width() - x)  w = width()  - x;
+    if (w < 1) return 0;
+    if (y < 0) { h += y; y = 0; }
+    if (h > height() - y) h = height() - y;
+    if (h < 1) return 0;
+
+    void* rgbBuffer = heap_alloc_dma(w * 3);
+    if (rgbBuffer == nullptr) return 0;
+
+    png_encoder_t enc = { this, x, y };
+    png_stream_t stream = { writer, user };
+
+    auto res = tdefl_write_image_to_png_stream_with_cb(rgbBuffer, w, h, 3, 6, 0, (tdefl_get_png_row_func)png_encoder_get_row, &enc, png_stream_put, &stream);
+
+    heap_free(rgbBuffer);
+
+    return res;
+  }
+
 //----------------------------------------------------------------------------
 
   void LGFXBase::prepareTmpTransaction(DataWrapper* data)
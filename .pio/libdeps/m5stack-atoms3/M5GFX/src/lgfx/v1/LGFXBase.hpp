@@ -29,6 +29,7 @@ Contributors:
 #include "misc/colortype.hpp"
 #include "misc/pixelcopy.hpp"
 #include "misc/DataWrapper.hpp"
+#include "misc/profiler.hpp"
 #include "lgfx_fonts.hpp"
 #include "Touch.hpp"
 #include "panel/Panel_Device.hpp"
@@ -52,6 +53,13 @@ namespace lgfx
 #define LGFX_PRINTF_ENABLED
 #endif
 
+  /// Vertex for drawPolyline; float so traces can keep sub-pixel positions
+  struct polyline_point_t
+  {
+    float x;
+    float y;
+  };
+
 
   class LGFXBase
 #if defined (ARDUINO)
@@ -281,6 +289,10 @@ namespace lgfx
     LGFX_INLINE_T void drawWedgeLine    ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, float r0, float r1, const T& color ) { draw_wedgeline(x0, y0, x1, y1, r0, r1, convert_to_rgb888(color)); }
                   void drawWedgeLine    ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, float r0, float r1, const colors_t colors ) { draw_gradient_wedgeline(x0, y0, x1, y1, r0, r1, colors); }
     LGFX_INLINE_T void drawSpot         ( int32_t x, int32_t y, float r, const T& color )    { draw_wedgeline(x, y, x, y, r, r, convert_to_rgb888(color)); }
+    /// @brief Anti-aliased polyline, same look as drawWideLine per segment.
+    /// Clipping and the transaction are set up once, and each pixel is blended once even where segments overlap at a joint.
+    /// Faster than one drawWideLine per segment from r=1; for hairlines (r=0.5) it is about 10% slower, the cost of the single blend.
+    LGFX_INLINE_T void drawPolyline     ( const polyline_point_t* points, size_t count, float r, const T& color ) { draw_polyline(points, count, r, convert_to_rgb888(color)); }
                   void drawGradientSpot ( int32_t x, int32_t y, float r, const colors_t gr ) { draw_gradient_wedgeline(x, y, x, y, r, r, gr); }
                   void drawGradientHLine( int32_t x, int32_t y, uint32_t w, const colors_t colors ) { draw_gradient_line(x, y, x+w, y, colors); }
                   void drawGradientVLine( int32_t x, int32_t y, uint32_t h, const colors_t colors ) { draw_gradient_line(x, y, x, y+h, colors); }
@@ -795,6 +807,11 @@ namespace lgfx
 
     void setFont(const IFont* font);
 
+    /// Use a glyph cache for RLE fonts (Font4/6/7/8); nullptr disables it.
+    /// The cache is not owned and may be shared between targets.
+    LGFX_INLINE void setGlyphCache(GlyphCache* cache) { _glyph_cache = cache; }
+    LGFX_INLINE GlyphCache* getGlyphCache(void) const { return _glyph_cache; }
+
     /// load VLW font
     bool loadFont(const uint8_t* array);
 
@@ -975,6 +992,12 @@ namespace lgfx
 
     void* createPng( size_t* datalen, int32_t x = 0, int32_t y = 0, int32_t width = 0, int32_t height = 0);
 
+    /// Encode a region as PNG and pass it to writer(data, len, user) piece by piece (e.g. straight to a socket or file).
+    /// Only one scanline and the deflate state are allocated, independent of the image size.
+    /// width / height of 0 extend the region to the right / bottom edge.
+    /// @return total bytes written, or 0 on failure or when writer returns false.
+    size_t writePng(bool (*writer)(const void* data, size_t len, void* user), void* user, int32_t x = 0, int32_t y = 0, int32_t width = 0, int32_t height = 0);
+
     void releasePngMemory(void);
 
     template<typename T>
@@ -1033,6 +1056,7 @@ namespace lgfx
     TextStyle _text_style;
     FontMetrics _font_metrics = { 6, 6, 0, 8, 8, 0, 7 }; // Font0 default metric
     const IFont* _font = &fonts::Font0;
+    GlyphCache* _glyph_cache = nullptr;
 
     std::shared_ptr<RunTimeFont> _runtime_font;  // run-time generated font
     std::shared_ptr<DataWrapper> _font_file;  // run-time font file
@@ -1336,6 +1360,7 @@ namespace lgfx
 
     void draw_wedgeline         (float x0, float y0, float x1, float y1, float r0, float r1, const uint32_t fg_color);
     void draw_gradient_wedgeline(float x0, float y0, float x1, float y1, float r0, float r1, const colors_t gradient );
+    void draw_polyline          (const polyline_point_t* points, size_t count, float r, const uint32_t fg_color);
 
     void fill_rect_radial_gradient(int32_t x, int32_t y, uint32_t w, uint32_t h, const colors_t gradient);
     void fill_rect_radial_gradient(int32_t x, int32_t y, uint32_t w, uint32_t h, const uint32_t colorstart, const uint32_t colorend );
@@ -19,6 +19,8 @@ Contributors:
 #include "LGFX_Sprite.hpp"
 
 #include "misc/common_function.hpp"
+#include "misc/DividedFrameBuffer.hpp"
+#include "panel/Panel_FrameBufferBase.hpp"
 
 #ifdef min
 #undef min
@@ -684,6 +686,233 @@ namespace lgfx
     }
   }
 
+//----------------------------------------------------------------------------
+
+  /// Sprite storage split into DividedFrameBuffer blocks, drawn through the line table of Panel_FrameBufferBase.
+  struct Panel_DividedSprite : public Panel_FrameBufferBase
+  {
+    DividedFrameBuffer _fb;
+
+    ~Panel_DividedSprite(void) { release(); }
+
+    bool create(int32_t w, int32_t h, int32_t block_lines, color_depth_t depth, bool psram)
+    {
+      release();
+      setColorDepth(depth);
+      size_t bytes = _write_bits >> 3;
+      if (w < 1 || h < 1 || bytes == 0 || (depth & color_depth_t::has_palette)) { return false; }
+      if (block_lines < 1 || block_lines > h) { block_lines = h; }
+
+      if (!_fb.create(w * bytes, h, block_lines, psram ? DividedFrameBuffer::full_psram : DividedFrameBuffer::no_psram)) { return false; }
+      _lines_buffer = static_cast<uint8_t**>(heap_alloc(h * sizeof(uint8_t*)));
+      if (_lines_buffer == nullptr)
+      {
+        _fb.release();
+        return false;
+      }
+      for (int32_t y = 0; y < h; ++y) { _lines_buffer[y] = _fb.getLineBuffer(y); }
+      for (size_t i = 0; i < _fb.getBlockCount(); ++i)
+      {
+        size_t lines = std::min<size_t>(block_lines, h - i * block_lines);
+        memset(_fb.getBlockBuffer(i), 0, lines * w * bytes);
+      }
+
+      _cfg.memory_width  = _cfg.panel_width  = w;
+      _cfg.memory_height = _cfg.panel_height = h;
+      _cfg.bus_shared = false;
+      _range_mod.top = _range_mod.left = INT16_MAX;
+      _range_mod.right = _range_mod.bottom = 0;
+      setRotation(_rotation);
+      return true;
+    }
+
+    void release(void)
+    {
+      if (_lines_buffer)
+      {
+        heap_free(_lines_buffer);
+        _lines_buffer = nullptr;
+      }
+      _fb.release();
+    }
+  };
+
+  bool LGFX_Sprite::createDividedSprite(int32_t w, int32_t h, int32_t block_lines)
+  {
+    deleteSprite();
+    if (_panel_divided == nullptr) { _panel_divided = new Panel_DividedSprite(); }
+    _panel_divided->setRotation(getRotation());
+    if (!_panel_divided->create(w, h, block_lines, getColorDepth(), _psram)) { return false; }
+    _panel = _panel_divided;
+
+    _sw = width();
+    _clip_r = _sw - 1;
+    _xpivot = _sw >> 1;
+
+    _sh = height();
+    _clip_b = _sh - 1;
+    _ypivot = _sh >> 1;
+
+    _clip_l = _clip_t = _sx = _sy = 0;
+    return true;
+  }
+
+  size_t LGFX_Sprite::getBlockCount(void) const
+  {
+    return isDivided() ? _panel_divided->_fb.getBlockCount() : (getBuffer() ? 1 : 0);
+  }
+
+  void LGFX_Sprite::release_divided(void)
+  {
+    if (!isDivided()) { return; }
+    _panel_divided->release();
+    _panel = &_panel_sprite;
+  }
+
+  void LGFX_Sprite::destroy_divided(void)
+  {
+    release_divided();
+    delete _panel_divided;
+    _panel_divided = nullptr;
+  }
+
+  void LGFX_Sprite::push_divided(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp)
+  {
+    auto& fb = _panel_divided->_fb;
+    int32_t w = _panel_divided->config().panel_width;
+    int32_t h = _panel_divided->config().panel_height;
+    int32_t lines = fb.getBlockLines();
+
+    // One pushImage per block; each block is contiguous, so the destination keeps its fast (and DMA) paths.
+    dst->startWrite();
+    for (int32_t i = 0, by = 0; by < h; ++i, by += lines)
+    {
+      auto block = fb.getBlockBuffer(i);
+      pixelcopy_t p(block, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), nullptr, transp);
+      dst->pushImage(x, y + by, w, std::min(lines, h - by), &p, heap_capable_dma(block));
+    }
+    dst->endWrite();
+  }
+
+  uint32_t LGFX_Sprite::read_divided_value(int32_t x, int32_t y)
+  {
+    auto& fb = _panel_divided->_fb;
+    if ((uint32_t)x >= _panel_divided->config().panel_width || (uint32_t)y >= fb.getTotalLines()) { return 0; }
+    size_t bytes = _write_conv.bits >> 3;
+    auto src = &fb.getLineBuffer(y)[x * bytes];
+    uint32_t res = 0;
+    memcpy(&res, src, bytes);
+    return res;
+  }
+
+//----------------------------------------------------------------------------
+
+  void* LGFX_Sprite::createBackBuffer(void)
+  {
+    deleteBackBuffer();
+    auto img = _panel_sprite.getSpriteBuffer();
+    if (!*img) { return nullptr; }
+    // same size and memory type as the sprite buffer, including the spare pixel at the end.
+    size_t len = img->length() ? img->length() : bufferLength() + 4;
+    _back_buffer.reset(len, img->source() == AllocationSource::Psram ? AllocationSource::Psram : AllocationSource::Dma);
+    return _back_buffer.get();
+  }
+
+  void LGFX_Sprite::deleteBackBuffer(void)
+  {
+    waitPushDMA();
+    _back_buffer.release();
+  }
+
+  void LGFX_Sprite::push_sprite_dma(LovyanGFX* dst, int32_t x, int32_t y)
+  {
+    LGFX_PROFILE_SCOPE(prof_push_sprite);
+    if (dst == nullptr || (_img == nullptr && !isDivided())) { return; }
+
+    uint32_t t0 = micros();
+    // the bus, and with a back buffer the buffer drawn next, must be free of the previous frame.
+    waitPushDMA();
+    uint32_t t1 = micros();
+
+    dst->startWrite();
+    push_sprite(dst, x, y);
+    _dma_dst = dst;
+    _dma_start_us = t1;
+    ++_dma_stats.frames;
+
+    if (!hasBackBuffer())
+    {
+      _dma_cpu_us = micros() - t1;
+      waitPushDMA();
+      _dma_stats.push_us = micros() - t0;
+      return;
+    }
+
+    // draw into the other buffer from now on, starting from what is being sent.
+    // Only the part that went out (the destination clip) is copied: anything drawn since the
+    // previous push has to be inside it, the rest of the two buffers is already the same.
+    _panel_sprite._img.swap(_back_buffer);
+    _img = _panel_sprite.getBuffer();
+    {
+      int32_t cx, cy, cw, ch;
+      dst->getClipRect(&cx, &cy, &cw, &ch);
+      int32_t l = std::max<int32_t>(0, cx - x);
+      int32_t t = std::max<int32_t>(0, cy - y);
+      int32_t r = std::min<int32_t>(_panel_sprite._panel_width,  cx + cw - x);
+      int32_t b = std::min<int32_t>(_panel_sprite._panel_height, cy + ch - y);
+      if (l < r && t < b)
+      {
+        size_t stride = (_panel_sprite._bitwidth * _write_conv.bits) >> 3;
+        auto d = static_cast<uint8_t*>(_img) + t * stride;
+        auto s = static_cast<const uint8_t*>(_back_buffer.get()) + t * stride;
+        if (l == 0 && r == (int32_t)_panel_sprite._panel_width)
+        { // whole lines are contiguous
+          memcpy(d, s, (b - t) * stride);
+        }
+        else
+        {
+          size_t xs = (l * _write_conv.bits) >> 3;
+          size_t xe = (r * _write_conv.bits + 7) >> 3;
+          for (int32_t i = t; i < b; ++i, d += stride, s += stride)
+          {
+            memcpy(d + xs, s + xs, xe - xs);
+          }
+        }
+      }
+    }
+
+    uint32_t t2 = micros();
+    _dma_cpu_us = t2 - t1;
+    _dma_stats.push_us = t2 - t0;
+  }
+
+  void LGFX_Sprite::waitPushDMA(void)
+  {
+    auto dst = _dma_dst;
+    if (dst == nullptr) { return; }
+    _dma_dst = nullptr;
+
+    uint32_t t0 = micros();
+    bool busy = dst->dmaBusy();
+    dst->waitDMA();
+    dst->endWrite();
+    uint32_t t1 = micros();
+
+    // Completion is only observed when the transfer was still running here.
+    // Otherwise it ended somewhere before t0; the previous measurement is used
+    // as the estimate (frames are usually the same size), capped at t0.
+    uint32_t elapsed = (busy ? t1 : t0) - _dma_start_us;
+    if (busy || _dma_stats.transfer_us == 0 || _dma_stats.transfer_us > elapsed)
+    {
+      _dma_stats.transfer_us = elapsed;
+    }
+    _dma_stats.wait_us = t1 - t0;
+
+    uint32_t held = _dma_cpu_us + (busy ? _dma_stats.wait_us : 0);
+    _dma_stats.saved_us = (_dma_stats.transfer_us > held) ? _dma_stats.transfer_us - held : 0;
+    _dma_stats.total_saved_us += _dma_stats.saved_us;
+  }
+
 //----------------------------------------------------------------------------
 
   bool LGFX_Sprite::create_from_bmp_file(DataWrapper* data, const char *path) {
@@ -101,6 +101,8 @@ namespace lgfx
     uint_fast16_t _bitwidth;
   };
 
+  struct Panel_DividedSprite;
+
   class LGFX_Sprite : public LovyanGFX
   {
   public:
@@ -125,6 +127,7 @@ namespace lgfx
     virtual ~LGFX_Sprite() {
       deleteSprite();
       deletePalette();
+      destroy_divided();
     }
 
     void deletePalette(void)
@@ -135,6 +138,7 @@ namespace lgfx
 
     void deleteSprite(void)
     {
+      deleteBackBuffer();
 //      _bitwidth = 0;
       _clip_l = 0;
       _clip_t = 0;
@@ -143,6 +147,7 @@ namespace lgfx
 
       _panel_sprite.deleteSprite();
       _img = nullptr;
+      release_divided();
     }
 
     void setPsram( bool enabled )
@@ -171,6 +176,8 @@ namespace lgfx
 
     void* createSprite(int32_t w, int32_t h)
     {
+      deleteBackBuffer();
+      release_divided();
       _img = _panel_sprite.createSprite(w, h, &_write_conv, _psram);
       if (_img) {
         if (getColorDepth() & color_depth_t::has_palette)
@@ -194,6 +201,14 @@ namespace lgfx
       return _img;
     }
 
+    /// Allocates the sprite as blocks of block_lines lines (DividedFrameBuffer) instead of one buffer,
+    /// so a canvas larger than the biggest free heap block can still be created.
+    /// 8/16/24bpp only; set the color depth first. getBuffer() returns nullptr,
+    /// pushSprite sends one block at a time and the rotate/zoom/affine pushes are not available.
+    bool createDividedSprite(int32_t w, int32_t h, int32_t block_lines);
+    LGFX_INLINE bool isDivided(void) const { return _panel != &_panel_sprite; }
+    size_t getBlockCount(void) const;
+
     bool createFromBmp(DataWrapper* data);
 
     bool createFromBmp(const uint8_t *bmp_data, uint32_t bmp_len = ~0u) {
@@ -317,6 +332,7 @@ namespace lgfx
 
       _panel_sprite.setColorDepth(_write_conv.depth);
 
+      if (isDivided()) { deleteSprite(); }
       if (_panel_sprite.getBuffer() == nullptr) return nullptr;
       auto w = _panel_sprite._panel_width;
       auto h = _panel_sprite._panel_height;
@@ -325,7 +341,7 @@ namespace lgfx
       return createSprite(w, h);
     }
 
-    uint32_t readPixelValue(int32_t x, int32_t y) { return _panel_sprite.readPixelValue(x, y); }
+    uint32_t readPixelValue(int32_t x, int32_t y) { return isDivided() ? read_divided_value(x, y) : _panel_sprite.readPixelValue(x, y); }
 
     template<typename T>
     LGFX_INLINE void fillSprite (const T& color) { fillScreen(color); }
@@ -337,6 +353,41 @@ namespace lgfx
     LGFX_INLINE void pushSprite(                int32_t x, int32_t y) { push_sprite(_parent, x, y); }
     LGFX_INLINE void pushSprite(LovyanGFX* dst, int32_t x, int32_t y) { push_sprite(    dst, x, y); }
 
+//----------------------------------------------------------------------------
+// Double buffered push.
+// pushSpriteDMA starts the transfer and returns while DMA is still reading the buffer.
+// With a back buffer the sprite then switches to the other buffer (holding a copy of what
+// was sent), so the next frame can be drawn during the transfer. Only the region sent (the
+// destination's clip rect) is copied over, so everything drawn since the previous push must
+// be inside it.
+// Without one it waits for the transfer, like pushSprite.
+// The destination stays in a write transaction until the transfer is waited for.
+
+    struct dma_push_stats_t
+    {
+      uint32_t frames = 0;
+      uint32_t push_us = 0;      // CPU time inside the last pushSpriteDMA (incl. waiting for the previous frame)
+      uint32_t wait_us = 0;      // time blocked waiting for the last transfer
+      uint32_t transfer_us = 0;  // last transfer, start to observed completion
+      uint32_t saved_us = 0;     // part of the last transfer the CPU was free to draw
+      uint64_t total_saved_us = 0;
+    };
+
+    /// allocates a second buffer the size of the sprite.
+    void* createBackBuffer(void);
+    void deleteBackBuffer(void);
+    LGFX_INLINE bool hasBackBuffer(void) const { return _back_buffer.get() != nullptr; }
+
+                void pushSpriteDMA(                int32_t x, int32_t y) { push_sprite_dma(_parent, x, y); }
+                void pushSpriteDMA(LovyanGFX* dst, int32_t x, int32_t y) { push_sprite_dma(    dst, x, y); }
+
+    /// waits for the last pushSpriteDMA transfer to complete.
+    void waitPushDMA(void);
+    LGFX_INLINE bool pushDMABusy(void) const { return _dma_dst && _dma_dst->dmaBusy(); }
+
+    LGFX_INLINE const dma_push_stats_t& getDMAPushStats(void) const { return _dma_stats; }
+    LGFX_INLINE void resetDMAPushStats(void) { _dma_stats = dma_push_stats_t(); }
+
     template<typename T> void pushRotated(                float angle, const T& transp) { push_rotate_zoom(_parent, _parent->getPivotX(), _parent->getPivotY(), angle, 1.0f, 1.0f, _write_conv.convert(transp) & _write_conv.colormask); }
     template<typename T> void pushRotated(LovyanGFX* dst, float angle, const T& transp) { push_rotate_zoom(dst    , dst    ->getPivotX(), dst    ->getPivotY(), angle, 1.0f, 1.0f, _write_conv.convert(transp) & _write_conv.colormask); }
                          void pushRotated(                float angle                 ) { push_rotate_zoom(_parent, _parent->getPivotX(), _parent->getPivotY(), angle, 1.0f, 1.0f); }
@@ -393,6 +444,14 @@ namespace lgfx
 
     SpriteBuffer _palette;
 
+    Panel_DividedSprite* _panel_divided = nullptr;
+
+    SpriteBuffer _back_buffer;
+    LovyanGFX* _dma_dst = nullptr;
+    uint32_t _dma_start_us = 0;
+    uint32_t _dma_cpu_us = 0;
+    dma_push_stats_t _dma_stats;
+
     bool _psram = false;
 
     bool create_palette(void)
@@ -418,29 +477,42 @@ namespace lgfx
 
     bool create_from_bmp_file(DataWrapper* data, const char *path);
 
+    void release_divided(void);
+    void destroy_divided(void);
+    void push_divided(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp);
+    uint32_t read_divided_value(int32_t x, int32_t y);
+
     void push_sprite(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      LGFX_PROFILE_SCOPE(prof_push_sprite);
+      if (isDivided()) { push_divided(dst, x, y, transp); return; }
       pixelcopy_t p(_img, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), _palette, transp);
       dst->pushImage(x, y, _panel_sprite._panel_width, _panel_sprite._panel_height, &p, _panel_sprite.getSpriteBuffer()->use_dma()); // DMA disable with use SPIRAM
     }
 
+    void push_sprite_dma(LovyanGFX* dst, int32_t x, int32_t y);
+
     void push_rotate_zoom(LovyanGFX* dst, float x, float y, float angle, float zoom_x, float zoom_y, uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (isDivided()) { return; }
       dst->pushImageRotateZoom(x, y, _xpivot, _ypivot, angle, zoom_x, zoom_y, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
     }
 
     void push_rotate_zoom_aa(LovyanGFX* dst, float x, float y, float angle, float zoom_x, float zoom_y, uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (isDivided()) { return; }
       dst->pushImageRotateZoomWithAA(x, y, _xpivot, _ypivot, angle, zoom_x, zoom_y, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
     }
 
     void push_affine(LovyanGFX* dst, const float matrix[6], uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (isDivided()) { return; }
       dst->pushImageAffine(matrix, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
     }
 
     void push_affine_aa(LovyanGFX* dst, const float matrix[6], uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (isDivided()) { return; }
       dst->pushImageAffineWithAA(matrix, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
     }
 
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <math.h>
+#include <string.h>
 #include "../internal/algorithm.h"
 
 #ifdef min
@@ -262,6 +263,37 @@ namespace lgfx
     return draw_char_bmp(gfx, x, y, style, font_addr, fontWidth, fontHeight, bytesize, 0);
   }
 
+  template <typename TFunc>
+  static void rle_runs(const uint8_t* font_addr, uint_fast16_t fontWidth, uint_fast16_t fontHeight, int32_t sx, int32_t sy, TFunc&& fill)
+  {
+    bool flg = false;
+    uint_fast8_t line = 0, i = 1, j = 0;
+    int32_t len;
+    int32_t y0 = 0;
+    int32_t y1 = sy >> 16;
+    int32_t x0 = 0;
+    do {
+      line = pgm_read_byte(font_addr++);
+      flg = line & 0x80;
+      line = (line & 0x7F)+1;
+      do {
+        len = (line > fontWidth - j) ? fontWidth - j : line;
+        line -= len;
+        j += len;
+        int32_t x1 = (j * sx) >> 16;
+        fill(x0, y0, x1 - x0, y1 - y0, flg);
+        x0 = x1;
+        if (j == fontWidth)
+        {
+          j = 0;
+          x0 = 0;
+          y0 = y1;
+          y1 = (++i * sy) >> 16;
+        }
+      } while (line);
+    } while (i <= fontHeight);
+  }
+
   size_t RLEfont::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t code, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
   { // RLE font
     (void)metrics;
@@ -283,45 +315,142 @@ namespace lgfx
     int32_t sx = 65536 * style->size_x;
     int32_t sy = 65536 * style->size_y;
 
+    auto cache = gfx->getGlyphCache();
+    auto depth = gfx->getColorDepth();
+    uint_fast8_t bytes = (depth & color_depth_t::bit_mask) >> 3;
+    if (cache && fillbg && bytes && !gfx->hasPalette())
+    {
+      int32_t w = (fontWidth  * sx) >> 16;
+      int32_t h = (fontHeight * sy) >> 16;
+      GlyphCache::key_t key = { this, colortbl[1], colortbl[0], sx, sy, code, depth };
+      auto img = cache->find(key);
+      if (img == nullptr)
+      {
+        auto buf = (uint8_t*)cache->insert(key, w * h * bytes);
+        if (buf)
+        {
+          int32_t stride = w * bytes;
+          rle_runs(font_addr, fontWidth, fontHeight, sx, sy, [&](int32_t rx, int32_t ry, int32_t rw, int32_t rh, bool flg)
+          {
+            if (rw <= 0 || rh <= 0) return;
+            auto dst = &buf[ry * stride + rx * bytes];
+            for (int32_t k = 0; k < rw; ++k) { memcpy(&dst[k * bytes], &colortbl[flg], bytes); }
+            while (--rh) { memcpy(&dst[stride], dst, rw * bytes); dst += stride; }
+          });
+          img = buf;
+        }
+      }
+      if (img)
+      {
+        pixelcopy_t pc(img, depth, depth);
+        gfx->pushImage(x, y, w, h, &pc);
+        return w;
+      }
+    }
+
     //if ((x <= clip_right) && (clip_left < (x + fontWidth  * sx ))
     // && (y <= clip_bottom) && (clip_top < (y + fontHeight * sy )))
     {
-      bool flg = false;
-      uint_fast8_t line = 0, i = 1, j = 0;
-      int32_t len;
-      int32_t y0 = 0;
-      int32_t y1 = sy >> 16;
-      int32_t x0 = 0;
       gfx->startWrite();
-      do {
-        line = pgm_read_byte(font_addr++);
-        flg = line & 0x80;
-        line = (line & 0x7F)+1;
-        do {
-          len = (line > fontWidth - j) ? fontWidth - j : line;
-          line -= len;
-          j += len;
-          int32_t x1 = (j * sx) >> 16;
-          if (fillbg || flg) {
-            gfx->setRawColor(colortbl[flg]);
-            gfx->writeFillRect( x + x0, y + y0, x1 - x0, y1 - y0);
-          }
-          x0 = x1;
-          if (j == fontWidth)
-          {
-            j = 0;
-            x0 = 0;
-            y0 = y1;
-            y1 = (++i * sy) >> 16;
-          }
-        } while (line);
-      } while (i <= fontHeight);
+      rle_runs(font_addr, fontWidth, fontHeight, sx, sy, [&](int32_t rx, int32_t ry, int32_t rw, int32_t rh, bool flg)
+      {
+        if (fillbg || flg) {
+          gfx->setRawColor(colortbl[flg]);
+          gfx->writeFillRect( x + rx, y + ry, rw, rh);
+        }
+      });
       gfx->endWrite();
     }
 
     return fontWidth * sx >> 16;
   }
 
+//----------------------------------------------------------------------------
+
+  bool GlyphCache::init(size_t max_bytes, uint_fast8_t max_entries)
+  {
+    release();
+    if (!max_entries) return false;
+    _entries = (entry_t*)heap_alloc(max_entries * sizeof(entry_t));
+    if (!_entries) return false;
+    memset(_entries, 0, max_entries * sizeof(entry_t));
+    _max_entries = max_entries;
+    _max_bytes = max_bytes;
+    return true;
+  }
+
+  void GlyphCache::release(void)
+  {
+    clear();
+    if (_entries) { heap_free(_entries); }
+    _entries = nullptr;
+    _max_entries = 0;
+    _max_bytes = 0;
+  }
+
+  void GlyphCache::clear(void)
+  {
+    for (uint_fast8_t i = 0; i < _max_entries; ++i)
+    {
+      if (_entries[i].data) { heap_free(_entries[i].data); }
+      _entries[i].data = nullptr;
+    }
+    _used_bytes = 0;
+  }
+
+  void GlyphCache::evict(entry_t* entry)
+  {
+    heap_free(entry->data);
+    entry->data = nullptr;
+    _used_bytes -= entry->bytes;
+    ++_evicts;
+  }
+
+  const void* GlyphCache::find(const key_t& key)
+  {
+    for (uint_fast8_t i = 0; i < _max_entries; ++i)
+    {
+      auto e = &_entries[i];
+      if (e->data && e->key == key)
+      {
+        e->stamp = ++_stamp;
+        ++_hits;
+        return e->data;
+      }
+    }
+    ++_misses;
+    return nullptr;
+  }
+
+  void* GlyphCache::insert(const key_t& key, size_t bytes)
+  {
+    if (bytes == 0 || bytes > _max_bytes) return nullptr;
+
+    for (;;)
+    {
+      entry_t* free_slot = nullptr;
+      entry_t* oldest = nullptr;
+      for (uint_fast8_t i = 0; i < _max_entries; ++i)
+      {
+        auto e = &_entries[i];
+        if (e->data == nullptr) { if (!free_slot) free_slot = e; }
+        else if (!oldest || (int32_t)(e->stamp - oldest->stamp) < 0) { oldest = e; }
+      }
+      if (free_slot && _used_bytes + bytes <= _max_bytes)
+      {
+        auto data = heap_alloc(bytes);
+        if (!data) return nullptr;
+        free_slot->key = key;
+        free_slot->data = data;
+        free_slot->bytes = bytes;
+        free_slot->stamp = ++_stamp;
+        _used_bytes += bytes;
+        return data;
+      }
+      if (!oldest) return nullptr;
+      evict(oldest);
+    }
+  }
 
 //----------------------------------------------------------------------------
 
@@ -876,44 +1005,10 @@ label_nextbyte: /// 次のデータを取得する;
 
 //----------------------------------------------------------------------------
 
-  size_t VLWfont::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t code, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
+  // Draws one 8bpp coverage bitmap (VLW / LFA glyph). pixel holds w*h
+  // bytes; 0xFF is solid foreground.
+  static size_t draw_alpha_glyph(LGFXBase* gfx, int32_t x, int32_t y, const uint8_t* pixel, int32_t w, int32_t h, int32_t sx, int32_t sy, int32_t xAdvance, int32_t xoffset, int32_t yoffset, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x)
   {
-    auto file = this->_fontData;
-
-    uint32_t buffer[6] = {0};
-    uint16_t gNum = 0;
-
-    int32_t sy = 65536 * style->size_y;
-    y += (metrics->y_offset * sy) >> 16;
-
-    if (code == 0x20) {
-      gNum = 0xFFFF;
-      buffer[2] = getSwap32(this->spaceWidth);
-    } else if (!this->getUnicodeIndex(code, &gNum)) {
-      return drawCharDummy(gfx, x, y, this->spaceWidth, metrics->height, style, filled_x);
-    } else {
-      file->preRead();
-      file->seek(28 + gNum * 28);
-      file->read((uint8_t*)buffer, 24);
-      file->seek(this->gBitmap[gNum]);
-    }
-
-
-    int32_t h        = getSwap32(buffer[0]); // Height of glyph
-    int32_t w        = getSwap32(buffer[1]); // Width of glyph
-    int32_t sx       = 65536 * style->size_x;
-    int32_t xAdvance = (getSwap32(buffer[2]) * sx) >> 16; // xAdvance - to move x cursor
-    int32_t xoffset  = ((int32_t)((int8_t)getSwap32(buffer[4])) * sx) >> 16; // x delta from cursor
-    int32_t dY       = (int16_t)getSwap32(buffer[3]); // y delta from baseline
-    int32_t yoffset  = (this->maxAscent - dY);
-//      int32_t yoffset = (gfx->_font_metrics.y_offset) - dY;
-
-    auto pixel = (uint8_t*)alloca(w * h);
-    if (gNum != 0xFFFF) {
-      file->read(pixel, w * h);
-      file->postRead();
-    }
-
     gfx->startWrite();
 
     uint32_t colortbl[2] = {gfx->getColorConverter()->convert(style->back_rgb888), gfx->getColorConverter()->convert(style->fore_rgb888)};
@@ -1064,6 +1159,204 @@ label_nextbyte: /// 次のデータを取得する;
     return xAdvance;
   }
 
+  size_t VLWfont::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t code, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
+  {
+    auto file = this->_fontData;
+
+    uint32_t buffer[6] = {0};
+    uint16_t gNum = 0;
+
+    int32_t sy = 65536 * style->size_y;
+    y += (metrics->y_offset * sy) >> 16;
+
+    if (code == 0x20) {
+      gNum = 0xFFFF;
+      buffer[2] = getSwap32(this->spaceWidth);
+    } else if (!this->getUnicodeIndex(code, &gNum)) {
+      return drawCharDummy(gfx, x, y, this->spaceWidth, metrics->height, style, filled_x);
+    } else {
+      file->preRead();
+      file->seek(28 + gNum * 28);
+      file->read((uint8_t*)buffer, 24);
+      file->seek(this->gBitmap[gNum]);
+    }
+
+
+    int32_t h        = getSwap32(buffer[0]); // Height of glyph
+    int32_t w        = getSwap32(buffer[1]); // Width of glyph
+    int32_t sx       = 65536 * style->size_x;
+    int32_t xAdvance = (getSwap32(buffer[2]) * sx) >> 16; // xAdvance - to move x cursor
+    int32_t xoffset  = ((int32_t)((int8_t)getSwap32(buffer[4])) * sx) >> 16; // x delta from cursor
+    int32_t dY       = (int16_t)getSwap32(buffer[3]); // y delta from baseline
+    int32_t yoffset  = (this->maxAscent - dY);
+//      int32_t yoffset = (gfx->_font_metrics.y_offset) - dY;
+
+    auto pixel = (uint8_t*)alloca(w * h);
+    if (gNum != 0xFFFF) {
+      file->read(pixel, w * h);
+      file->postRead();
+    }
+
+    return draw_alpha_glyph(gfx, x, y, pixel, w, h, sx, sy, xAdvance, xoffset, yoffset, style, metrics, filled_x);
+  }
+
+//----------------------------------------------------------------------------
+
+  LFAfont::~LFAfont() {
+    unloadFont();
+  }
+
+  bool LFAfont::isAtlas(const void* data)
+  {
+    return data && memcmp(data, "LFA1", 4) == 0;
+  }
+
+  bool LFAfont::isAligned(const void* data)
+  {
+    return ((uintptr_t)data % alignof(glyph_t)) == 0;
+  }
+
+  bool LFAfont::setData(const void* data, size_t length)
+  {
+    // The tables are read in place as 16/32-bit fields; Xtensa faults on
+    // unaligned 32-bit loads, so misaligned input is refused, not read.
+    if (length < pages_offset || !isAtlas(data) || !isAligned(data)) return false;
+    auto atlas  = (const uint8_t*)data;
+    auto header = (const header_t*)atlas;
+    size_t size = header->file_size;
+    if (size > length
+     || header->glyph_offset % alignof(glyph_t)
+     || header->glyph_offset < pages_offset + header->page_count * 256u * sizeof(uint16_t)
+     || header->bitmap_offset < header->glyph_offset + header->glyph_count * sizeof(glyph_t)
+     || header->bitmap_offset > size) return false;
+
+    auto page_index = (const uint16_t*)(atlas + page_index_offset);
+    auto pages      = (const uint16_t*)(atlas + pages_offset);
+    auto glyphs     = (const glyph_t*)(atlas + header->glyph_offset);
+    for (size_t i = 0; i < 256; ++i)
+    {
+      if (page_index[i] != 0xFFFF && page_index[i] >= header->page_count) return false;
+    }
+    for (size_t i = 0; i < header->page_count * 256u; ++i)
+    {
+      if (pages[i] != 0xFFFF && pages[i] >= header->glyph_count) return false;
+    }
+    size_t bitmap_size = size - header->bitmap_offset;
+    for (size_t i = 0; i < header->glyph_count; ++i)
+    {
+      auto& g = glyphs[i];
+      if (g.bitmap > bitmap_size || (size_t)g.width * g.height > bitmap_size - g.bitmap) return false;
+    }
+
+    _atlas      = atlas;
+    _header     = header;
+    _page_index = page_index;
+    _pages      = pages;
+    _glyphs     = glyphs;
+    _bitmaps    = atlas + header->bitmap_offset;
+    _fontLoaded = true;
+    return true;
+  }
+
+  bool LFAfont::loadFont(DataWrapper* data)
+  {
+    header_t header;
+    data->seek(0);
+    if (data->read((uint8_t*)&header, sizeof(header)) != sizeof(header)
+     || memcmp(header.magic, "LFA1", 4)
+     || header.file_size < pages_offset) return false;
+
+    _owned = (uint8_t*)heap_alloc_psram(header.file_size);
+    if (nullptr == _owned) _owned = (uint8_t*)heap_alloc(header.file_size);
+    if (nullptr == _owned) return false;
+
+    // One sequential read; nothing touches the file after this
+    data->seek(0);
+    size_t pos = 0;
+    while (pos < header.file_size)
+    {
+      int len = data->read(&_owned[pos], header.file_size - pos);
+      if (len <= 0) break;
+      pos += len;
+    }
+    // VLW keeps the file open until unloadFont(); the atlas is done with it
+    data->close();
+    if (pos != header.file_size || !setData(_owned, header.file_size))
+    {
+      unloadFont();
+      return false;
+    }
+    return true;
+  }
+
+  bool LFAfont::unloadFont(void)
+  {
+    _fontLoaded = false;
+    _atlas = nullptr;
+    _header = nullptr;
+    _page_index = _pages = nullptr;
+    _glyphs = nullptr;
+    _bitmaps = nullptr;
+    if (_owned) { heap_free(_owned); _owned = nullptr; }
+    return true;
+  }
+
+  const LFAfont::glyph_t* LFAfont::getGlyph(uint16_t unicode) const
+  {
+    if (!_header) return nullptr;
+    uint16_t page = _page_index[unicode >> 8];
+    if (page == 0xFFFF) return nullptr;
+    uint16_t index = _pages[(page << 8) + (unicode & 0xFF)];
+    return (index == 0xFFFF) ? nullptr : &_glyphs[index];
+  }
+
+  void LFAfont::getDefaultMetric(FontMetrics *metrics) const
+  {
+    metrics->x_offset  = 0;
+    metrics->y_offset  = 0;
+    metrics->baseline  = _header ? _header->max_ascent : 0;
+    metrics->y_advance = _header ? _header->y_advance : 0;
+    metrics->height    = metrics->y_advance;
+  }
+
+  bool LFAfont::updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const
+  {
+    auto g = getGlyph(uniCode);
+    if (g) {
+      metrics->width     = g->width;
+      metrics->x_advance = g->x_advance;
+      metrics->x_offset  = g->dx;
+      return true;
+    }
+    metrics->width = metrics->x_advance = _header ? _header->space_width : 0;
+    metrics->x_offset = 0;
+    return (uniCode == 0x20);
+  }
+
+  size_t LFAfont::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t code, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
+  {
+    if (!_header) return 0;
+
+    int32_t sy = 65536 * style->size_y;
+    y += (metrics->y_offset * sy) >> 16;
+
+    // Same rules as VLWfont: space is always blank, unknown codes a box
+    const glyph_t* g = nullptr;
+    if (code != 0x20) {
+      g = getGlyph(code);
+      if (!g) return drawCharDummy(gfx, x, y, _header->space_width, metrics->height, style, filled_x);
+    }
+
+    int32_t sx = 65536 * style->size_x;
+    int32_t w  = g ? g->width  : 0;
+    int32_t h  = g ? g->height : 0;
+    int32_t xAdvance = ((g ? g->x_advance : _header->space_width) * sx) >> 16;
+    int32_t xoffset  = ((g ? g->dx : 0) * sx) >> 16;
+    int32_t yoffset  = _header->max_ascent - (g ? g->dy : 0);
+
+    return draw_alpha_glyph(gfx, x, y, g ? &_bitmaps[g->bitmap] : _bitmaps, w, h, sx, sy, xAdvance, xoffset, yoffset, style, metrics, filled_x);
+  }
+
 //----------------------------------------------------------------------------
 
   // deprecated array.
@@ -28,6 +28,7 @@ namespace lgfx
     , ft_vlw
     , ft_u8g2
     , ft_ttf
+    , ft_lfa
     };
 
     virtual font_type_t getType(void) const { return font_type_t::ft_unknown; }
@@ -258,6 +259,86 @@ namespace lgfx
     bool getUnicodeIndex(uint16_t unicode, uint16_t *index) const;
   };
 
+//----------------------------------------------------------------------------
+// LFA font atlas: VLW glyphs packed with their index into one block, so
+// lookups are O(1) and drawing never touches the file again. The block is
+// either read in one go (loadFont) or used in place (setData), e.g. from a
+// const array or a memory-mapped flash partition.
+//
+// Layout, little-endian:
+//   header_t
+//   uint16_t page_index[256];            // high byte of the code -> page, 0xFFFF = none
+//   uint16_t pages[page_count][256];     // low byte -> glyph index, 0xFFFF = none
+//   glyph_t  glyphs[glyph_count];        // at header.glyph_offset
+//   uint8_t  bitmaps[];                  // at header.bitmap_offset, 8bpp coverage
+  struct LFAfont : public RunTimeFont
+  {
+    struct header_t
+    {
+      char     magic[4];      // "LFA1"
+      uint16_t glyph_count;
+      uint16_t page_count;
+      uint16_t y_advance;
+      uint16_t space_width;
+      uint16_t max_ascent;
+      uint16_t max_descent;
+      uint32_t glyph_offset;
+      uint32_t bitmap_offset;
+      uint32_t file_size;
+      uint32_t reserved;
+    };
+
+    struct glyph_t
+    {
+      uint32_t bitmap;        // from header.bitmap_offset
+      uint8_t  width;
+      uint8_t  height;
+      uint8_t  x_advance;
+      int8_t   dx;            // left edge relative to the cursor
+      int16_t  dy;            // top edge above the baseline
+      uint16_t code;
+    };
+
+    static constexpr size_t page_index_offset = sizeof(header_t);
+    static constexpr size_t pages_offset = page_index_offset + 256 * sizeof(uint16_t);
+
+    font_type_t getType(void) const override { return ft_lfa; }
+
+    size_t drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t c, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const override;
+
+    void getDefaultMetric(FontMetrics *metrics) const override;
+
+    virtual ~LFAfont();
+
+    /// Reads the whole atlas into one PSRAM (or heap) block.
+    bool loadFont(DataWrapper* data) override;
+
+    /// Uses an atlas already in addressable memory without copying it.
+    /// The memory must stay valid until unloadFont() and be 4-byte
+    /// aligned (see isAligned()); anything else is rejected.
+    bool setData(const void* data, size_t length = ~0u);
+
+    bool unloadFont(void) override;
+
+    bool updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const override;
+
+    const glyph_t* getGlyph(uint16_t unicode) const;
+
+    static bool isAtlas(const void* data);
+
+    /// True if data may be used in place by setData().
+    static bool isAligned(const void* data);
+
+  private:
+    const uint8_t*  _atlas  = nullptr;
+    uint8_t*        _owned  = nullptr;
+    const header_t* _header = nullptr;
+    const uint16_t* _page_index = nullptr;
+    const uint16_t* _pages  = nullptr;
+    const glyph_t*  _glyphs = nullptr;
+    const uint8_t*  _bitmaps = nullptr;
+  };
+
 //----------------------------------------------------------------------------
 
   namespace fonts
@@ -486,6 +567,77 @@ namespace lgfx
     // FontMetrics metrics;
   };
 
+//----------------------------------------------------------------------------
+// LRU cache of pre-rendered glyphs (opt-in via LGFXBase::setGlyphCache).
+// Glyphs are kept in the raw pixel format of the target, so a hit is a single
+// pushImage instead of decoding the font and filling one rect per run.
+// Only opaque text (fore != back) on targets of 8bpp or more is cached.
+  class GlyphCache
+  {
+  public:
+    struct key_t
+    {
+      const IFont* font;
+      uint32_t fore_raw;
+      uint32_t back_raw;
+      int32_t size_x;   // 16.16 fixed point
+      int32_t size_y;
+      uint16_t code;
+      color_depth_t depth;
+
+      bool operator==(const key_t& rhs) const
+      {
+        return font == rhs.font && code == rhs.code && depth == rhs.depth
+            && fore_raw == rhs.fore_raw && back_raw == rhs.back_raw
+            && size_x == rhs.size_x && size_y == rhs.size_y;
+      }
+    };
+
+    GlyphCache(void) = default;
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+    ~GlyphCache(void) { release(); }
+
+    /// @param max_bytes pixel memory shared by all cached glyphs.
+    /// @param max_entries maximum number of cached glyphs.
+    bool init(size_t max_bytes, uint_fast8_t max_entries = 16);
+    void release(void);
+    void clear(void);
+
+    /// @return pixel data of the cached glyph, or nullptr on a miss.
+    const void* find(const key_t& key);
+    /// Reserve a slot for a glyph, evicting the least recently used ones.
+    /// @return buffer to render the glyph into, or nullptr if it cannot fit.
+    void* insert(const key_t& key, size_t bytes);
+
+    size_t getUsedBytes(void) const { return _used_bytes; }
+    size_t getMaxBytes(void) const { return _max_bytes; }
+    uint32_t getHitCount(void) const { return _hits; }
+    uint32_t getMissCount(void) const { return _misses; }
+    uint32_t getEvictCount(void) const { return _evicts; }
+    void resetStats(void) { _hits = _misses = _evicts = 0; }
+
+  private:
+    struct entry_t
+    {
+      key_t key;
+      void* data;
+      size_t bytes;
+      uint32_t stamp;
+    };
+
+    void evict(entry_t* entry);
+
+    entry_t* _entries = nullptr;
+    uint_fast8_t _max_entries = 0;
+    size_t _max_bytes = 0;
+    size_t _used_bytes = 0;
+    uint32_t _stamp = 0;
+    uint32_t _hits = 0;
+    uint32_t _misses = 0;
+    uint32_t _evicts = 0;
+  };
+
  }
 }
 
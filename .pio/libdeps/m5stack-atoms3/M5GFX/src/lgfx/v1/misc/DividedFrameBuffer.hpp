@@ -52,6 +52,7 @@ namespace lgfx
     inline size_t getLineSize(void) const { return _line_size; }
     inline size_t getTotalLines(void) const { return _total_lines; }
     inline size_t getBlockCount(void) const { return _block_count; }
+    inline size_t getBlockLines(void) const { return _block_lines; }
 
     /// @brief ブロック番号を指定してバッファのポインタを取得する
     /// @param index ブロック番号
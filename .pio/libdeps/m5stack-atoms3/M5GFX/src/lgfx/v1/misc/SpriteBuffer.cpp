@@ -153,6 +153,13 @@ namespace lgfx
     }
   }
 
+  void SpriteBuffer::swap(SpriteBuffer& rhs)
+  {
+    std::swap(_buffer, rhs._buffer);
+    std::swap(_length, rhs._length);
+    std::swap(_source, rhs._source);
+  }
+
   bool SpriteBuffer::use_dma(void) const { return _source == AllocationSource::Dma || heap_capable_dma(_buffer); }
 
 //----------------------------------------------------------------------------
@@ -64,6 +64,8 @@ namespace lgfx
     operator bool() const { return _buffer != nullptr; }
 
     uint8_t* get() const { return _buffer; }
+    size_t length() const { return _length; }
+    AllocationSource source() const { return _source; }
     uint8_t* img8() const { return _buffer; }
     uint16_t* img16() const { return reinterpret_cast<uint16_t*>(_buffer); }
     bgr888_t* img24() const { return reinterpret_cast<bgr888_t*>(_buffer); }
@@ -75,6 +77,9 @@ namespace lgfx
 
     void release(void);
 
+    /// exchanges the buffers without copying (used for double buffering).
+    void swap(SpriteBuffer& rhs);
+
     bool use_dma(void) const;
     bool use_memcpy(void) const { return _source != AllocationSource::Psram; }
   };
@@ -20,6 +20,7 @@ Contributors:
 #include <string.h>
 
 #include "colortype.hpp"
+#include "pixelcopy_simd.hpp"
 
 namespace lgfx
 {
@@ -149,6 +150,10 @@ namespace lgfx
       auto pal = static_cast<const TPalette*>(param->palette);
       uint32_t i = param->positions[0] * param->src_bits;
       param->positions[0] += last - index;
+      uint32_t done = pixelcopy_simd::convert_palette<TDst, TPalette>(&d[index], s, i, last - index, param->src_bits, pal);
+      index += done;
+      if (index == last) { return last; }
+      i += done * param->src_bits;
       do {
         uint32_t raw = s[i >> 3];
         i += param->src_bits;
@@ -170,9 +175,12 @@ namespace lgfx
       }
       else
       {
-        do {
+        index += pixelcopy_simd::convert<TDst, TSrc>(&d[index], &s[index], last - index);
+        while (index != last)
+        {
           d[index].set(color_convert<TDst, TSrc>(s[index].get()));
-        } while (++index != last);
+          ++index;
+        }
       }
       return last;
     }
@@ -0,0 +1,245 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "pixelcopy_simd.hpp"
+
+#if LGFX_PIXELCOPY_SIMD
+
+#include <immintrin.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  namespace pixelcopy_simd
+  {
+    // pshufb masks gathering byte N of 16 packed 24bpp pixels out of three 16-byte loads. [byte][load]
+    alignas(16) static const int8_t deinterleave_mask[3][3][16] =
+    { { {    0,    3,    6,    9,   12,   15, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 }
+      , { -128, -128, -128, -128, -128, -128,    2,    5,    8,   11,   14, -128, -128, -128, -128, -128 }
+      , { -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,    1,    4,    7,   10,   13 } }
+    , { {    1,    4,    7,   10,   13, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 }
+      , { -128, -128, -128, -128, -128,    0,    3,    6,    9,   12,   15, -128, -128, -128, -128, -128 }
+      , { -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,    2,    5,    8,   11,   14 } }
+    , { {    2,    5,    8,   11,   14, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128 }
+      , { -128, -128, -128, -128, -128,    1,    4,    7,   10,   13, -128, -128, -128, -128, -128, -128 }
+      , { -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,    0,    3,    6,    9,   12,   15 } }
+    };
+
+    // The inverse: scatter three byte planes into three 16-byte stores. [store][byte]
+    alignas(16) static const int8_t interleave_mask[3][3][16] =
+    { { {    0, -128, -128,    1, -128, -128,    2, -128, -128,    3, -128, -128,    4, -128, -128,    5 }
+      , { -128,    0, -128, -128,    1, -128, -128,    2, -128, -128,    3, -128, -128,    4, -128, -128 }
+      , { -128, -128,    0, -128, -128,    1, -128, -128,    2, -128, -128,    3, -128, -128,    4, -128 } }
+    , { { -128, -128,    6, -128, -128,    7, -128, -128,    8, -128, -128,    9, -128, -128,   10, -128 }
+      , {    5, -128, -128,    6, -128, -128,    7, -128, -128,    8, -128, -128,    9, -128, -128,   10 }
+      , { -128,    5, -128, -128,    6, -128, -128,    7, -128, -128,    8, -128, -128,    9, -128, -128 } }
+    , { { -128,   11, -128, -128,   12, -128, -128,   13, -128, -128,   14, -128, -128,   15, -128, -128 }
+      , { -128, -128,   11, -128, -128,   12, -128, -128,   13, -128, -128,   14, -128, -128,   15, -128 }
+      , {   10, -128, -128,   11, -128, -128,   12, -128, -128,   13, -128, -128,   14, -128, -128,   15 } }
+    };
+
+    static inline __m128i mask(const int8_t* m) { return _mm_load_si128(reinterpret_cast<const __m128i*>(m)); }
+
+    static inline __m128i gather_plane(__m128i a0, __m128i a1, __m128i a2, int byte)
+    {
+      return _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a0, mask(deinterleave_mask[byte][0]))
+                                     , _mm_shuffle_epi8(a1, mask(deinterleave_mask[byte][1])))
+                                     , _mm_shuffle_epi8(a2, mask(deinterleave_mask[byte][2])));
+    }
+
+    static inline __m128i scatter_planes(__m128i p0, __m128i p1, __m128i p2, int store)
+    {
+      return _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(p0, mask(interleave_mask[store][0]))
+                                     , _mm_shuffle_epi8(p1, mask(interleave_mask[store][1])))
+                                     , _mm_shuffle_epi8(p2, mask(interleave_mask[store][2])));
+    }
+
+    static inline __m128i bswap16(__m128i v)
+    {
+      return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+
+#if defined (__AVX2__)
+    static inline __m256i pack565(__m128i r, __m128i g, __m128i b, bool swap)
+    {
+      __m256i r16 = _mm256_cvtepu8_epi16(r);
+      __m256i g16 = _mm256_cvtepu8_epi16(g);
+      __m256i b16 = _mm256_cvtepu8_epi16(b);
+      __m256i v = _mm256_or_si256(_mm256_or_si256(
+                    _mm256_slli_epi16(_mm256_and_si256(r16, _mm256_set1_epi16(0xF8)), 8)
+                  , _mm256_slli_epi16(_mm256_and_si256(g16, _mm256_set1_epi16(0xFC)), 3))
+                  , _mm256_srli_epi16(b16, 3));
+      if (swap) { v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8)); }
+      return v;
+    }
+#else
+    static inline __m128i pack565(__m128i r16, __m128i g16, __m128i b16, bool swap)
+    {
+      __m128i v = _mm_or_si128(_mm_or_si128(
+                    _mm_slli_epi16(_mm_and_si128(r16, _mm_set1_epi16(0xF8)), 8)
+                  , _mm_slli_epi16(_mm_and_si128(g16, _mm_set1_epi16(0xFC)), 3))
+                  , _mm_srli_epi16(b16, 3));
+      return swap ? bswap16(v) : v;
+    }
+#endif
+
+    // 16 pixels per iteration. RFirst : source byte order r,g,b (bgr888_t). Swap : destination is swap565_t.
+    template <bool RFirst, bool Swap>
+    static uint32_t rgb888_to_565(void* dst, const void* src, uint32_t len)
+    {
+      auto d = static_cast<uint8_t*>(dst);
+      auto s = static_cast<const uint8_t*>(src);
+      uint32_t n = len & ~15u;
+      for (uint32_t i = 0; i < n; i += 16, s += 48, d += 32)
+      {
+        __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        __m128i p0 = gather_plane(a0, a1, a2, 0);
+        __m128i g  = gather_plane(a0, a1, a2, 1);
+        __m128i p2 = gather_plane(a0, a1, a2, 2);
+        __m128i r = RFirst ? p0 : p2;
+        __m128i b = RFirst ? p2 : p0;
+#if defined (__AVX2__)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), pack565(r, g, b, Swap));
+#else
+        __m128i z = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d     ), pack565(_mm_unpacklo_epi8(r, z), _mm_unpacklo_epi8(g, z), _mm_unpacklo_epi8(b, z), Swap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), pack565(_mm_unpackhi_epi8(r, z), _mm_unpackhi_epi8(g, z), _mm_unpackhi_epi8(b, z), Swap));
+#endif
+      }
+      return n;
+    }
+
+    // Expands 5/6 bit channels the same way color_convert does : (c << 3) | (c >> 2), (c << 2) | (c >> 4).
+    static inline void unpack565(__m128i v, __m128i& r, __m128i& g, __m128i& b)
+    {
+      __m128i r5 = _mm_srli_epi16(v, 11);
+      __m128i g6 = _mm_and_si128(_mm_srli_epi16(v, 5), _mm_set1_epi16(0x3F));
+      __m128i b5 = _mm_and_si128(v, _mm_set1_epi16(0x1F));
+      r = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+      g = _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4));
+      b = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+    }
+
+    // 16 pixels per iteration. RFirst : destination byte order r,g,b (bgr888_t). Swap : source is swap565_t.
+    template <bool RFirst, bool Swap>
+    static uint32_t rgb565_to_888(void* dst, const void* src, uint32_t len)
+    {
+      auto d = static_cast<uint8_t*>(dst);
+      auto s = static_cast<const uint8_t*>(src);
+      uint32_t n = len & ~15u;
+      for (uint32_t i = 0; i < n; i += 16, s += 32, d += 48)
+      {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        if (Swap) { v0 = bswap16(v0); v1 = bswap16(v1); }
+        __m128i r0, g0, b0, r1, g1, b1;
+        unpack565(v0, r0, g0, b0);
+        unpack565(v1, r1, g1, b1);
+        __m128i r = _mm_packus_epi16(r0, r1);
+        __m128i g = _mm_packus_epi16(g0, g1);
+        __m128i b = _mm_packus_epi16(b0, b1);
+        __m128i p0 = RFirst ? r : b;
+        __m128i p2 = RFirst ? b : r;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d     ), scatter_planes(p0, g, p2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), scatter_planes(p0, g, p2, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 32), scatter_planes(p0, g, p2, 2));
+      }
+      return n;
+    }
+
+    // 4bpp indices through a 16 entry table of converted colors, looked up with pshufb. 32 pixels per iteration.
+    template <typename TDst>
+    static uint32_t palette4_to_16(TDst* dst, const uint8_t* src, uint32_t bitpos, uint32_t len, const bgr888_t* palette)
+    {
+      if (len < 32) { return 0; }
+
+      alignas(16) uint16_t lut[16];
+      alignas(16) uint8_t lut_lo[16];
+      alignas(16) uint8_t lut_hi[16];
+      for (int i = 0; i < 16; ++i)
+      {
+        TDst c;
+        c.set(color_convert<TDst, bgr888_t>(palette[i].get()));
+        lut[i] = c.raw;
+        lut_lo[i] = c.raw;
+        lut_hi[i] = c.raw >> 8;
+      }
+
+      auto d = reinterpret_cast<uint16_t*>(dst);
+      auto s = &src[bitpos >> 3];
+      uint32_t done = 0;
+      if (bitpos & 4)
+      { // starts on the low nibble; take it alone so the loop runs byte aligned.
+        d[done++] = lut[*s++ & 0x0F];
+      }
+
+      __m128i tlo = _mm_load_si128(reinterpret_cast<const __m128i*>(lut_lo));
+      __m128i thi = _mm_load_si128(reinterpret_cast<const __m128i*>(lut_hi));
+      __m128i m4 = _mm_set1_epi8(0x0F);
+      uint32_t n = done + ((len - done) & ~31u);
+      for (; done < n; done += 32, s += 16)
+      {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), m4);
+        __m128i lo = _mm_and_si128(x, m4);
+        // the high nibble is the earlier pixel.
+        __m128i idx0 = _mm_unpacklo_epi8(hi, lo);
+        __m128i idx1 = _mm_unpackhi_epi8(hi, lo);
+        __m128i l0 = _mm_shuffle_epi8(tlo, idx0);
+        __m128i h0 = _mm_shuffle_epi8(thi, idx0);
+        __m128i l1 = _mm_shuffle_epi8(tlo, idx1);
+        __m128i h1 = _mm_shuffle_epi8(thi, idx1);
+        auto o = reinterpret_cast<__m128i*>(&d[done]);
+        _mm_storeu_si128(&o[0], _mm_unpacklo_epi8(l0, h0));
+        _mm_storeu_si128(&o[1], _mm_unpackhi_epi8(l0, h0));
+        _mm_storeu_si128(&o[2], _mm_unpacklo_epi8(l1, h1));
+        _mm_storeu_si128(&o[3], _mm_unpackhi_epi8(l1, h1));
+      }
+      return done;
+    }
+
+    template <> uint32_t convert<swap565_t, bgr888_t>(swap565_t* dst, const bgr888_t* src, uint32_t len) { return rgb888_to_565<true , true >(dst, src, len); }
+    template <> uint32_t convert<swap565_t, rgb888_t>(swap565_t* dst, const rgb888_t* src, uint32_t len) { return rgb888_to_565<false, true >(dst, src, len); }
+    template <> uint32_t convert<rgb565_t , bgr888_t>(rgb565_t*  dst, const bgr888_t* src, uint32_t len) { return rgb888_to_565<true , false>(dst, src, len); }
+    template <> uint32_t convert<rgb565_t , rgb888_t>(rgb565_t*  dst, const rgb888_t* src, uint32_t len) { return rgb888_to_565<false, false>(dst, src, len); }
+    template <> uint32_t convert<bgr888_t, swap565_t>(bgr888_t* dst, const swap565_t* src, uint32_t len) { return rgb565_to_888<true , true >(dst, src, len); }
+    template <> uint32_t convert<bgr888_t, rgb565_t >(bgr888_t* dst, const rgb565_t*  src, uint32_t len) { return rgb565_to_888<true , false>(dst, src, len); }
+    template <> uint32_t convert<rgb888_t, swap565_t>(rgb888_t* dst, const swap565_t* src, uint32_t len) { return rgb565_to_888<false, true >(dst, src, len); }
+    template <> uint32_t convert<rgb888_t, rgb565_t >(rgb888_t* dst, const rgb565_t*  src, uint32_t len) { return rgb565_to_888<false, false>(dst, src, len); }
+
+    template <> uint32_t convert_palette<swap565_t, bgr888_t>(swap565_t* dst, const uint8_t* src, uint32_t bitpos, uint32_t len, uint8_t bits, const bgr888_t* palette)
+    {
+      return (bits == 4) ? palette4_to_16(dst, src, bitpos, len, palette) : 0;
+    }
+
+    template <> uint32_t convert_palette<rgb565_t , bgr888_t>(rgb565_t*  dst, const uint8_t* src, uint32_t bitpos, uint32_t len, uint8_t bits, const bgr888_t* palette)
+    {
+      return (bits == 4) ? palette4_to_16(dst, src, bitpos, len, palette) : 0;
+    }
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
+
+#endif
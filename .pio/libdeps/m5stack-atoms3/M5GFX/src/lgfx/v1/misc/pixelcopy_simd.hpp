@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stdint.h>
+
+#include "colortype.hpp"
+
+#if !defined (LGFX_PIXELCOPY_SIMD)
+ #if defined (__SSSE3__)
+  #define LGFX_PIXELCOPY_SIMD 1
+ #else
+  #define LGFX_PIXELCOPY_SIMD 0
+ #endif
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// Vectorized kernels behind pixelcopy_t's non-affine fast paths.
+  /// Each kernel converts a leading part of the run and returns the number of
+  /// pixels written; the caller finishes the remainder with the scalar loop.
+  /// Results are bit-identical to color_convert.
+  /// Pairs without a kernel (or builds without SIMD) return 0.
+  /// Only x86 (SSSE3/AVX2) kernels exist. There is no ESP32-S3 PIE path, so
+  /// device builds keep the scalar loop and gain nothing from this.
+  namespace pixelcopy_simd
+  {
+    template <typename TDst, typename TSrc>
+    inline uint32_t convert(TDst*, const TSrc*, uint32_t) { return 0; }
+
+    /// src is the packed index data and bitpos the bit offset of the first pixel.
+    template <typename TDst, typename TPalette>
+    inline uint32_t convert_palette(TDst*, const uint8_t*, uint32_t, uint32_t, uint8_t, const TPalette*) { return 0; }
+
+#if LGFX_PIXELCOPY_SIMD
+    template <> uint32_t convert<swap565_t, bgr888_t>(swap565_t* dst, const bgr888_t* src, uint32_t len);
+    template <> uint32_t convert<swap565_t, rgb888_t>(swap565_t* dst, const rgb888_t* src, uint32_t len);
+    template <> uint32_t convert<rgb565_t , bgr888_t>(rgb565_t*  dst, const bgr888_t* src, uint32_t len);
+    template <> uint32_t convert<rgb565_t , rgb888_t>(rgb565_t*  dst, const rgb888_t* src, uint32_t len);
+    template <> uint32_t convert<bgr888_t, swap565_t>(bgr888_t* dst, const swap565_t* src, uint32_t len);
+    template <> uint32_t convert<bgr888_t, rgb565_t >(bgr888_t* dst, const rgb565_t*  src, uint32_t len);
+    template <> uint32_t convert<rgb888_t, swap565_t>(rgb888_t* dst, const swap565_t* src, uint32_t len);
+    template <> uint32_t convert<rgb888_t, rgb565_t >(rgb888_t* dst, const rgb565_t*  src, uint32_t len);
+
+    template <> uint32_t convert_palette<swap565_t, bgr888_t>(swap565_t* dst, const uint8_t* src, uint32_t bitpos, uint32_t len, uint8_t bits, const bgr888_t* palette);
+    template <> uint32_t convert_palette<rgb565_t , bgr888_t>(rgb565_t*  dst, const uint8_t* src, uint32_t bitpos, uint32_t len, uint8_t bits, const bgr888_t* palette);
+#endif
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,170 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "profiler.hpp"
+
+#if LGFX_PROFILER
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined (ESP_PLATFORM)
+ #include <esp_idf_version.h>
+ #include <soc/rtc.h>
+ #if ESP_IDF_VERSION_MAJOR >= 5
+  #include <esp_cpu.h>
+ #else
+  #include <hal/cpu_hal.h>
+ #endif
+#else
+ #include <chrono>
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  profile_entry_t Profiler::entries[prof_max];
+  profile_id_t Profiler::current = prof_max;
+
+  static constexpr const char* profile_names[prof_max] =
+  { "frame"
+  , "fillRect"
+  , "drawString"
+  , "print"
+  , "pushImage"
+  , "pushSprite"
+  , "drawPolyline"
+  , "bus"
+  };
+
+  uint32_t Profiler::cycles(void)
+  {
+#if defined (ESP_PLATFORM)
+ #if ESP_IDF_VERSION_MAJOR >= 5
+    return esp_cpu_get_cycle_count();
+ #else
+    return cpu_hal_get_cycle_count();
+ #endif
+#else
+    // No portable cycle counter on the host; count nanoseconds instead
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  uint32_t Profiler::cyclesPerUs(void)
+  {
+#if defined (ESP_PLATFORM)
+    rtc_cpu_freq_config_t conf;
+    rtc_clk_cpu_freq_get_config(&conf);
+    return conf.freq_mhz;
+#else
+    return 1000;
+#endif
+  }
+
+  const char* Profiler::getName(profile_id_t id)
+  {
+    return (id < prof_max) ? profile_names[id] : "";
+  }
+
+  void Profiler::reset(void)
+  {
+    // open scopes keep their depth so they still close cleanly
+    for (auto& e : entries)
+    {
+      e.calls = 0;
+      e.cycles = 0;
+      e.bytes = 0;
+    }
+  }
+
+  // snprintf into buf at pos, keeping the full length like snprintf does
+  template <typename ... Args>
+  static void append(char* buf, size_t len, size_t& pos, const char* fmt, Args ... args)
+  {
+    int n = snprintf(pos < len ? &buf[pos] : nullptr, pos < len ? len - pos : 0, fmt, args ...);
+    if (n > 0) { pos += n; }
+  }
+
+  size_t Profiler::printTo(char* buf, size_t len)
+  {
+    size_t pos = 0;
+    uint32_t mhz = cyclesPerUs();
+    append(buf, len, pos, "%-12s %8s %10s %8s %10s\n", "primitive", "calls", "total_us", "avg_us", "bytes");
+    for (size_t i = 0; i < prof_max; ++i)
+    {
+      auto& e = entries[i];
+      if (e.calls == 0 && e.bytes == 0) continue;
+      uint64_t us = e.cycles / mhz;
+      append(buf, len, pos, "%-12s %8lu %10llu %8lu %10llu\n"
+            , profile_names[i]
+            , (unsigned long)e.calls
+            , (unsigned long long)us
+            , (unsigned long)(e.calls ? us / e.calls : 0)
+            , (unsigned long long)e.bytes);
+    }
+    return pos;
+  }
+
+  size_t Profiler::printJson(char* buf, size_t len)
+  {
+    if (len < 3) { if (len) { buf[0] = 0; } return 0; }
+
+    // Members are formatted aside and copied only if they fit together
+    // with the closing brace, so a short buffer still gets valid JSON.
+    char item[160];
+    size_t pos = 0;
+    auto put = [&](int n) -> bool
+    {
+      if (n <= 0 || (size_t)n >= sizeof(item) || pos + n + 2 > len) return false;
+      memcpy(&buf[pos], item, n);
+      pos += n;
+      return true;
+    };
+
+    uint32_t mhz = cyclesPerUs();
+    if (put(snprintf(item, sizeof(item), "{\"cpuMHz\":%lu", (unsigned long)mhz)))
+    {
+      for (size_t i = 0; i < prof_max; ++i)
+      {
+        auto& e = entries[i];
+        if (!put(snprintf(item, sizeof(item), ",\"%s\":{\"calls\":%lu,\"cycles\":%llu,\"us\":%llu,\"bytes\":%llu}"
+                         , profile_names[i]
+                         , (unsigned long)e.calls
+                         , (unsigned long long)e.cycles
+                         , (unsigned long long)(e.cycles / mhz)
+                         , (unsigned long long)e.bytes))) break;
+      }
+    }
+    else
+    {
+      buf[pos++] = '{';
+    }
+    buf[pos++] = '}';
+    buf[pos] = 0;
+    return pos;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/// Build with -DLGFX_PROFILER=1 to count calls, CPU cycles and bus bytes
+/// per drawing primitive. With the default of 0 the probes expand to
+/// nothing and no profiler code or data is compiled in.
+#if !defined (LGFX_PROFILER)
+ #define LGFX_PROFILER 0
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  enum profile_id_t : uint8_t
+  { prof_frame        // app-defined, see LGFX_PROFILE_SCOPE
+  , prof_fill_rect
+  , prof_draw_string
+  , prof_print
+  , prof_push_image
+  , prof_push_sprite
+  , prof_draw_polyline
+  , prof_bus          // panel data written to the bus
+  , prof_max
+  };
+
+#if LGFX_PROFILER
+
+  struct profile_entry_t
+  {
+    uint32_t calls;
+    uint32_t depth;   // open scopes; only the outermost one is timed
+    uint64_t cycles;
+    uint64_t bytes;
+  };
+
+  /// Counters are global and not locked: profile drawing from one task.
+  /// Time is inclusive, e.g. drawString includes the fillRect calls it
+  /// makes. Bus bytes are also credited to the outermost open primitive.
+  struct Profiler
+  {
+    static profile_entry_t entries[prof_max];
+    static profile_id_t current;
+
+    static uint32_t cycles(void);
+    static uint32_t cyclesPerUs(void);
+    static const char* getName(profile_id_t id);
+    static void reset(void);
+
+    /// Formats a text table (one line per primitive that was called).
+    /// @return length as snprintf would; output is truncated to len - 1.
+    static size_t printTo(char* buf, size_t len);
+    /// Same data as a JSON object keyed by primitive name.
+    /// Primitives that do not fit are left out, so the output is always a
+    /// complete object ("{}" at worst, len >= 3).
+    /// @return length written.
+    static size_t printJson(char* buf, size_t len);
+
+    static inline void addBusBytes(uint32_t bytes)
+    {
+      entries[prof_bus].bytes += bytes;
+      if (current != prof_max) { entries[current].bytes += bytes; }
+    }
+  };
+
+  class profile_scope_t
+  {
+  public:
+    profile_scope_t(profile_id_t id)
+    : _entry { &Profiler::entries[id] }
+    , _prev { Profiler::current }
+    {
+      if (_entry->depth++ == 0) { _start = Profiler::cycles(); }
+      if (_prev == prof_max && id != prof_bus) { Profiler::current = id; }
+    }
+
+    ~profile_scope_t(void)
+    {
+      if (--_entry->depth == 0)
+      {
+        _entry->cycles += Profiler::cycles() - _start;
+        ++_entry->calls;
+      }
+      Profiler::current = _prev;
+    }
+
+    profile_scope_t(const profile_scope_t&) = delete;
+    profile_scope_t& operator=(const profile_scope_t&) = delete;
+
+  private:
+    profile_entry_t* _entry;
+    profile_id_t _prev;
+    uint32_t _start = 0;
+  };
+
+ #define LGFX_PROFILE_SCOPE(id) lgfx::profile_scope_t lgfx_profile_scope_ { id }
+ #define LGFX_PROFILE_BUS(bytes) lgfx::Profiler::addBusBytes(bytes)
+
+#else
+
+ #define LGFX_PROFILE_SCOPE(id)
+ #define LGFX_PROFILE_BUS(bytes)
+
+#endif
+
+//----------------------------------------------------------------------------
+ }
+}
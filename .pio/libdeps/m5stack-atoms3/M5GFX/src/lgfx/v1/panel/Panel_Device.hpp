@@ -18,6 +18,7 @@ Contributors:
 #pragma once
 
 #include "../Panel.hpp"
+#include "../misc/profiler.hpp"
 
 namespace lgfx
 {
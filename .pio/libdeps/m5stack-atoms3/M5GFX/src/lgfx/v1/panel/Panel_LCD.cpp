@@ -78,6 +78,7 @@ namespace lgfx
     {
       _has_align_data = false;
       _bus->writeData(0, 8);
+      LGFX_PROFILE_BUS(1);
     }
 
     if (_nop_closing)
@@ -174,6 +175,7 @@ namespace lgfx
     if (!_cfg.dlen_16bit)
     {
       _bus->writeCommand(data, 8);
+      LGFX_PROFILE_BUS(1);
     }
     else
     {
@@ -181,8 +183,10 @@ namespace lgfx
       {
         _bus->writeData(0, 8);
         _has_align_data = false;
+        LGFX_PROFILE_BUS(1);
       }
       _bus->writeCommand(data << 8 | data >> 8, 16);
+      LGFX_PROFILE_BUS(2);
     }
   }
 
@@ -241,15 +245,18 @@ namespace lgfx
     bool tr = _in_transaction;
     if (!tr) begin_transaction();
 
+    LGFX_PROFILE_SCOPE(prof_bus);
     setWindow(x,y,x,y);
     if (_cfg.dlen_16bit) { _has_align_data = (_write_bits & 15); }
     _bus->writeData(rawcolor, _write_bits);
+    LGFX_PROFILE_BUS(_write_bits >> 3);
 
     if (!tr) end_transaction();
   }
 
   void Panel_LCD::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
   {
+    LGFX_PROFILE_SCOPE(prof_bus);
     uint32_t len = w * h;
     uint_fast16_t xe = w + x - 1;
     uint_fast16_t ye = y + h - 1;
@@ -257,11 +264,14 @@ namespace lgfx
     setWindow(x,y,xe,ye);
     if (_cfg.dlen_16bit) { _has_align_data = (_write_bits & 15) && (len & 1); }
     _bus->writeDataRepeat(rawcolor, _write_bits, len);
+    LGFX_PROFILE_BUS(len * _write_bits >> 3);
   }
 
   void Panel_LCD::writeBlock(uint32_t rawcolor, uint32_t len)
   {
+    LGFX_PROFILE_SCOPE(prof_bus);
     _bus->writeDataRepeat(rawcolor, _write_bits, len);
+    LGFX_PROFILE_BUS(len * _write_bits >> 3);
     if (_cfg.dlen_16bit && (_write_bits & 15) && (len & 1))
     {
       _has_align_data = !_has_align_data;
@@ -270,6 +280,8 @@ namespace lgfx
 
   void Panel_LCD::writePixels(pixelcopy_t* param, uint32_t len, bool use_dma)
   {
+    LGFX_PROFILE_SCOPE(prof_bus);
+    LGFX_PROFILE_BUS(len * _write_bits >> 3);
     if (param->no_convert)
     {
       _bus->writeBytes(reinterpret_cast<const uint8_t*>(param->src_data), len * _write_bits >> 3, true, use_dma);
@@ -286,6 +298,7 @@ namespace lgfx
 
   void Panel_LCD::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma)
   {
+    LGFX_PROFILE_SCOPE(prof_bus);
     auto bytes = param->dst_bits >> 3;
     auto src_x = param->src_x;
 
@@ -310,6 +323,7 @@ namespace lgfx
             {
               _has_align_data = !_has_align_data;
             }
+            LGFX_PROFILE_BUS(wb * h);
             do
             {
               _bus->addDMAQueue(src, wb);
@@ -399,6 +413,8 @@ namespace lgfx
 
   void Panel_LCD::write_bytes(const uint8_t* data, uint32_t len, bool use_dma)
   {
+    LGFX_PROFILE_SCOPE(prof_bus);
+    LGFX_PROFILE_BUS(len);
     _bus->writeBytes(data, len, true, use_dma);
     if (_cfg.dlen_16bit && (_write_bits & 15) && (len & 1))
     {
@@ -458,6 +474,7 @@ namespace lgfx
       _bus->writeCommand(CMD_CASET, 8);
       x += _colstart + (_colstart << 16);
       _bus->writeData(((x >> 8) & mask) + ((x & mask) << 8), 32);
+      LGFX_PROFILE_BUS(5);
     }
     uint32_t y = ys + (ye << 16);
     if (_ysye != y)
@@ -466,8 +483,10 @@ namespace lgfx
       _bus->writeCommand(CMD_RASET, 8);
       y += _rowstart + (_rowstart << 16);
       _bus->writeData(((y >> 8) & mask) + ((y & mask) << 8), 32);
+      LGFX_PROFILE_BUS(5);
     }
     _bus->writeCommand(cmd, 8);
+    LGFX_PROFILE_BUS(1);
   }
 
   void Panel_LCD::set_window_16(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd)
@@ -476,6 +495,7 @@ namespace lgfx
     {
       _bus->writeData(0, 8);
       _has_align_data = false;
+      LGFX_PROFILE_BUS(1);
     }
     if (xs != _xs || xe != _xe)
     {
@@ -486,6 +506,7 @@ namespace lgfx
       _xe = xe;
       xe += _colstart;
       _bus->writeData((xe >> 8) << 8 | xe << 24, 32);
+      LGFX_PROFILE_BUS(10);
     }
     if (ys != _ys || ye != _ye)
     {
@@ -496,8 +517,10 @@ namespace lgfx
       _ye = ye;
       ye += _rowstart;
       _bus->writeData((ye >> 8) << 8 | ye << 24, 32);
+      LGFX_PROFILE_BUS(10);
     }
     _bus->writeCommand(cmd << 8, 16);
+    LGFX_PROFILE_BUS(2);
   }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,26 @@
+/*
+  Host stub: the digital I/O used by M5HAL's Arduino GPIO, pins are not driven
+*/
+#ifndef M5_UNIT_HOST_STUB_ARDUINO_H
+#define M5_UNIT_HOST_STUB_ARDUINO_H
+
+#include <cstdint>
+
+#define LOW               (0x0)
+#define HIGH              (0x1)
+#define INPUT             (0x01)
+#define OUTPUT            (0x03)
+#define OUTPUT_OPEN_DRAIN (0x13)
+
+inline void pinMode(uint8_t, uint8_t)
+{
+}
+inline void digitalWrite(uint8_t, uint8_t)
+{
+}
+inline int digitalRead(uint8_t)
+{
+    return LOW;
+}
+
+#endif
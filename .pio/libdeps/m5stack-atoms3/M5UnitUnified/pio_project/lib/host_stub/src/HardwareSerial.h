@@ -0,0 +1,9 @@
+/*
+  Host stub: HardwareSerial referenced by AdapterUART
+*/
+#ifndef M5_UNIT_HOST_STUB_HARDWARE_SERIAL_H
+#define M5_UNIT_HOST_STUB_HARDWARE_SERIAL_H
+
+class HardwareSerial {};
+
+#endif
@@ -0,0 +1,20 @@
+/*
+  Host stub: SPI types referenced by AdapterSPI
+*/
+#ifndef M5_UNIT_HOST_STUB_SPI_H
+#define M5_UNIT_HOST_STUB_SPI_H
+
+#include <cstdint>
+
+class SPIClass {};
+
+struct SPISettings {
+    SPISettings()
+    {
+    }
+    SPISettings(uint32_t, uint8_t, uint8_t)
+    {
+    }
+};
+
+#endif
@@ -0,0 +1,57 @@
+/*
+  Host stub: TwoWire that never talks to a device
+  Tests use the mock bus (test/i2c_mock.hpp), this only lets the Arduino paths compile
+*/
+#ifndef M5_UNIT_HOST_STUB_WIRE_H
+#define M5_UNIT_HOST_STUB_WIRE_H
+
+#include <cstdint>
+#include <cstddef>
+
+class TwoWire {
+public:
+    bool begin()
+    {
+        return true;
+    }
+    bool end()
+    {
+        return true;
+    }
+    void setClock(uint32_t)
+    {
+    }
+    void beginTransmission(uint8_t)
+    {
+    }
+    size_t write(uint8_t)
+    {
+        return 1;
+    }
+    size_t write(const uint8_t*, size_t n)
+    {
+        return n;
+    }
+    uint8_t endTransmission(bool = true)
+    {
+        return 0;
+    }
+    size_t requestFrom(uint8_t, size_t n)
+    {
+        return n;
+    }
+    int available()
+    {
+        return 0;
+    }
+    int read()
+    {
+        return 0;
+    }
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+#define WIRE_HAS_END
+
+#endif
@@ -0,0 +1,10 @@
+/*
+  Host stub: ESP-IDF GPIO types
+*/
+#ifndef M5_UNIT_HOST_STUB_DRIVER_GPIO_H
+#define M5_UNIT_HOST_STUB_DRIVER_GPIO_H
+
+typedef int gpio_num_t;
+#define GPIO_NUM_MAX (49)
+
+#endif
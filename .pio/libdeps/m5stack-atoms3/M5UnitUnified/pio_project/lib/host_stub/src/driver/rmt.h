@@ -0,0 +1,9 @@
+/*
+  Host stub: ESP-IDF legacy RMT types
+*/
+#ifndef M5_UNIT_HOST_STUB_DRIVER_RMT_H
+#define M5_UNIT_HOST_STUB_DRIVER_RMT_H
+
+#include "../soc/rmt_struct.h"
+
+#endif
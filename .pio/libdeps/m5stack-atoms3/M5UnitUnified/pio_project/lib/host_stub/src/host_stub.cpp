@@ -0,0 +1,40 @@
+/*
+  Host stub: definitions for the stub headers, and for the adapters whose ESP-IDF
+  sources are left out of the host build (pin, GPIO/RMT, UART, SPI; see custom_exclude_src_files)
+*/
+#include <M5UnitComponent.hpp>
+#include <Wire.h>
+#include <soc/gpio_struct.h>
+
+TwoWire Wire, Wire1;
+gpio_dev_t GPIO{};
+
+namespace m5 {
+namespace unit {
+namespace gpio {
+pin_backup_t::pin_backup_t(int pin_num) : _pin_num{static_cast<int8_t>(pin_num)}
+{
+}
+void pin_backup_t::backup(void)
+{
+}
+void pin_backup_t::restore(void)
+{
+}
+}  // namespace gpio
+
+AdapterGPIOBase::AdapterGPIOBase(GPIOImpl*) : Adapter()
+{
+}
+AdapterGPIO::AdapterGPIO(const int8_t, const int8_t) : AdapterGPIOBase(nullptr)
+{
+}
+AdapterUART::AdapterUART(HardwareSerial&) : Adapter()
+{
+}
+AdapterSPI::AdapterSPI(SPIClass&, const SPISettings&, const uint8_t) : Adapter()
+{
+}
+
+}  // namespace unit
+}  // namespace m5
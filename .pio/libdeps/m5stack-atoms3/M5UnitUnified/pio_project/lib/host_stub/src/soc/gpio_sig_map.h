@@ -0,0 +1,12 @@
+/*
+  Host stub: I2C signal indexes of the GPIO matrix
+*/
+#ifndef M5_UNIT_HOST_STUB_SOC_GPIO_SIG_MAP_H
+#define M5_UNIT_HOST_STUB_SOC_GPIO_SIG_MAP_H
+
+#define I2CEXT0_SDA_IN_IDX (0)
+#define I2CEXT0_SCL_IN_IDX (1)
+#define I2CEXT1_SDA_IN_IDX (2)
+#define I2CEXT1_SCL_IN_IDX (3)
+
+#endif
@@ -0,0 +1,18 @@
+/*
+  Host stub: GPIO matrix input selection, all routed to pin 0
+*/
+#ifndef M5_UNIT_HOST_STUB_SOC_GPIO_STRUCT_H
+#define M5_UNIT_HOST_STUB_SOC_GPIO_STRUCT_H
+
+#include <cstdint>
+
+struct gpio_func_in_sel_t {
+    uint32_t func_sel;
+    uint32_t in_sel;
+};
+struct gpio_dev_t {
+    gpio_func_in_sel_t func_in_sel_cfg[256];
+};
+extern gpio_dev_t GPIO;
+
+#endif
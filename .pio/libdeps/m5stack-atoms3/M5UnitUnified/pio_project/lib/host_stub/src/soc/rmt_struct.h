@@ -0,0 +1,17 @@
+/*
+  Host stub: RMT item as laid out on ESP32
+*/
+#ifndef M5_UNIT_HOST_STUB_SOC_RMT_STRUCT_H
+#define M5_UNIT_HOST_STUB_SOC_RMT_STRUCT_H
+
+#include <cstdint>
+
+typedef int rmt_channel_t;
+typedef struct {
+    uint32_t duration0 : 15;
+    uint32_t level0 : 1;
+    uint32_t duration1 : 15;
+    uint32_t level1 : 1;
+} rmt_item32_t;
+
+#endif
@@ -40,8 +40,9 @@
 /*
   For native test, this main() is used.
   If the Arduino framework is used, the framework library main is used.
+  (M5_UNIT_TEST_HOST: ARDUINO is defined over host stubs, see env:test_native_mock)
 */
-#if !defined(ARDUINO)
+#if !defined(ARDUINO) || defined(M5_UNIT_TEST_HOST)
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for asynchronous I2C transaction
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5UnitUnified.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace m5::unit;
+
+namespace {
+constexpr uint32_t MEASURE_MS{20};
+
+template <class F>
+void run_until(UnitUnified& units, F&& done, const uint32_t timeout = 1000)
+{
+    auto start_at = m5::utility::millis();
+    while (!done() && m5::utility::millis() - start_at < timeout) {
+        units.update();
+        m5::utility::delay(1);
+    }
+}
+
+}  // namespace
+
+TEST(AsyncI2C, Submit)
+{
+    for (uint32_t latency : {0U, 3U}) {
+        SCOPED_TRACE(latency);
+
+        auto mock = new MockI2C(0, latency);
+        AdapterI2C ad(mock);
+        ad.setAddress(0x44);
+
+        std::vector<int> order{};
+        const uint8_t wdata[] = {0x10, 0xAB, 0xCD};
+        EXPECT_FALSE(ad.submit(nullptr, 0, 0, 0, nullptr));  // Nothing to do
+        EXPECT_TRUE(ad.submitWrite(wdata, sizeof(wdata), [&order](const m5::hal::error::error_t err, const uint8_t* data, size_t len) {
+            EXPECT_EQ(err, m5::hal::error::error_t::OK);
+            EXPECT_EQ(data, nullptr);
+            EXPECT_EQ(len, 0U);
+            order.push_back(0);
+        }));
+        const uint8_t reg = 0x10;
+        EXPECT_TRUE(ad.submit(&reg, 1, 2, 0, [&order](const m5::hal::error::error_t err, const uint8_t* data, size_t len) {
+            EXPECT_EQ(err, m5::hal::error::error_t::OK);
+            ASSERT_NE(data, nullptr);
+            ASSERT_EQ(len, 2U);
+            EXPECT_EQ(data[0], 0xAB);
+            EXPECT_EQ(data[1], 0xCD);
+            order.push_back(1);
+        }));
+        EXPECT_EQ(ad.pending(), 2U);
+        EXPECT_EQ(mock->writes, 0U);  // Nothing done before poll
+
+        uint32_t polls{};
+        while (ad.poll() && polls < 100) {
+            ++polls;
+        }
+        EXPECT_EQ(ad.pending(), 0U);
+        EXPECT_EQ(order, (std::vector<int>{0, 1}));
+        EXPECT_EQ(mock->writes, 2U);
+        EXPECT_EQ(mock->reads, 1U);
+        // Each transfer is busy for latency polls
+        EXPECT_EQ(polls, latency * 3);
+    }
+}
+
+TEST(AsyncI2C, WaitAndError)
+{
+    auto mock = new MockI2C(MEASURE_MS);
+    AdapterI2C ad(mock);
+    ad.setAddress(0x44);
+
+    // Waiting shorter than measurement time makes NACK
+    const uint8_t cmd = MockI2C::CMD_MEASURE;
+    m5::hal::error::error_t result{m5::hal::error::error_t::UNKNOWN_ERROR};
+    bool called{};
+    EXPECT_TRUE(ad.submit(&cmd, 1, 2, 0, [&](const m5::hal::error::error_t err, const uint8_t* data, size_t len) {
+        result = err;
+        called = true;
+        EXPECT_EQ(data, nullptr);
+        EXPECT_EQ(len, 0U);
+    }));
+    EXPECT_EQ(ad.poll(), 0U);
+    EXPECT_TRUE(called);
+    EXPECT_EQ(result, m5::hal::error::error_t::I2C_NO_ACK);
+
+    // Wait does not block poll
+    called = false;
+    EXPECT_TRUE(ad.submit(&cmd, 1, 2, MEASURE_MS, [&](const m5::hal::error::error_t err, const uint8_t* data, size_t len) {
+        result = err;
+        called = true;
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(len, 2U);
+        EXPECT_EQ((data[0] << 8) | data[1], 2);
+    }));
+    auto start_at = m5::utility::millis();
+    const auto reads = mock->reads;
+    EXPECT_EQ(ad.poll(), 1U);
+    // The command is sent and the read left for a later poll
+    EXPECT_EQ(mock->measurements, 2U);
+    EXPECT_EQ(mock->reads, reads);
+    EXPECT_FALSE(called);
+    while (ad.poll()) {
+        m5::utility::delay(1);
+    }
+    EXPECT_TRUE(called);
+    EXPECT_EQ(result, m5::hal::error::error_t::OK);
+    EXPECT_GE(m5::utility::millis() - start_at, MEASURE_MS);
+}
+
+TEST(AsyncI2C, Limit)
+{
+    AdapterI2C ad(new MockI2C());
+    ad.setAddress(0x44);
+
+    const uint8_t v{};
+    for (size_t i = 0; i < AdapterI2C::MAX_PENDING_TRANSACTIONS; ++i) {
+        EXPECT_TRUE(ad.submitWrite(&v, 1, nullptr));
+    }
+    EXPECT_FALSE(ad.submitWrite(&v, 1, nullptr));
+    EXPECT_EQ(ad.poll(), 0U);
+    EXPECT_TRUE(ad.submitWrite(&v, 1, nullptr));
+}
+
+// Measurement waits of the units overlap in UnitUnified::update
+TEST(AsyncI2C, Overlap)
+{
+    constexpr size_t NUM{4};
+
+    UnitUnified units;
+    std::vector<std::unique_ptr<UnitMeasureDummy>> us{};
+    std::vector<MockI2C*> mocks{};
+    for (size_t i = 0; i < NUM; ++i) {
+        us.emplace_back(new UnitMeasureDummy(0x44 + i, MEASURE_MS));
+        mocks.push_back(new MockI2C(MEASURE_MS));
+        EXPECT_TRUE(units.add(*us.back(), mocks.back()));
+        EXPECT_EQ(us.back()->address(), 0x44 + i);
+        EXPECT_EQ(mocks.back()->address(), 0x44 + i);
+    }
+    EXPECT_TRUE(units.begin());
+
+    auto all = [&us]() {
+        return std::all_of(us.begin(), us.end(), [](const std::unique_ptr<UnitMeasureDummy>& u) { return u->count; });
+    };
+    auto start_at = m5::utility::millis();
+    units.update();
+    // One update starts every measurement; none is read before its wait
+    for (size_t i = 0; i < NUM; ++i) {
+        EXPECT_EQ(mocks[i]->measurements, 1U);
+        EXPECT_EQ(mocks[i]->reads, 0U);
+    }
+    run_until(units, all);
+    auto elapsed = m5::utility::millis() - start_at;
+
+    EXPECT_TRUE(all());
+    for (size_t i = 0; i < NUM; ++i) {
+        EXPECT_EQ(us[i]->error, m5::hal::error::error_t::OK);
+        EXPECT_EQ(us[i]->value, 1U);
+        EXPECT_EQ(mocks[i]->nacks, 0U);
+        EXPECT_EQ(mocks[i]->reads, 1U);
+    }
+    // Serialized waiting would take NUM * MEASURE_MS; reported, not asserted
+    std::printf("[ BENCH    ] %zu units overlapped %u ms (measure %u ms)\n", NUM, (unsigned)elapsed,
+                (unsigned)MEASURE_MS);
+
+    // Synchronous readRegister for comparison
+    start_at = m5::utility::millis();
+    for (auto&& u : us) {
+        uint8_t buf[2]{};
+        EXPECT_TRUE(u->readRegister((uint8_t)MockI2C::CMD_MEASURE, buf, 2, MEASURE_MS));
+    }
+    EXPECT_GE(m5::utility::millis() - start_at, MEASURE_MS * NUM);
+}
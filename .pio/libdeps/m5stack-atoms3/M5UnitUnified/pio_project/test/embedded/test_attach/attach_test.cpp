@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for late attachment of UnitUnified
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5UnitUnified.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <thread>
+
+using namespace m5::unit;
+
+namespace {
+
+// begin() needs the device
+class UnitProbeDummy : public UnitPeriodicDummy {
+public:
+    using UnitPeriodicDummy::UnitPeriodicDummy;
+    virtual bool begin() override
+    {
+        ++begins;
+        uint8_t v{};
+        return readRegister8((uint8_t)0x00, v, 0) && UnitPeriodicDummy::begin();
+    }
+    uint32_t begins{};
+};
+
+constexpr uint32_t ABSENT{UINT32_MAX};
+
+void absent(MockI2C* m, const bool b)
+{
+    m->fail       = b ? ABSENT : 0;
+    m->fail_error = m5::hal::error::error_t::I2C_NO_ACK;
+}
+
+}  // namespace
+
+TEST(Attach, Late)
+{
+    MockBus bus{};
+    UnitProbeDummy present{0x10, 10}, late{0x11, 10};
+    auto mp = new MockI2C(0, 0, &bus);
+    auto ml = new MockI2C(0, 0, &bus);
+    absent(ml, true);
+
+    UnitUnified manager;
+    UnitUnified::attach_policy_t policy{};
+    policy.enabled       = true;
+    policy.scan_interval = 0;  // Every update
+    manager.setAttachPolicy(policy);
+    EXPECT_TRUE(manager.add(present, mp));
+    EXPECT_TRUE(manager.add(late, ml));
+
+    // The present one begins regardless
+    EXPECT_FALSE(manager.begin());
+    EXPECT_TRUE(manager.isAttached(present));
+    EXPECT_FALSE(manager.isAttached(late));
+    EXPECT_EQ(manager.detachedSize(), 1U);
+
+    // Scanning is a single probe per update, the present one keeps measuring
+    for (uint32_t i = 0; i < 5; ++i) {
+        const auto reads = mp->reads, writes = ml->writes;
+        manager.update(true);
+        EXPECT_EQ(mp->reads, reads + 1);
+        EXPECT_EQ(ml->writes, writes + 1);
+        EXPECT_EQ(ml->reads, 0U);
+    }
+    EXPECT_EQ(present.count, 5U);
+    EXPECT_EQ(late.begins, 1U);  // Not begun until it acknowledges
+    EXPECT_EQ(late.health().transactions, 1U);  // Probing is not the unit's transaction
+
+    // Appears
+    absent(ml, false);
+    manager.update(true);
+    EXPECT_TRUE(manager.isAttached(late));
+    EXPECT_EQ(late.begins, 2U);
+    EXPECT_EQ(manager.detachedSize(), 0U);
+    manager.update(true);
+    EXPECT_EQ(late.count, 1U);
+    EXPECT_EQ(present.count, 7U);
+}
+
+TEST(Attach, Lost)
+{
+    UnitProbeDummy u{0x10, 10};
+    auto m = new MockI2C();
+    UnitUnified manager;
+    UnitUnified::attach_policy_t policy{};
+    policy.enabled        = true;
+    policy.scan_interval  = 0;
+    policy.lost_threshold = 3;
+    policy.lost_millis    = 20;
+    manager.setAttachPolicy(policy);
+    EXPECT_TRUE(manager.add(u, m));
+    EXPECT_TRUE(manager.begin());
+
+    // Failures must last for lost_millis
+    absent(m, true);
+    for (int i = 0; i < 5; ++i) {
+        manager.update(true);
+    }
+    EXPECT_TRUE(manager.isAttached(u));
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    manager.update(true);
+    EXPECT_FALSE(manager.isAttached(u));
+    EXPECT_FALSE(u.updated());
+
+    // Not updated while detached, only probed
+    const auto reads = m->reads;
+    manager.update(true);
+    EXPECT_EQ(m->reads, reads);
+
+    absent(m, false);
+    manager.update(true);
+    EXPECT_TRUE(manager.isAttached(u));
+    const auto count = u.count;
+    manager.update(true);
+    EXPECT_EQ(u.count, count + 1);
+}
+
+TEST(Attach, Interval)
+{
+    UnitProbeDummy u{0x10, 10};
+    auto m = new MockI2C();
+    absent(m, true);
+    UnitUnified manager;
+    UnitUnified::attach_policy_t policy{};
+    policy.enabled       = true;
+    policy.scan_interval = 50;
+    manager.setAttachPolicy(policy);
+    EXPECT_TRUE(manager.add(u, m));
+    EXPECT_FALSE(manager.begin());
+
+    // Wake up for the next probe
+    auto idle = manager.idleMillis();
+    EXPECT_GT(idle, 0U);
+    EXPECT_LE(idle, 50U);
+
+    const auto writes = m->writes;
+    manager.update();
+    EXPECT_EQ(m->writes, writes);  // Not yet
+    std::this_thread::sleep_for(std::chrono::milliseconds(idle + 1));
+    manager.update();
+    EXPECT_EQ(m->writes, writes + 1);
+
+    // Disabled
+    UnitProbeDummy u2{0x10, 10};
+    UnitUnified manager2;
+    auto m2 = new MockI2C();
+    absent(m2, true);
+    EXPECT_TRUE(manager2.add(u2, m2));
+    EXPECT_FALSE(manager2.begin());
+    manager2.update(true);
+    EXPECT_EQ(u2.begins, 1U);
+    EXPECT_FALSE(manager2.isAttached(u2));
+}
@@ -0,0 +1,230 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for I2C health metrics and adaptive clock
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5UnitUnified.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <memory>
+#include <vector>
+
+using namespace m5::unit;
+
+TEST(Health, Record)
+{
+    i2c_health_t h{};
+    h.record(m5::hal::error::error_t::OK, 10);
+    h.record(m5::hal::error::error_t::OK, 150);
+    h.record(m5::hal::error::error_t::I2C_NO_ACK, 50);  // Bound is exclusive
+    h.record(m5::hal::error::error_t::TIMEOUT_ERROR, 100000);
+    h.record(m5::hal::error::error_t::I2C_BUS_ERROR, 600);
+
+    EXPECT_EQ(h.transactions, 5U);
+    EXPECT_EQ(h.nacks, 1U);
+    EXPECT_EQ(h.timeouts, 1U);
+    EXPECT_EQ(h.bus_errors, 1U);
+    EXPECT_EQ(h.errors(), 3U);
+    EXPECT_EQ(h.max_latency, 100000U);
+    EXPECT_EQ(h.averageLatency(), (10U + 150 + 50 + 100000 + 600) / 5);
+    EXPECT_EQ(h.latency[0], 1U);
+    EXPECT_EQ(h.latency[1], 1U);
+    EXPECT_EQ(h.latency[2], 1U);
+    EXPECT_EQ(h.latency[4], 1U);
+    EXPECT_EQ(h.latency[i2c_health_t::LATENCY_BINS - 1], 1U);
+    EXPECT_EQ(i2c_health_t::latencyBound(i2c_health_t::LATENCY_BINS - 1), UINT32_MAX);
+
+    i2c_health_t m{};
+    m.crc_errors = 2;
+    m.merge(h);
+    m.merge(h);
+    EXPECT_EQ(m.transactions, 10U);
+    EXPECT_EQ(m.errors(), 8U);
+    EXPECT_EQ(m.max_latency, 100000U);
+    EXPECT_EQ(m.latency[0], 2U);
+
+    auto js = h.toJSON();
+    EXPECT_NE(js.find("\"nacks\":1"), std::string::npos);
+    EXPECT_NE(js.find("\"latency\":[1,1,1,0,1,0,0,1]"), std::string::npos);
+    EXPECT_EQ(js.find("crc_errors"), std::string::npos);  // Driver-reported only
+
+    h.clear();
+    EXPECT_EQ(h.transactions, 0U);
+    EXPECT_EQ(h.latency[0], 0U);
+}
+
+TEST(Health, Component)
+{
+    UnitMeasureDummy u;
+    auto mock = new MockI2C(0, 2);
+    EXPECT_TRUE(u.assign(mock));
+
+    uint8_t v{};
+    EXPECT_TRUE(u.readRegister8((uint8_t)0x10, v, 0));  // Write + read
+    EXPECT_EQ(u.health().transactions, 2U);
+    EXPECT_EQ(u.health().errors(), 0U);
+
+    mock->fail       = 1;
+    mock->fail_error = m5::hal::error::error_t::I2C_NO_ACK;
+    EXPECT_FALSE(u.readRegister8((uint8_t)0x10, v, 0));  // Failed in writing
+    mock->fail       = 1;
+    mock->fail_error = m5::hal::error::error_t::TIMEOUT_ERROR;
+    EXPECT_FALSE(u.writeRegister8((uint8_t)0x10, 0x12));
+    EXPECT_EQ(u.health().transactions, 4U);
+    EXPECT_EQ(u.health().nacks, 1U);
+    EXPECT_EQ(u.health().timeouts, 1U);
+
+    // Asynchronous transactions are recorded on completion
+    mock->fail       = 1;
+    mock->fail_error = m5::hal::error::error_t::I2C_BUS_ERROR;
+    bool done{};
+    EXPECT_TRUE(u.readRegisterAsync((uint8_t)0x10, 1, 0,
+                                    [&done](const m5::hal::error::error_t, const uint8_t*, const size_t) { done = true; }));
+    auto ad = u.asAdapter<AdapterI2C>(Adapter::Type::I2C);
+    for (int i = 0; i < 100 && !done; ++i) {
+        ad->poll();
+    }
+    EXPECT_TRUE(done);
+    EXPECT_EQ(u.health().transactions, 5U);
+    EXPECT_EQ(u.health().bus_errors, 1U);
+
+    u.reportCrcError();
+    EXPECT_EQ(u.health().errors(), 4U);
+    EXPECT_NE(u.debugInfo().find("CRC:1"), std::string::npos);
+
+    u.resetHealth();
+    EXPECT_EQ(u.health().transactions, 0U);
+
+    // Latency
+    mock->delay_us = 600;
+    EXPECT_TRUE(u.writeRegister8((uint8_t)0x10, 0x12));
+    EXPECT_GE(u.health().max_latency, 600U);
+    EXPECT_EQ(u.health().latency[0], 0U);
+}
+
+namespace {
+
+// 2 units at 400K on the same bus
+struct Fixture {
+    Fixture()
+    {
+        for (uint8_t i = 0; i < 2; ++i) {
+            units.emplace_back(new UnitPeriodicDummy(0x10 + i));
+            auto cfg  = units.back()->component_config();
+            cfg.clock = 400000U;
+            units.back()->component_config(cfg);
+            mocks.push_back(new MockI2C(0, 0, &bus));
+            EXPECT_TRUE(manager.add(*units.back(), mocks.back()));
+        }
+        EXPECT_TRUE(manager.begin());
+    }
+    uint32_t clock() const
+    {
+        EXPECT_EQ(mocks[0]->clock(), mocks[1]->clock());
+        return mocks[0]->clock();
+    }
+
+    MockBus bus{};
+    UnitUnified manager{};
+    std::vector<std::unique_ptr<UnitPeriodicDummy>> units{};
+    std::vector<MockI2C*> mocks{};  // Owned by the units
+};
+
+}  // namespace
+
+TEST(Health, AdaptiveClock)
+{
+    Fixture f;
+    UnitUnified::clock_policy_t policy{};
+    policy.enabled         = true;
+    policy.min_clock       = 100000U;
+    policy.window          = 0;  // Every update
+    policy.error_threshold = 1;
+    policy.probe_interval  = 0;
+    f.manager.setClockPolicy(policy);
+
+    f.manager.update(true);
+    EXPECT_EQ(f.clock(), 400000U);
+
+    // Step down on errors, not below the minimum
+    const uint32_t down[] = {200000U, 100000U, 100000U};
+    for (auto&& c : down) {
+        f.mocks[1]->fail = 1;
+        f.manager.update(true);
+        EXPECT_EQ(f.clock(), c);
+    }
+
+    // Probe up while healthy, not above the clock of the units
+    const uint32_t up[] = {200000U, 400000U, 400000U};
+    for (auto&& c : up) {
+        f.manager.update(true);
+        EXPECT_EQ(f.clock(), c);
+    }
+
+    auto bh = f.manager.busHealth();
+    ASSERT_EQ(bh.size(), 1U);
+    EXPECT_EQ(bh[0].bus, &f.bus);
+    EXPECT_EQ(bh[0].units, 2U);
+    EXPECT_EQ(bh[0].clock, 400000U);
+    EXPECT_EQ(bh[0].health.timeouts, 3U);
+    // write + read, 2 units, 7 updates, no read after the failed writes
+    EXPECT_EQ(bh[0].health.transactions, 2U * 2 * 7 - 3);
+
+    auto js = f.manager.healthJSON();
+    EXPECT_NE(js.find("\"clock\":400000"), std::string::npos);
+    EXPECT_NE(js.find("\"name\":\"UnitPeriodicDummy\",\"addr\":17"), std::string::npos);
+    EXPECT_NE(f.manager.debugInfo().find("400000Hz units:2"), std::string::npos);
+
+    f.manager.resetHealth();
+    EXPECT_EQ(f.manager.busHealth()[0].health.transactions, 0U);
+}
+
+TEST(Health, PolicyDisabled)
+{
+    Fixture f;
+    for (int i = 0; i < 4; ++i) {
+        f.mocks[0]->fail = 1;
+        f.manager.update(true);
+    }
+    EXPECT_EQ(f.clock(), 400000U);
+    EXPECT_EQ(f.units[0]->health().timeouts, 4U);
+
+    // Probing needs the interval without errors
+    UnitUnified::clock_policy_t policy{};
+    policy.enabled         = true;
+    policy.window          = 0;
+    policy.error_threshold = 1;
+    policy.probe_interval  = 60 * 1000;
+    f.manager.setClockPolicy(policy);
+    f.manager.update(true);
+    f.mocks[0]->fail = 1;
+    f.manager.update(true);
+    EXPECT_EQ(f.clock(), 200000U);
+    f.manager.update(true);
+    f.manager.update(true);
+    EXPECT_EQ(f.clock(), 200000U);
+}
+
+// Nothing is evaluated before the window has elapsed
+TEST(Health, ClockWindow)
+{
+    Fixture f;
+    UnitUnified::clock_policy_t policy{};
+    policy.enabled         = true;
+    policy.window          = 60 * 1000;
+    policy.error_threshold = 1;
+    f.manager.setClockPolicy(policy);
+    f.manager.update(true);  // First update starts the window
+    for (int i = 0; i < 4; ++i) {
+        f.mocks[0]->fail = 1;
+        f.manager.update(true);
+    }
+    EXPECT_EQ(f.clock(), 400000U);
+    EXPECT_EQ(f.units[0]->health().timeouts, 4U);
+}
@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for PeriodicMeasurementAdapter views
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5Utility.hpp>
+#include <array>
+#include <chrono>
+#include <cstdio>
+
+using namespace m5::unit;
+using namespace m5::utility::mmh3;
+
+namespace m5 {
+namespace unit {
+
+// Same layout as SHT3X data (raw temperature and humidity with CRC)
+struct DummyData {
+    std::array<uint8_t, 6> raw{};
+    uint32_t at{};
+    inline float temperature() const
+    {
+        return -45.f + 175.f * ((raw[0] << 8) | raw[1]) / 65535.f;
+    }
+};
+
+class UnitStoreDummy : public Component, public PeriodicMeasurementAdapter<UnitStoreDummy, DummyData> {
+    M5_UNIT_COMPONENT_HPP_BUILDER(UnitStoreDummy, 0x44);
+
+public:
+    explicit UnitStoreDummy(const size_t stored)
+        : Component(DEFAULT_ADDRESS), _data{new m5::container::CircularBuffer<DummyData>(stored)}
+    {
+    }
+    virtual bool begin() override
+    {
+        return true;
+    }
+    virtual void update(const bool force = false) override
+    {
+        (void)force;
+    }
+    // Emulates update() storing the measurement
+    void store(const uint32_t n)
+    {
+        for (uint32_t i = 0; i < n; ++i) {
+            DummyData d{};
+            d.raw[0] = _seq >> 8;
+            d.raw[1] = _seq & 0xFF;
+            d.at     = _seq++;
+            _data->push_back(d);
+        }
+    }
+
+protected:
+    bool start_periodic_measurement()
+    {
+        return true;
+    }
+    bool stop_periodic_measurement()
+    {
+        return true;
+    }
+
+    M5_UNIT_COMPONENT_PERIODIC_MEASUREMENT_ADAPTER_HPP_BUILDER(UnitStoreDummy, DummyData);
+
+protected:
+    std::unique_ptr<m5::container::CircularBuffer<DummyData>> _data{};
+    uint32_t _seq{};
+};
+
+const char UnitStoreDummy::name[] = "UnitStoreDummy";
+const types::uid_t UnitStoreDummy::uid{"UnitStoreDummy"_mmh3};
+const types::attr_t UnitStoreDummy::attr{0};
+
+}  // namespace unit
+}  // namespace m5
+
+TEST(PeriodicView, View)
+{
+    UnitStoreDummy u(8);
+
+    auto v = u.view();
+    EXPECT_TRUE(v.empty());
+    u.commit(v);
+    EXPECT_TRUE(u.empty());
+
+    // Not wrapped
+    u.store(5);
+    v = u.view();
+    EXPECT_EQ(v.size(), 5U);
+    EXPECT_TRUE(v.second.empty());
+    EXPECT_EQ(v[0].at, 0U);
+    EXPECT_EQ(v[4].at, 4U);
+    EXPECT_EQ(&v[0], &v.first[0]);
+
+    // Partial commit
+    v = u.view(2);
+    EXPECT_EQ(v.size(), 2U);
+    u.commit(v);
+    EXPECT_EQ(u.available(), 3U);
+    EXPECT_EQ(u.oldest().at, 2U);
+
+    // Wrapped and overwritten
+    u.store(10);
+    EXPECT_TRUE(u.full());
+    v = u.view();
+    EXPECT_EQ(v.size(), 8U);
+    EXPECT_FALSE(v.second.empty());
+    uint32_t expected{7};
+    v.for_each([&expected](const DummyData& d) { EXPECT_EQ(d.at, expected++); });
+    EXPECT_EQ(expected, 15U);
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v[i].at, 7U + i);
+    }
+    EXPECT_EQ(v[v.size() - 1].at, u.latest().at);
+
+    // Data stored after taking the view stays
+    u.commit(v);
+    EXPECT_TRUE(u.empty());
+    u.store(3);
+    v = u.view();
+    u.store(1);
+    u.commit(v);
+    EXPECT_EQ(u.available(), 1U);
+    EXPECT_EQ(u.oldest().at, 18U);
+
+    u.discard(5);
+    EXPECT_TRUE(u.empty());
+}
+
+// Draining all stored data: oldest/discard per data vs view/commit
+TEST(PeriodicView, Benchmark)
+{
+    constexpr uint32_t ROUNDS{2000};
+
+    for (auto&& stored : {64U, 256U}) {
+        UnitStoreDummy u(stored);
+        double copy_ns{}, view_ns{};
+        float sum_copy{}, sum_view{};
+        uint32_t cnt_copy{}, cnt_view{};
+
+        for (uint32_t r = 0; r < ROUNDS; ++r) {
+            // Wrapped half of the time
+            u.store(stored);
+            auto t0 = std::chrono::steady_clock::now();
+            while (!u.empty()) {
+                sum_copy += u.oldest().temperature();
+                u.discard();
+                ++cnt_copy;
+            }
+            copy_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+            u.store(stored);
+            t0     = std::chrono::steady_clock::now();
+            auto v = u.view();
+            v.for_each([&sum_view](const DummyData& d) { sum_view += d.temperature(); });
+            u.commit(v);
+            cnt_view += v.size();
+            view_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            EXPECT_TRUE(u.empty());
+            u.store(r & 1);
+            u.discard(1);
+        }
+        const double total = (double)stored * ROUNDS;
+        std::printf("[ BENCH    ] stored %3u copy %7.2f ns/data (%6.2f M/s) view %7.2f ns/data (%6.2f M/s)\n", stored,
+                    copy_ns / total, total / copy_ns * 1000.0, view_ns / total, total / view_ns * 1000.0);
+        // Timings are only reported; both paths must drain every stored data
+        EXPECT_EQ(cnt_copy, stored * ROUNDS);
+        EXPECT_EQ(cnt_view, stored * ROUNDS);
+        EXPECT_GT(sum_copy + sum_view, 0.f);
+    }
+}
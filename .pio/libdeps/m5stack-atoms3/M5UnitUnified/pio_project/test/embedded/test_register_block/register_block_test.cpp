@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for RegisterBlock
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace m5::unit;
+
+namespace {
+
+// QMP6988 OTP calibration (0xA0-0xB8)
+constexpr uint8_t OTP_REG{0xA0};
+constexpr int32_t B00{-123456}, A0{54321};
+constexpr int16_t COE[11] = {-1234, 2345, -3456, 4567, -5678, 6789, -7890, 8901, -9012, 123, -321};
+
+void write_otp(MockI2C& m)
+{
+    auto* p = &m.regs[OTP_REG];
+    p[0]    = (B00 >> 12) & 0xFF;
+    p[1]    = (B00 >> 4) & 0xFF;
+    for (int i = 0; i < 8; ++i) {  // bt1 ... bp3
+        p[2 + i * 2] = COE[i] >> 8;
+        p[3 + i * 2] = COE[i] & 0xFF;
+    }
+    p[18] = (A0 >> 12) & 0xFF;
+    p[19] = (A0 >> 4) & 0xFF;
+    for (int i = 0; i < 2; ++i) {  // a1, a2
+        p[20 + i * 2] = COE[8 + i] >> 8;
+        p[21 + i * 2] = COE[8 + i] & 0xFF;
+    }
+    p[24] = ((B00 & 0x0F) << 4) | (A0 & 0x0F);
+}
+
+struct otp_t {
+    int32_t b00, a0;
+    int16_t coe[10];
+};
+
+otp_t decode(const RegisterBlock<uint8_t, 25>& b)
+{
+    otp_t o{};
+    auto nib = b.segment<24, 4>();
+    o.b00    = b.signedBits<20>(((uint32_t)b.be<0>() << 4) | nib.upper());
+    o.a0     = b.signedBits<20>(((uint32_t)b.be<18>() << 4) | nib.lower());
+    o.coe[0] = b.be<2, int16_t>();
+    o.coe[1] = b.be<4, int16_t>();
+    o.coe[2] = b.be<6, int16_t>();
+    o.coe[3] = b.be<8, int16_t>();
+    o.coe[4] = b.be<10, int16_t>();
+    o.coe[5] = b.be<12, int16_t>();
+    o.coe[6] = b.be<14, int16_t>();
+    o.coe[7] = b.be<16, int16_t>();
+    o.coe[8] = b.be<20, int16_t>();
+    o.coe[9] = b.be<22, int16_t>();
+    return o;
+}
+
+// Field by field, as drivers used to do
+bool read_fields(UnitMeasureDummy& u, otp_t& o)
+{
+    uint16_t w[12]{};
+    uint8_t nib{};
+    for (uint8_t i = 0; i < 12; ++i) {
+        if (!u.readRegister16BE((uint8_t)(OTP_REG + i * 2), w[i], 0)) {
+            return false;
+        }
+    }
+    if (!u.readRegister8((uint8_t)(OTP_REG + 24), nib, 0)) {
+        return false;
+    }
+    o.b00 = m5::utility::unsigned_to_signed<20>(((uint32_t)w[0] << 4) | (nib >> 4));
+    o.a0  = m5::utility::unsigned_to_signed<20>(((uint32_t)w[9] << 4) | (nib & 0x0F));
+    for (int i = 0; i < 8; ++i) {
+        o.coe[i] = (int16_t)w[1 + i];
+    }
+    o.coe[8] = (int16_t)w[10];
+    o.coe[9] = (int16_t)w[11];
+    return true;
+}
+
+}  // namespace
+
+TEST(RegisterBlock, Decode)
+{
+    RegisterBlock<uint16_t, 8> b{0x1234};
+    EXPECT_EQ(b.reg(), 0x1234);
+    EXPECT_EQ(b.size(), 8U);
+    const uint8_t src[8] = {0x12, 0x34, 0xFE, 0xDC, 0xAB, 0x80, 0x00, 0x01};
+    std::copy(src, src + 8, b.data());
+
+    EXPECT_EQ((b.be<0>()), 0x1234);
+    EXPECT_EQ((b.le<0>()), 0x3412);
+    EXPECT_EQ((b.be<2, int16_t>()), (int16_t)0xFEDC);
+    EXPECT_EQ((b.be<0, uint32_t>()), 0x1234FEDCU);
+    EXPECT_EQ((b.le<4, uint32_t>()), 0x010080ABU);
+    EXPECT_EQ((b.bytes<3, 3>()), 0xDCAB80U);
+    EXPECT_EQ((b.be<7, uint8_t>()), 0x01);
+
+    auto seg = b.segment<4, 4>();
+    EXPECT_EQ(seg.upper(), 0x0A);
+    EXPECT_EQ(seg.lower(), 0x0B);
+    auto seg16 = b.segment<4, 7, uint16_t>();
+    EXPECT_EQ(seg16.upper(), 0xAB80U >> 7);
+    EXPECT_EQ(seg16.lower(), 0x00U);
+
+    EXPECT_EQ(b.signedBits<24>(0xFFFFFF), -1);
+    EXPECT_EQ(b.signedBits<20>(0x7FFFF), 0x7FFFF);
+
+    // Sensirion example, 0xBEEF -> 0x92
+    const uint8_t frame[6] = {0xBE, 0xEF, 0x92, 0x12, 0x34, 0x00};
+    RegisterBlock<uint16_t, 6> f{0xE000};
+    std::copy(frame, frame + 6, f.data());
+    EXPECT_TRUE((f.crc8<0>()));
+    EXPECT_FALSE((f.crc8<3>()));
+}
+
+TEST(RegisterBlock, Read)
+{
+    UnitMeasureDummy u;
+    auto mock = new MockI2C();
+    write_otp(*mock);
+    EXPECT_TRUE(u.assign(mock));
+
+    RegisterBlock<uint8_t, 25> otp{OTP_REG};
+    EXPECT_TRUE(u.readRegister(otp));
+    EXPECT_EQ(mock->reads + mock->writes, 2U);
+    auto o = decode(otp);
+    EXPECT_EQ(o.b00, B00);
+    EXPECT_EQ(o.a0, A0);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(o.coe[i], COE[i]) << i;
+    }
+
+    otp_t f{};
+    EXPECT_TRUE(read_fields(u, f));
+    EXPECT_EQ(mock->reads + mock->writes, 2U + 26U);
+    EXPECT_EQ(f.b00, o.b00);
+    EXPECT_EQ(f.a0, o.a0);
+    EXPECT_EQ(0, std::memcmp(f.coe, o.coe, sizeof(o.coe)));
+
+    // Cached as a block
+    u.setRegisterCache(new RegisterCache{{OTP_REG, OTP_REG + 24, true}});
+    EXPECT_TRUE(u.readRegister(otp));
+    EXPECT_TRUE(u.readRegister(otp));
+    EXPECT_EQ(u.registerCache()->hits(), 1U);
+}
+
+// Transactions and bus time per measurement, replaying at 400 kHz
+TEST(RegisterBlock, Benchmark)
+{
+    constexpr uint32_t ROUNDS{50};
+
+    // Record both access patterns against the mock
+    auto record = [](const bool block) {
+        auto trace = std::make_shared<I2CTrace>();
+        UnitMeasureDummy u;
+        auto mock = new MockI2C();
+        write_otp(*mock);
+        EXPECT_TRUE(u.assign(new I2CRecordImpl(mock, trace)));
+        RegisterBlock<uint8_t, 25> otp{OTP_REG};
+        otp_t o{};
+        EXPECT_TRUE(block ? u.readRegister(otp) : read_fields(u, o));
+        return trace;
+    };
+
+    struct result_t {
+        const char* label;
+        bool block;
+        size_t transactions;
+        double us;
+        uint64_t bus_us;  // Emulated bus time per read
+    } results[] = {{"fields", false, 0, 0, 0}, {"block", true, 0, 0, 0}};
+
+    for (auto&& r : results) {
+        auto trace     = record(r.block);
+        r.transactions = trace->size();
+
+        UnitMeasureDummy u;
+        auto cfg  = u.component_config();
+        cfg.clock = 400000U;
+        u.component_config(cfg);
+        auto replay = new I2CReplayImpl(trace, I2CReplayImpl::Timing::Clock, true);
+        EXPECT_TRUE(u.assign(replay));
+        otp_t o{};
+        RegisterBlock<uint8_t, 25> otp{OTP_REG};
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < ROUNDS; ++i) {
+            if (r.block) {
+                EXPECT_TRUE(u.readRegister(otp));
+                o = decode(otp);
+            } else {
+                EXPECT_TRUE(read_fields(u, o));
+            }
+        }
+        r.us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / ROUNDS;
+        r.bus_us = replay->busTime() / ROUNDS;
+        EXPECT_EQ(o.b00, B00);
+        EXPECT_EQ(replay->mismatches(), 0U);
+        EXPECT_EQ(replay->replayed(), r.transactions * ROUNDS);
+    }
+
+    for (auto&& r : results) {
+        std::printf("[ BENCH    ] QMP6988 OTP %-6s %2zu transactions %8.1f us/read (bus %u us)\n", r.label,
+                    r.transactions, r.us, (unsigned)r.bus_us);
+    }
+    // Timings are only reported; transactions and emulated bus time are exact.
+    // Fields: 12 x (write 1 + read 2 bytes) and write 1 + read 1 byte,
+    // block: write 1 + read 25 bytes (9 bits per byte + address, start, stop)
+    EXPECT_EQ(results[0].transactions, 26U);
+    EXPECT_EQ(results[1].transactions, 2U);
+    EXPECT_EQ(results[0].bus_us, 12U * (50 + 72) + (50 + 50));
+    EXPECT_EQ(results[1].bus_us, 50U + 590);
+
+    // SHT3X 6 bytes data + CRC
+    m5::utility::CRC8_Checksum crc{};
+    uint8_t frame[6] = {0x66, 0x66, 0, 0x80, 0x00, 0};
+    frame[2] = crc.range(frame, 2);
+    frame[5] = crc.range(frame + 3, 2);
+    std::string text{"0 44 W 1 0 0 2400\n0 44 R 1 0 0 "};
+    for (auto&& b : frame) {
+        text += m5::utility::formatString("%02X", b);
+    }
+    auto trace = std::make_shared<I2CTrace>();
+    ASSERT_TRUE(trace->fromString(text.c_str()));
+
+    UnitMeasureDummy u;
+    auto cfg  = u.component_config();
+    cfg.clock = 400000U;
+    u.component_config(cfg);
+    auto replay = new I2CReplayImpl(trace, I2CReplayImpl::Timing::Clock, true);
+    EXPECT_TRUE(u.assign(replay));
+    RegisterBlock<uint16_t, 6> data{0x2400};
+    float t{}, rh{};
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ROUNDS; ++i) {
+        EXPECT_TRUE(u.readRegister(data));
+        EXPECT_TRUE((data.crc8<0>() && data.crc8<3>()));
+        t  = -45.f + 175.f * data.be<0>() / 65535.f;
+        rh = 100.f * data.be<3>() / 65535.f;
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / ROUNDS;
+    std::printf("[ BENCH    ] SHT3X frame  block   2 transactions %8.1f us/read\n", us);
+    EXPECT_NEAR(t, 25.0f, 0.1f);
+    EXPECT_NEAR(rh, 50.0f, 0.1f);
+    EXPECT_EQ(replay->mismatches(), 0U);
+}
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for RegisterCache
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <cstdio>
+
+using namespace m5::unit;
+
+TEST(RegisterCache, Ranges)
+{
+    RegisterCache rc{{0x10, 0x1F, true}, {0x80, 0x8F, true}};
+    rc.addVolatile(0x18, 0x19);
+
+    EXPECT_FALSE(rc.cacheable(0x00, 1));
+    EXPECT_TRUE(rc.cacheable(0x10, 1));
+    EXPECT_TRUE(rc.cacheable(0x10, 8));
+    EXPECT_FALSE(rc.cacheable(0x10, 9));  // Overlaps volatile
+    EXPECT_FALSE(rc.cacheable(0x19, 2));
+    EXPECT_TRUE(rc.cacheable(0x1A, 6));
+    EXPECT_FALSE(rc.cacheable(0x1A, 7));  // Beyond the range
+    EXPECT_FALSE(rc.cacheable(0x10, 0));
+    EXPECT_TRUE(rc.cacheable(0x8F, 1));
+
+    uint8_t buf[4]{};
+    const uint8_t v[4] = {1, 2, 3, 4};
+    EXPECT_FALSE(rc.read(0x80, buf, 4));
+    rc.fill(0x80, v, 4);
+    EXPECT_TRUE(rc.read(0x80, buf, 4));
+    EXPECT_EQ(buf[3], 4);
+    EXPECT_TRUE(rc.read(0x80, buf, 2));   // Shorter
+    EXPECT_FALSE(rc.read(0x81, buf, 1));  // Not the same start
+    EXPECT_FALSE(rc.read(0x18, buf, 1));
+    EXPECT_EQ(rc.hits(), 2U);
+    EXPECT_EQ(rc.misses(), 2U);
+    EXPECT_EQ(rc.bypasses(), 1U);
+
+    // Overlapping write invalidates
+    rc.write(0x83, v, 1);
+    EXPECT_FALSE(rc.read(0x80, buf, 4));
+    EXPECT_TRUE(rc.read(0x83, buf, 1));
+    EXPECT_EQ(buf[0], 1);
+    // Register only
+    rc.write(0x83, nullptr, 0);
+    EXPECT_TRUE(rc.read(0x83, buf, 1));
+
+    rc.invalidate();
+    EXPECT_FALSE(rc.read(0x83, buf, 1));
+}
+
+TEST(RegisterCache, Component)
+{
+    UnitMeasureDummy u;
+    auto mock = new MockI2C();
+    mock->regs[0x00] = 0xAA;
+    mock->regs[0x10] = 0x12;
+    mock->regs[0x11] = 0x34;
+    EXPECT_TRUE(u.assign(mock));
+
+    // Not enabled
+    uint8_t v{};
+    EXPECT_TRUE(u.readRegister8((uint8_t)0x10, v, 0));
+    EXPECT_TRUE(u.readRegister8((uint8_t)0x10, v, 0));
+    EXPECT_EQ(mock->reads, 2U);
+    EXPECT_EQ(u.registerCache(), nullptr);
+
+    u.setRegisterCache(new RegisterCache{{0x10, 0x1F, true}});
+    auto rc  = u.registerCache();
+    mock->reads = mock->writes = 0;
+
+    // Non-volatile
+    uint16_t w{};
+    EXPECT_TRUE(u.readRegister16BE((uint8_t)0x10, w, 0));
+    EXPECT_EQ(w, 0x1234);
+    for (int i = 0; i < 10; ++i) {
+        w = 0;
+        EXPECT_TRUE(u.readRegister16BE((uint8_t)0x10, w, 0));
+        EXPECT_EQ(w, 0x1234);
+    }
+    EXPECT_EQ(mock->reads, 1U);
+    EXPECT_EQ(rc->hits(), 10U);
+    EXPECT_EQ(rc->misses(), 1U);
+
+    // Volatile
+    EXPECT_TRUE(u.readRegister8((uint8_t)0x00, v, 0));
+    EXPECT_TRUE(u.readRegister8((uint8_t)0x00, v, 0));
+    EXPECT_EQ(v, 0xAA);
+    EXPECT_EQ(mock->reads, 3U);
+    EXPECT_EQ(rc->bypasses(), 2U);
+
+    // Write-through
+    EXPECT_TRUE(u.writeRegister8((uint8_t)0x14, 0x56));
+    EXPECT_EQ(mock->regs[0x14], 0x56);
+    EXPECT_TRUE(u.readRegister8((uint8_t)0x14, v, 0));
+    EXPECT_EQ(v, 0x56);
+    EXPECT_EQ(mock->reads, 3U);
+    EXPECT_EQ(rc->writes(), 1U);
+
+    // Overlapping write
+    EXPECT_TRUE(u.writeRegister8((uint8_t)0x11, 0x78));
+    EXPECT_TRUE(u.readRegister16BE((uint8_t)0x10, w, 0));
+    EXPECT_EQ(w, 0x1278);
+    EXPECT_EQ(mock->reads, 4U);
+
+    EXPECT_NE(u.debugInfo().find("Cache:"), std::string::npos);
+
+    // Disable
+    u.setRegisterCache(nullptr);
+    EXPECT_TRUE(u.readRegister16BE((uint8_t)0x10, w, 0));
+    EXPECT_EQ(mock->reads, 5U);
+}
+
+// Driver pattern: check the mode register before every measurement
+TEST(RegisterCache, Traffic)
+{
+    constexpr uint32_t MEASUREMENTS{100};
+
+    auto run = [](const bool cached) {
+        UnitMeasureDummy u;
+        auto mock = new MockI2C();
+        EXPECT_TRUE(u.assign(mock));
+        if (cached) {
+            u.setRegisterCache(new RegisterCache{{0x20, 0x2F, true}});
+        }
+        for (uint32_t i = 0; i < MEASUREMENTS; ++i) {
+            uint8_t mode{}, data[6]{};
+            EXPECT_TRUE(u.readRegister8((uint8_t)0x20, mode, 0));
+            EXPECT_TRUE(u.readRegister((uint8_t)0x00, data, 6, 0));
+        }
+        return mock->reads + mock->writes;
+    };
+
+    auto plain  = run(false);
+    auto cached = run(true);
+    std::printf("[ BENCH    ] %u measurements: %u transactions uncached, %u cached\n", MEASUREMENTS, plain, cached);
+    EXPECT_EQ(plain, MEASUREMENTS * 4);
+    EXPECT_EQ(cached, MEASUREMENTS * 2 + 2);
+}
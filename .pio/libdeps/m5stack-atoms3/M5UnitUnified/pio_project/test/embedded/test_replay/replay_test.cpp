@@ -0,0 +1,241 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for recording and replaying I2C traces
+  Runs on the host over the mock bus: pio test -e test_native_mock -f embedded/test_replay
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5UnitUnified.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace m5::unit;
+
+namespace {
+
+// Reads like SHT3X single shot (write 0x2400, then 6 bytes of data + CRC)
+class UnitSingleShotDummy : public UnitMeasureDummy {
+public:
+    bool measure(uint8_t* buf)
+    {
+        return writeRegister((uint16_t)0x2400, nullptr, 0U) &&
+               readWithTransaction(buf, 6) == m5::hal::error::error_t::OK;
+    }
+    bool readBlock(uint8_t* buf, const size_t len)
+    {
+        return readRegister((uint8_t)0xA0, buf, len, 0);
+    }
+};
+
+constexpr char sht3x_like[] =
+    "# at_us addr op stop result duration_us data\n"
+    "0 44 W 1 0 60 2400\n"
+    "15500 44 R 1 0 160 6E1A2B5F3C9D\n"
+    "\n"
+    "31000 44 W 1 0 60 2400\n"
+    "46500 44 R 1 0 160 6E1C4F5F3D1E\n";
+
+}  // namespace
+
+TEST(Replay, RecordAndText)
+{
+    auto trace = std::make_shared<I2CTrace>(4);
+    auto mock  = new MockI2C();
+    mock->regs[0xA0] = 0x12;
+    mock->regs[0xA1] = 0x34;
+
+    UnitSingleShotDummy u;
+    EXPECT_TRUE(u.assign(new I2CRecordImpl(mock, trace)));
+
+    uint8_t buf[2]{};
+    EXPECT_TRUE(u.readBlock(buf, 2));
+    EXPECT_EQ(buf[0], 0x12);
+    EXPECT_EQ(buf[1], 0x34);
+    ASSERT_EQ(trace->size(), 2U);
+    auto& w = trace->entries()[0];
+    auto& r = trace->entries()[1];
+    EXPECT_EQ(w.op, i2c_trace_entry_t::Op::Write);
+    EXPECT_EQ(w.addr, 0x44);
+    EXPECT_EQ(w.data, std::vector<uint8_t>({0xA0}));
+    EXPECT_EQ(r.op, i2c_trace_entry_t::Op::Read);
+    EXPECT_EQ(r.data, std::vector<uint8_t>({0x12, 0x34}));
+    EXPECT_LE(w.at, r.at);
+
+    // Full
+    EXPECT_TRUE(u.readBlock(buf, 2));
+    EXPECT_TRUE(u.readBlock(buf, 2));
+    EXPECT_EQ(trace->size(), 4U);
+    EXPECT_EQ(trace->dropped(), 2U);
+
+    // Round trip
+    I2CTrace copy;
+    EXPECT_TRUE(copy.fromString(trace->toString().c_str()));
+    ASSERT_EQ(copy.size(), trace->size());
+    for (size_t i = 0; i < copy.size(); ++i) {
+        auto& a = copy.entries()[i];
+        auto& b = trace->entries()[i];
+        EXPECT_EQ(a.at, b.at);
+        EXPECT_EQ(a.duration, b.duration);
+        EXPECT_EQ(a.addr, b.addr);
+        EXPECT_EQ(a.op, b.op);
+        EXPECT_EQ(a.stop, b.stop);
+        EXPECT_EQ(a.result, b.result);
+        EXPECT_EQ(a.data, b.data);
+    }
+
+    // Written out line by line, as the app streams it
+    std::string lines{I2CTrace::textHeader()};
+    for (auto&& e : trace->entries()) {
+        lines += I2CTrace::toString(e);
+    }
+    EXPECT_EQ(lines, trace->toString());
+    auto line = I2CTrace::toString(r);
+    EXPECT_EQ(line.substr(line.size() - 6), " 1234\n");
+
+    EXPECT_FALSE(copy.fromString("0 44 X 1 0 60 2400\n"));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.fromString(nullptr));
+}
+
+TEST(Replay, Replay)
+{
+    auto trace = std::make_shared<I2CTrace>();
+    ASSERT_TRUE(trace->fromString(sht3x_like));
+    ASSERT_EQ(trace->size(), 4U);
+
+    UnitSingleShotDummy u;
+    auto replay = new I2CReplayImpl(trace, I2CReplayImpl::Timing::None);
+    EXPECT_TRUE(u.assign(replay));
+
+    uint8_t buf[6]{};
+    EXPECT_TRUE(u.measure(buf));
+    EXPECT_EQ(buf[0], 0x6E);
+    EXPECT_EQ(buf[5], 0x9D);
+    EXPECT_TRUE(u.measure(buf));
+    EXPECT_EQ(buf[2], 0x4F);
+    EXPECT_EQ(replay->mismatches(), 0U);
+    EXPECT_TRUE(replay->finished());
+
+    // Exhausted
+    EXPECT_FALSE(u.measure(buf));
+    EXPECT_NE(replay->mismatches(), 0U);
+
+    // Written bytes differ from the recording
+    replay->rewind();
+    auto m = replay->mismatches();
+    EXPECT_TRUE(u.readBlock(buf, 6));  // Register 0xA0 instead of 0x2400
+    EXPECT_EQ(replay->mismatches(), m + 1);
+}
+
+TEST(Replay, LoopAndUpdate)
+{
+    // Record the periodic dummy, then replay it in a loop
+    auto trace = std::make_shared<I2CTrace>();
+    {
+        UnitUnified units;
+        UnitPeriodicDummy u(0x50, 1);
+        auto mock = new MockI2C();
+        EXPECT_TRUE(units.add(u, new I2CRecordImpl(mock, trace)));
+        EXPECT_TRUE(units.begin());
+        for (int i = 0; i < 4; ++i) {
+            units.update(true);
+        }
+        EXPECT_EQ(u.count, 4U);
+    }
+    EXPECT_EQ(trace->size(), 8U);
+
+    UnitUnified units;
+    UnitPeriodicDummy u(0x50, 1);
+    auto replay = new I2CReplayImpl(trace, I2CReplayImpl::Timing::Recorded, true);
+    EXPECT_TRUE(units.add(u, replay));
+    EXPECT_TRUE(units.begin());
+    for (int i = 0; i < 10; ++i) {
+        units.update(true);
+    }
+    EXPECT_EQ(u.count, 10U);
+    EXPECT_EQ(replay->mismatches(), 0U);
+}
+
+// Cost of the read path and of UnitUnified::update over a replayed bus
+// -v prints the BENCH lines
+TEST(Replay, Benchmark)
+{
+    constexpr size_t UNITS{16};
+    constexpr uint32_t ROUNDS{200};
+
+    auto trace = std::make_shared<I2CTrace>(UNITS * 2);
+    {
+        std::vector<std::unique_ptr<UnitPeriodicDummy>> units;
+        UnitUnified manager;
+        MockBus bus;
+        for (size_t i = 0; i < UNITS; ++i) {
+            units.emplace_back(new UnitPeriodicDummy(0x10 + i, 1));
+            EXPECT_TRUE(manager.add(*units.back(), new I2CRecordImpl(new MockI2C(0, 0, &bus), trace)));
+        }
+        EXPECT_TRUE(manager.begin());
+        manager.update(true);
+    }
+    ASSERT_EQ(trace->size(), UNITS * 2);
+
+    struct result_t {
+        const char* label;
+        I2CReplayImpl::Timing timing;
+        uint32_t clock;
+        uint32_t unit_bus_us;  // Emulated per unit and update
+        double us;
+        uint32_t mismatches;
+        uint32_t replayed;
+        uint64_t bus_us;
+    } results[] = {
+        // Per unit, writing the register is 20 bits and reading 2 bytes is 29 bits
+        {"None", I2CReplayImpl::Timing::None, 400000U, 0, 0, 0, 0, 0},
+        {"Clock100K", I2CReplayImpl::Timing::Clock, 100000U, 200 + 290, 0, 0, 0, 0},
+        {"Clock400K", I2CReplayImpl::Timing::Clock, 400000U, 50 + 72, 0, 0, 0, 0},
+    };
+
+    for (auto&& r : results) {
+        std::vector<std::unique_ptr<UnitPeriodicDummy>> units;
+        std::vector<I2CReplayImpl*> impls;
+        UnitUnified manager;
+        for (size_t i = 0; i < UNITS; ++i) {
+            units.emplace_back(new UnitPeriodicDummy(0x10 + i, 1));
+            auto cfg  = units.back()->component_config();
+            cfg.clock = r.clock;
+            units.back()->component_config(cfg);
+            impls.push_back(new I2CReplayImpl(trace, r.timing, true));
+            EXPECT_TRUE(manager.add(*units.back(), impls.back()));
+        }
+        EXPECT_TRUE(manager.begin());
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < ROUNDS; ++i) {
+            manager.update(true);
+        }
+        r.us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / ROUNDS;
+        for (auto&& p : impls) {
+            r.mismatches += p->mismatches();
+            r.replayed += p->replayed();
+            r.bus_us += p->busTime();
+        }
+        for (auto&& u : units) {
+            EXPECT_EQ(u->count, ROUNDS);
+        }
+    }
+
+    for (auto&& r : results) {
+        std::printf("[ BENCH    ] %-9s %2zu units %9.2f us/update %8.3f us/unit (bus %u us/update)\n", r.label,
+                    UNITS, r.us, r.us / UNITS, (unsigned)(r.bus_us / ROUNDS));
+        // Timings are only reported; the transactions and emulated bus time are exact
+        EXPECT_EQ(r.mismatches, 0U);
+        EXPECT_EQ(r.replayed, UNITS * ROUNDS * 2);
+        EXPECT_EQ(r.bus_us, (uint64_t)UNITS * ROUNDS * r.unit_bus_us);
+    }
+}
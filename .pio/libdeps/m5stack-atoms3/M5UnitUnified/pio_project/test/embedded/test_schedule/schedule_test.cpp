@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for scheduling of UnitUnified::update
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5UnitUnified.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace m5::unit;
+
+namespace {
+
+// Units registered alternately on 2 buses with 2 clocks
+struct Fixture {
+    explicit Fixture(const size_t num)
+    {
+        for (size_t i = 0; i < num; ++i) {
+            units.emplace_back(new UnitPeriodicDummy(0x10 + i, 10 + (i % 4) * 10));
+            auto cfg  = units.back()->component_config();
+            cfg.clock = (i & 2) ? 400000U : 100000U;
+            units.back()->component_config(cfg);
+            EXPECT_TRUE(manager.add(*units.back(), new MockI2C(0, 0, &buses[i & 1])));
+        }
+        EXPECT_TRUE(manager.begin());
+    }
+    uint32_t switches() const
+    {
+        return buses[0].address_switches + buses[0].clock_switches + buses[1].address_switches +
+               buses[1].clock_switches;
+    }
+    uint32_t measurements() const
+    {
+        uint32_t cnt{};
+        for (auto&& u : units) {
+            cnt += u->count;
+        }
+        return cnt;
+    }
+
+    MockBus buses[2]{};
+    UnitUnified manager{};
+    std::vector<std::unique_ptr<UnitPeriodicDummy>> units{};
+};
+
+}  // namespace
+
+TEST(Schedule, BusOrder)
+{
+    Fixture f(8);
+
+    f.manager.enableScheduling(false);
+    f.manager.update(true);
+    const uint32_t unordered = f.switches();
+    EXPECT_EQ(f.measurements(), 8U);
+
+    f.buses[0] = f.buses[1] = MockBus{};
+    f.manager.enableScheduling(true);
+    f.manager.update(true);
+    EXPECT_EQ(f.measurements(), 16U);
+    // Per bus, 100K and 400K groups each in address order
+    for (auto&& b : f.buses) {
+        EXPECT_EQ(b.transfers, 8U);  // write + read for 4 units
+        EXPECT_EQ(b.clock_switches, 1U);
+        EXPECT_EQ(b.address_switches, 3U);
+    }
+    EXPECT_LT(f.switches(), unordered);
+}
+
+TEST(Schedule, Wakeup)
+{
+    UnitUnified units;
+    UnitPeriodicDummy u0(0x10, 30), u1(0x11, 50);
+    EXPECT_TRUE(units.add(u0, new MockI2C()));
+    EXPECT_TRUE(units.add(u1, new MockI2C()));
+
+    // Not begun
+    EXPECT_EQ(units.idleMillis(), 0U);
+
+    EXPECT_TRUE(units.begin());
+    m5::utility::delay(1);
+    units.update();
+    EXPECT_TRUE(u0.updated());
+    EXPECT_TRUE(u1.updated());
+    EXPECT_EQ(units.nextWakeup(), u0.updatedMillis() + 30);
+    auto idle = units.idleMillis();
+    EXPECT_LE(idle, 30U);
+    EXPECT_GE(idle, 25U);
+
+    // Not due, updated flag is cleared as the unit would do
+    units.update();
+    EXPECT_FALSE(u0.updated());
+    EXPECT_FALSE(u1.updated());
+    EXPECT_EQ(u0.count, 1U);
+
+    m5::utility::delay(idle);
+    units.update();
+    EXPECT_TRUE(u0.updated());
+    EXPECT_FALSE(u1.updated());
+    EXPECT_EQ(units.nextWakeup(), u1.updatedMillis() + 50);
+
+    // Unit that can not tell the next time
+    UnitMeasureDummy u2(0x12);
+    EXPECT_TRUE(units.add(u2, new MockI2C()));
+    EXPECT_TRUE(units.begin());
+    EXPECT_EQ(units.idleMillis(), 0U);
+}
+
+// 16 units on 2 buses: busy polling in order of registration vs sleeping until the next wakeup
+// Host: pio test -e test_native_mock -f embedded/test_schedule -v (prints the BENCH lines)
+TEST(Schedule, Benchmark)
+{
+    constexpr uint32_t DURATION{400};
+
+    struct result_t {
+        uint32_t calls{}, measurements{}, switches{};
+        double update_us{};
+    };
+    auto run = [](const bool scheduling) {
+        Fixture f(16);
+        f.manager.enableScheduling(scheduling);
+        result_t r{};
+        auto start_at = m5::utility::millis();
+        while (m5::utility::millis() - start_at < DURATION) {
+            auto t0 = std::chrono::steady_clock::now();
+            f.manager.update();
+            r.update_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+            ++r.calls;
+            if (scheduling) {
+                m5::utility::delay(f.manager.idleMillis());
+            }
+        }
+        r.measurements = f.measurements();
+        r.switches     = f.switches();
+        return r;
+    };
+
+    auto polled    = run(false);
+    auto scheduled = run(true);
+
+    const result_t* rs[] = {&polled, &scheduled};
+    for (auto&& r : rs) {
+        std::printf(
+            "[ BENCH    ] %-9s %6u update calls, %8.1f us total %.3f us/call, %u measurements, %.2f switches/measurement\n",
+            (r == &polled) ? "polled" : "scheduled", r->calls, r->update_us, r->update_us / r->calls, r->measurements,
+            (double)r->switches / r->measurements);
+    }
+
+    // Same data with a fraction of the update calls and bus switching
+    EXPECT_GE(scheduled.measurements, polled.measurements * 8 / 10);
+    EXPECT_LT(scheduled.calls * 10, polled.calls);
+    EXPECT_LT((double)scheduled.switches / scheduled.measurements, (double)polled.switches / polled.measurements);
+}
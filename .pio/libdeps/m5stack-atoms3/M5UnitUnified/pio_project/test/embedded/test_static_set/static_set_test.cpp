@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for StaticUnitSet
+*/
+#include <gtest/gtest.h>
+#include <M5UnitComponent.hpp>
+#include <M5UnitUnified.hpp>
+#include <M5Utility.hpp>
+#include "unit_dummy.hpp"
+#include "i2c_mock.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+using namespace m5::unit;
+
+namespace {
+// Counts heap allocations
+uint32_t allocations{};
+}  // namespace
+
+void* operator new(std::size_t sz)
+{
+    ++allocations;
+    if (void* p = std::malloc(sz ? sz : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+// Final types let the compiler see the whole update
+class UnitA final : public UnitPeriodicDummy {
+public:
+    using UnitPeriodicDummy::UnitPeriodicDummy;
+};
+class UnitB final : public UnitMeasureDummy {
+public:
+    using UnitMeasureDummy::UnitMeasureDummy;
+};
+
+}  // namespace
+
+TEST(StaticUnitSet, Basic)
+{
+    UnitA a{0x10, 30};
+    UnitB b{0x44, 0};
+    StaticUnitSet<UnitA, UnitB> units{a, b};
+    static_assert(decltype(units)::size() == 2, "size");
+    EXPECT_EQ(&units.get<0>(), &a);
+    EXPECT_EQ(&units.get<1>(), &b);
+
+    EXPECT_TRUE(a.assign(new MockI2C()));
+    EXPECT_TRUE(b.assign(new MockI2C()));
+    EXPECT_EQ(units.idleMillis(), 0U);  // Not begun
+    EXPECT_TRUE(units.begin());
+
+    m5::utility::delay(1);
+    units.update();
+    EXPECT_TRUE(a.updated());
+    EXPECT_EQ(a.count, 1U);
+    for (int i = 0; i < 100 && !b.count; ++i) {
+        units.update();
+    }
+    EXPECT_EQ(b.count, 1U);  // Asynchronous reading completed by polling
+
+    // Not due, updated flag is cleared
+    const auto cnt = a.count;
+    units.update();
+    EXPECT_FALSE(a.updated());
+    EXPECT_EQ(a.count, cnt);
+
+    // Same wakeup as UnitUnified
+    StaticUnitSet<UnitA> only_a{a};
+    EXPECT_EQ(only_a.nextWakeup(), a.updatedMillis() + 30);
+    m5::utility::delay(only_a.idleMillis());
+    only_a.update();
+    EXPECT_TRUE(a.updated());
+    units.update(true);
+    EXPECT_EQ(a.count, cnt + 2);
+}
+
+TEST(StaticUnitSet, Benchmark)
+{
+    constexpr uint32_t LOOP{200000};
+
+    UnitA a0{0x10, 1000}, a1{0x11, 1000};
+    UnitA s0{0x10, 1000}, s1{0x11, 1000};
+
+    auto before = allocations;
+    UnitUnified manager;
+    EXPECT_TRUE(manager.add(a0, new MockI2C()));
+    EXPECT_TRUE(manager.add(a1, new MockI2C()));
+    EXPECT_TRUE(manager.begin());
+    manager.update(true);
+    const uint32_t dynamic_alloc = allocations - before;
+
+    before = allocations;
+    StaticUnitSet<UnitA, UnitA> units{s0, s1};
+    EXPECT_TRUE(s0.assign(new MockI2C()));
+    EXPECT_TRUE(s1.assign(new MockI2C()));
+    EXPECT_TRUE(units.begin());
+    units.update(true);
+    const uint32_t static_alloc = allocations - before;
+    // Only the adapters (Impl and shared_ptr of each unit)
+    EXPECT_LT(static_alloc, dynamic_alloc);
+
+    auto bench = [](std::function<void()> f) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < LOOP; ++i) {
+            f();
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / LOOP;
+    };
+
+    // Not due: dispatch and bookkeeping only
+    const double dyn_idle = bench([&manager]() { manager.update(); });
+    const double sta_idle = bench([&units]() { units.update(); });
+    // Forced: each unit reads 2 bytes from the mock
+    const double dyn_force = bench([&manager]() { manager.update(true); });
+    const double sta_force = bench([&units]() { units.update(true); });
+
+    EXPECT_EQ(a0.count, s0.count);
+
+    printf("[ BENCH    ] 2 units, ns per update()   UnitUnified  StaticUnitSet\n");
+    printf("[ BENCH    ]   not due                   %8.1f       %8.1f\n", dyn_idle, sta_idle);
+    printf("[ BENCH    ]   forced (2 transfers)      %8.1f       %8.1f\n", dyn_force, sta_force);
+    printf("[ BENCH    ] heap allocations to set up  %8u       %8u\n", dynamic_alloc, static_alloc);
+    printf("[ BENCH    ] sizeof                      %8zu       %8zu\n", sizeof(UnitUnified), sizeof(units));
+}
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2024 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for M5UnitComponent
+*/
+#ifndef M5_UNIT_COMPONENT_TEST_I2C_MOCK_HPP
+#define M5_UNIT_COMPONENT_TEST_I2C_MOCK_HPP
+
+#include <M5UnitComponent.hpp>
+#include <M5Utility.hpp>
+#include <array>
+
+namespace m5 {
+namespace unit {
+// Shared by MockI2C on the same bus, counts transfers and switching
+struct MockBus {
+    uint32_t transfers{}, address_switches{}, clock_switches{};
+    uint8_t last_addr{};
+    uint32_t last_clock{};
+
+    void access(const uint8_t addr, const uint32_t clock)
+    {
+        if (transfers++) {
+            address_switches += (addr != last_addr);
+            clock_switches += (clock != last_clock);
+        }
+        last_addr  = addr;
+        last_clock = clock;
+    }
+};
+
+/*
+  Mock I2C device for UnitTest
+  - Writing a byte sets the register pointer, following bytes are stored from there
+  - Writing CMD_MEASURE starts a measurement, the device NACKs reading until it finishes
+  - latency > 0 emulates the transfer in the background (busy() for latency polls)
+  - fail > 0 makes the next transactions fail with fail_error, delay_us makes each one slower
+ */
+class MockI2C : public AdapterI2C::I2CImpl {
+public:
+    static constexpr uint8_t CMD_MEASURE{0xF0};
+
+    explicit MockI2C(const uint32_t measureMillis = 0, const uint32_t latency = 0, MockBus* bus = nullptr)
+        : AdapterI2C::I2CImpl(), _measure{measureMillis}, _latency{latency}, _bus{bus}
+    {
+    }
+
+    virtual AdapterI2C::I2CImpl* duplicate(const uint8_t addr) override
+    {
+        auto p = new MockI2C(_measure, _latency, _bus);
+        p->setAddress(addr);
+        return p;
+    }
+    virtual const void* busIdentifier() const override
+    {
+        return _bus ? (const void*)_bus : (const void*)this;
+    }
+
+    virtual m5::hal::error::error_t readWithTransaction(uint8_t* data, const size_t len) override
+    {
+        ++reads;
+        if (_bus) {
+            _bus->access(_addr, _clock);
+        }
+        auto e = inject();
+        if (!m5::hal::error::isOk(e)) {
+            return e;
+        }
+        if (_measuring && (long)(m5::utility::millis() - _ready_at) < 0) {
+            ++nacks;
+            return m5::hal::error::error_t::I2C_NO_ACK;
+        }
+        _measuring = false;
+        for (size_t i = 0; i < len; ++i) {
+            data[i] = regs[(uint8_t)(_pointer + i)];
+        }
+        return m5::hal::error::error_t::OK;
+    }
+    virtual m5::hal::error::error_t writeWithTransaction(const uint8_t* data, const size_t len,
+                                                         const uint32_t) override
+    {
+        ++writes;
+        if (_bus) {
+            _bus->access(_addr, _clock);
+        }
+        auto e = inject();
+        if (!m5::hal::error::isOk(e)) {
+            return e;
+        }
+        if (!data || !len) {
+            return m5::hal::error::error_t::OK;
+        }
+        _pointer = data[0];
+        if (_pointer == CMD_MEASURE) {
+            // Measured value is the number of measurements
+            ++measurements;
+            regs[CMD_MEASURE]     = measurements >> 8;
+            regs[CMD_MEASURE + 1] = measurements & 0xFF;
+            _measuring            = true;
+            _ready_at             = m5::utility::millis() + _measure;
+        }
+        for (size_t i = 1; i < len; ++i) {
+            regs[(uint8_t)(_pointer + i - 1)] = data[i];
+        }
+        return m5::hal::error::error_t::OK;
+    }
+    virtual m5::hal::error::error_t writeWithTransaction(const uint8_t reg, const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override
+    {
+        uint8_t buf[257]{reg};
+        std::copy(data, data + (data ? std::min<size_t>(len, 256) : 0), buf + 1);
+        return writeWithTransaction(buf, 1 + (data ? std::min<size_t>(len, 256) : 0), stop);
+    }
+
+    virtual m5::hal::error::error_t startWrite(const uint8_t* data, const size_t len) override
+    {
+        _remain = _latency;
+        return I2CImpl::startWrite(data, len);
+    }
+    virtual m5::hal::error::error_t startRead(uint8_t* data, const size_t len) override
+    {
+        _remain = _latency;
+        return I2CImpl::startRead(data, len);
+    }
+    virtual bool busy() const override
+    {
+        return _remain ? (--_remain, true) : false;
+    }
+
+    std::array<uint8_t, 256> regs{};
+    uint32_t reads{}, writes{}, nacks{};
+    uint16_t measurements{};
+    uint32_t fail{}, delay_us{};
+    m5::hal::error::error_t fail_error{m5::hal::error::error_t::TIMEOUT_ERROR};
+
+protected:
+    m5::hal::error::error_t inject()
+    {
+        if (delay_us) {
+            auto at = m5::utility::micros();
+            while (m5::utility::micros() - at < delay_us) {
+            }
+        }
+        return fail ? (--fail, fail_error) : m5::hal::error::error_t::OK;
+    }
+
+    uint32_t _measure{}, _latency{};
+    MockBus* _bus{};
+    mutable uint32_t _remain{};
+    uint8_t _pointer{};
+    bool _measuring{};
+    types::elapsed_time_t _ready_at{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
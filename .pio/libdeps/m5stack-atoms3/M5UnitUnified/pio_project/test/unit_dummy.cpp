@@ -18,5 +18,49 @@ const char UnitDummy::name[] = "UnitDummy";
 const m5::unit::types::uid_t UnitDummy::uid{"UnitDummy"_mmh3};
 const m5::unit::types::attr_t UnitDummy::attr{0};
 
+const char UnitMeasureDummy::name[] = "UnitMeasureDummy";
+const m5::unit::types::uid_t UnitMeasureDummy::uid{"UnitMeasureDummy"_mmh3};
+const m5::unit::types::attr_t UnitMeasureDummy::attr{m5::unit::types::attribute::AccessI2C};
+
+void UnitMeasureDummy::update(const bool force)
+{
+    _updated = _done;
+    _done    = false;
+    if (_requested || (!force && _latest && m5::utility::millis() - _latest < _interval)) {
+        return;
+    }
+    // Measurement command is 0xF0, result is ready after _measure ms
+    _requested = readRegisterAsync((uint8_t)0xF0, 2, _measure,
+                                   [this](const m5::hal::error::error_t err, const uint8_t* data, const size_t len) {
+                                       _requested = false;
+                                       error      = err;
+                                       if (data && len == 2) {
+                                           value   = (data[0] << 8) | data[1];
+                                           _latest = m5::utility::millis();
+                                           _done   = true;
+                                           ++count;
+                                       }
+                                   });
+}
+
+
+const char UnitPeriodicDummy::name[] = "UnitPeriodicDummy";
+const m5::unit::types::uid_t UnitPeriodicDummy::uid{"UnitPeriodicDummy"_mmh3};
+const m5::unit::types::attr_t UnitPeriodicDummy::attr{m5::unit::types::attribute::AccessI2C};
+
+void UnitPeriodicDummy::update(const bool force)
+{
+    _updated = false;
+    auto at  = m5::utility::millis();
+    if (force || !count || at >= _latest + _interval) {  // millis() starts at 0 on the host
+        uint8_t buf[2]{};
+        if (readRegister((uint8_t)0x00, buf, 2, 0)) {
+            _latest  = at;
+            _updated = true;
+            ++count;
+        }
+    }
+}
+
 }  // namespace unit
 }  // namespace m5
@@ -35,6 +35,62 @@ public:
     }
     uint32_t count{};
 };
+
+// DummyComponent that measures asynchronously (See also MockI2C)
+class UnitMeasureDummy : public m5::unit::Component {
+    M5_UNIT_COMPONENT_HPP_BUILDER(UnitMeasureDummy, 0x44);
+
+public:
+    explicit UnitMeasureDummy(const uint8_t addr = DEFAULT_ADDRESS, const uint32_t measureMillis = 20)
+        : Component(addr), _measure{measureMillis}
+    {
+    }
+    virtual ~UnitMeasureDummy()
+    {
+    }
+
+    virtual bool begin() override
+    {
+        _interval = _measure;
+        return true;
+    }
+    virtual void update(const bool force = false) override;
+
+    uint32_t count{};
+    uint16_t value{};
+    m5::hal::error::error_t error{m5::hal::error::error_t::OK};
+
+protected:
+    uint32_t _measure{};
+    bool _requested{}, _done{};
+};
+
+// DummyComponent in periodic measurement, reads the data when the interval has elapsed
+class UnitPeriodicDummy : public m5::unit::Component {
+    M5_UNIT_COMPONENT_HPP_BUILDER(UnitPeriodicDummy, 0x50);
+
+public:
+    explicit UnitPeriodicDummy(const uint8_t addr = DEFAULT_ADDRESS, const uint32_t interval = 100)
+        : Component(addr), _measure_interval{interval}
+    {
+    }
+    virtual ~UnitPeriodicDummy()
+    {
+    }
+
+    virtual bool begin() override
+    {
+        _periodic = true;
+        _interval = _measure_interval;
+        return true;
+    }
+    virtual void update(const bool force = false) override;
+
+    uint32_t count{};
+
+protected:
+    uint32_t _measure_interval{};
+};
 }  // namespace unit
 }  // namespace m5
 #endif
@@ -177,6 +177,18 @@ bool Component::assign(SPIClass& spi, const SPISettings& settings)
     return false;
 }
 
+bool Component::assign(AdapterI2C::I2CImpl* impl)
+{
+    std::unique_ptr<AdapterI2C::I2CImpl> ptr(impl);
+    if (canAccessI2C() && _addr && ptr) {
+        ptr->setAddress(_addr);
+        ptr->setClock(_component_cfg.clock);
+        _adapter = std::make_shared<AdapterI2C>(ptr.release());
+        return static_cast<bool>(_adapter);
+    }
+    return false;
+}
+
 bool Component::selectChannel(const uint8_t ch)
 {
     bool ret{true};
@@ -186,17 +198,41 @@ bool Component::selectChannel(const uint8_t ch)
     return ret && (select_channel(ch) == m5::hal::error::error_t::OK);
 }
 
+void Component::record_health(const m5::hal::error::error_t err, const unsigned long start_at)
+{
+    if (_adapter->type() == Adapter::Type::I2C) {
+        _health.record(err, (uint32_t)(m5::utility::micros() - start_at));
+    }
+}
+
+AdapterI2C::callback_t Component::health_callback(AdapterI2C::callback_t&& callback)
+{
+    // Latency includes the time in the queue
+    auto start_at = m5::utility::micros();
+    return [this, start_at, callback](const m5::hal::error::error_t err, const uint8_t* data, const size_t len) {
+        record_health(err, start_at);
+        if (callback) {
+            callback(err, data, len);
+        }
+    };
+}
+
 m5::hal::error::error_t Component::readWithTransaction(uint8_t* data, const size_t len)
 {
     selectChannel(channel());
-    auto r = adapter()->readWithTransaction(data, len);
+    auto start_at = m5::utility::micros();
+    auto r        = adapter()->readWithTransaction(data, len);
+    record_health(r, start_at);
     return r;
 }
 
 m5::hal::error::error_t Component::writeWithTransaction(const uint8_t* data, const size_t len, const uint32_t exparam)
 {
     selectChannel(channel());
-    return adapter()->writeWithTransaction(data, len, exparam);
+    auto start_at = m5::utility::micros();
+    auto ret      = adapter()->writeWithTransaction(data, len, exparam);
+    record_health(ret, start_at);
+    return ret;
 }
 
 template <typename Reg,
@@ -206,7 +242,17 @@ m5::hal::error::error_t Component::writeWithTransaction(const Reg reg, const uin
                                                         const bool stop)
 {
     selectChannel(channel());
-    return adapter()->writeWithTransaction(reg, data, len, stop);
+    auto start_at = m5::utility::micros();
+    auto ret      = adapter()->writeWithTransaction(reg, data, len, stop);
+    record_health(ret, start_at);
+    if (_register_cache) {
+        if (m5::hal::error::isOk(ret)) {
+            _register_cache->write(reg, data, len);
+        } else {
+            _register_cache->invalidate(reg, len);  // Unknown state
+        }
+    }
+    return ret;
 }
 
 template <typename Reg,
@@ -215,13 +261,23 @@ template <typename Reg,
 bool Component::readRegister(const Reg reg, uint8_t* rbuf, const size_t len, const uint32_t delayMillis,
                              const bool stop)
 {
+    if (_register_cache && _register_cache->read(reg, rbuf, len)) {
+        return true;
+    }
+
     if (!writeRegister(reg, nullptr, 0U, stop)) {
         M5_LIB_LOGE("Failed to write");
         return false;
     }
 
     m5::utility::delay(delayMillis);
-    return (readWithTransaction(rbuf, len) == m5::hal::error::error_t::OK);
+    if (readWithTransaction(rbuf, len) != m5::hal::error::error_t::OK) {
+        return false;
+    }
+    if (_register_cache) {
+        _register_cache->fill(reg, rbuf, len);
+    }
+    return true;
 }
 
 template <typename Reg,
@@ -302,6 +358,65 @@ bool Component::write_register32E(const Reg reg, const uint32_t value, const boo
     return writeRegister(reg, tmp, 4, stop);
 }
 
+template <typename Reg,
+          typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                  std::nullptr_t>::type>
+bool Component::readRegisterAsync(const Reg reg, const size_t len, const uint32_t delayMillis,
+                                  AdapterI2C::callback_t callback)
+{
+    auto ad = asAdapter<AdapterI2C>(Adapter::Type::I2C);
+    if (!ad || !len) {
+        return false;
+    }
+
+    // The channel must not be switched by other units while waiting
+    if (hasParent()) {
+        std::vector<uint8_t> rbuf(len);
+        auto ret = readRegister(reg, rbuf.data(), len, delayMillis)
+                       ? m5::hal::error::error_t::OK
+                       : m5::hal::error::error_t::I2C_BUS_ERROR;
+        if (callback) {
+            callback(ret, m5::hal::error::isOk(ret) ? rbuf.data() : nullptr, m5::hal::error::isOk(ret) ? len : 0U);
+        }
+        return true;
+    }
+
+    // Register in big-endian order
+    const uint8_t rr[2] = {(uint8_t)((reg >> 8) & 0xFF), (uint8_t)(reg & 0xFF)};
+    return ad->submit(rr + (2 - sizeof(Reg)), sizeof(Reg), len, delayMillis, health_callback(std::move(callback)));
+}
+
+template <typename Reg,
+          typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                  std::nullptr_t>::type>
+bool Component::writeRegisterAsync(const Reg reg, const uint8_t* buf, const size_t len,
+                                   AdapterI2C::callback_t callback)
+{
+    auto ad = asAdapter<AdapterI2C>(Adapter::Type::I2C);
+    if (!ad) {
+        return false;
+    }
+
+    if (hasParent()) {
+        auto ret = writeRegister(reg, buf, len) ? m5::hal::error::error_t::OK : m5::hal::error::error_t::I2C_BUS_ERROR;
+        if (callback) {
+            callback(ret, nullptr, 0U);
+        }
+        return true;
+    }
+
+    if (_register_cache) {
+        _register_cache->invalidate(reg, len);  // Not known until completed
+    }
+
+    const uint8_t rr[2] = {(uint8_t)((reg >> 8) & 0xFF), (uint8_t)(reg & 0xFF)};
+    std::vector<uint8_t> wbuf(rr + (2 - sizeof(Reg)), rr + 2);
+    if (buf && len) {
+        wbuf.insert(wbuf.end(), buf, buf + len);
+    }
+    return ad->submit(wbuf.data(), wbuf.size(), 0, 0, health_callback(std::move(callback)));
+}
+
 bool Component::generalCall(const uint8_t* data, const size_t len)
 {
     return adapter()->generalCall(data, len) == m5::hal::error::error_t::OK;
@@ -375,6 +490,9 @@ bool Component::changeAddress(const uint8_t addr)
             M5_LIB_LOGI("Change to address %x", addr);
             _addr = addr;
             ad->setAddress(addr);
+            if (_register_cache) {
+                _register_cache->invalidate();
+            }
             return true;
         }
     }
@@ -399,10 +517,22 @@ std::string Component::debugInfo() const
             tmp = m5::utility::formatString("%p:%u Type:%d", _adapter.get(), _adapter.use_count(), _adapter->type());
             break;
     }
+    if (_register_cache) {
+        tmp += m5::utility::formatString(" Cache:%u/%u/%u", _register_cache->hits(), _register_cache->misses(),
+                                         _register_cache->bypasses());
+    }
+    if (_health.transactions) {
+        tmp += " " + _health.toString();
+    }
     return m5::utility::formatString("[%s]:ID{0X%08x}:%s CH:%d parent:%u children:%zu/%u", deviceName(), identifier(),
                                      tmp.c_str(), channel(), hasParent(), childrenSize(), _component_cfg.max_children);
 }
 
+void Component::setRegisterCache(RegisterCache* cache)
+{
+    _register_cache.reset(cache);
+}
+
 // Explicit template instantiation
 template bool Component::readRegister<uint8_t>(const uint8_t, uint8_t*, const size_t, const uint32_t, const bool);
 template bool Component::readRegister<uint16_t>(const uint16_t, uint8_t*, const size_t, const uint32_t, const bool);
@@ -422,6 +552,15 @@ template bool Component::write_register16E<uint16_t>(const uint16_t, const uint1
 template bool Component::write_register32E<uint8_t>(const uint8_t, const uint32_t, const bool, const bool);
 template bool Component::write_register32E<uint16_t>(const uint16_t, const uint32_t, const bool, const bool);
 
+template bool Component::readRegisterAsync<uint8_t>(const uint8_t, const size_t, const uint32_t,
+                                                    AdapterI2C::callback_t);
+template bool Component::readRegisterAsync<uint16_t>(const uint16_t, const size_t, const uint32_t,
+                                                     AdapterI2C::callback_t);
+template bool Component::writeRegisterAsync<uint8_t>(const uint8_t, const uint8_t*, const size_t,
+                                                     AdapterI2C::callback_t);
+template bool Component::writeRegisterAsync<uint16_t>(const uint16_t, const uint8_t*, const size_t,
+                                                      AdapterI2C::callback_t);
+
 template m5::hal::error::error_t Component::writeWithTransaction<uint8_t>(const uint8_t reg, const uint8_t* data,
                                                                           const size_t len, const bool stop);
 template m5::hal::error::error_t Component::writeWithTransaction<uint16_t>(const uint16_t reg, const uint8_t* data,
@@ -12,6 +12,10 @@
 
 #include "m5_unit_component/types.hpp"
 #include "m5_unit_component/adapter.hpp"
+#include "m5_unit_component/register_cache.hpp"
+#include "m5_unit_component/register_block.hpp"
+#include "m5_unit_component/i2c_health.hpp"
+#include <m5_utility/container/circular_buffer.hpp>
 #include <cstdint>
 #include <vector>
 #include <algorithm>
@@ -28,6 +32,8 @@ namespace m5 {
 namespace unit {
 
 class UnitUnified;
+template <class... Units>
+class StaticUnitSet;
 class Adapter;
 
 /*!
@@ -232,6 +238,49 @@ public:
     virtual bool assign(HardwareSerial& serial);
     /*! @brief Assgin SPI */
     virtual bool assign(SPIClass& spi, const SPISettings& settings);
+    /*! @brief Assgin any I2C implementation (Ownership is transferred) */
+    virtual bool assign(AdapterI2C::I2CImpl* impl);
+    ///@}
+
+    ///@name Register cache
+    ///@{
+    /*!
+      @brief Set the register cache (opt-in)
+      @param cache Cache with the declared ranges (Ownership is transferred, nullptr disables)
+      @note Used by readRegister/writeRegister families, asynchronous reading is not cached
+     */
+    void setRegisterCache(RegisterCache* cache);
+    //! @brief Gets the register cache if exists
+    inline RegisterCache* registerCache()
+    {
+        return _register_cache.get();
+    }
+    //! @brief Gets the register cache if exists
+    inline const RegisterCache* registerCache() const
+    {
+        return _register_cache.get();
+    }
+    ///@}
+
+    ///@name Health
+    ///@{
+    //! @brief Counters and latency of I2C transactions of this unit
+    inline const i2c_health_t& health() const
+    {
+        return _health;
+    }
+    inline void resetHealth()
+    {
+        _health.clear();
+    }
+    /*!
+      @brief Count the data received but discarded by CRC mismatch
+      @note The bus layer does not check CRCs, only drivers that call this are counted
+     */
+    inline void reportCrcError()
+    {
+        ++_health.crc_errors;
+    }
     ///@}
 
     ///@note For daisy-chaining units such as hubs
@@ -352,6 +401,11 @@ public:
                                       std::nullptr_t>::type = nullptr>
     bool readRegister(const Reg reg, uint8_t* rbuf, const size_t len, const uint32_t delayMillis,
                       const bool stop = true);
+    template <typename Reg, size_t N>
+    inline bool readRegister(RegisterBlock<Reg, N>& block, const uint32_t delayMillis = 0, const bool stop = true)
+    {
+        return readRegister(block.reg(), block.data(), N, delayMillis, stop);
+    }
     template <typename Reg,
               typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
                                       std::nullptr_t>::type = nullptr>
@@ -439,6 +493,16 @@ public:
         return write_register32E(reg, value, stop, false);
     }
 
+    template <typename Reg,
+              typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                      std::nullptr_t>::type = nullptr>
+    bool readRegisterAsync(const Reg reg, const size_t len, const uint32_t delayMillis,
+                           AdapterI2C::callback_t callback);
+    template <typename Reg,
+              typename std::enable_if<std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                                      std::nullptr_t>::type = nullptr>
+    bool writeRegisterAsync(const Reg reg, const uint8_t* buf, const size_t len, AdapterI2C::callback_t callback);
+
     // GPIO
     bool pinModeRX(const gpio::Mode m);
     bool writeDigitalRX(const bool high);
@@ -466,6 +530,9 @@ public:
     template <typename Reg>
     bool readRegister(const Reg reg, uint8_t* rbuf, const size_t len, const uint32_t delayMillis,
                       const bool stop = true);
+    //! @brief Read the whole block in one transaction
+    template <typename Reg, size_t N>
+    bool readRegister(RegisterBlock<Reg, N>& block, const uint32_t delayMillis = 0, const bool stop = true);
     //! @brief Read byte with transaction from register
     template <typename Reg>
     bool readRegister8(const Reg reg, uint8_t& result, const uint32_t delayMillis, const bool stop = true);
@@ -507,6 +574,27 @@ public:
     template <typename Reg>
     bool writeRegister32LE(const Reg reg, const uint32_t value, const bool stop = true);
     ///@}
+
+    ///@note Completed by UnitUnified::update() or AdapterI2C::poll()
+    ///@note Units connected via a channel (PaHub etc.) are processed synchronously
+    ///@name Asynchronous Read/Write
+    ///@{
+    /*!
+      @brief Submit reading from register
+      @param reg Register
+      @param len Length of the data to be read
+      @param delayMillis Waiting time between writing register and reading (ms)
+      @param callback Called on completion
+      @return True if successful
+      @note The waiting time does not block, other units can be processed in the meantime
+     */
+    template <typename Reg>
+    bool readRegisterAsync(const Reg reg, const size_t len, const uint32_t delayMillis,
+                           AdapterI2C::callback_t callback);
+    //! @brief Submit writing to register
+    template <typename Reg>
+    bool writeRegisterAsync(const Reg reg, const uint8_t* buf, const size_t len, AdapterI2C::callback_t callback);
+    ///@}
 #endif
 
 protected:
@@ -569,8 +657,13 @@ protected:
     bool _updated{};
 
 private:
+    void record_health(const m5::hal::error::error_t err, const unsigned long start_at);
+    AdapterI2C::callback_t health_callback(AdapterI2C::callback_t&& callback);
+
     UnitUnified* _manager{};
     std::shared_ptr<m5::unit::Adapter> _adapter{};
+    std::unique_ptr<RegisterCache> _register_cache{};
+    i2c_health_t _health{};
 
     uint32_t _order{};
     component_config_t _component_cfg{};
@@ -585,6 +678,50 @@ private:
     Component* _child{};
 
     friend class UnitUnified;
+    template <class... Units>
+    friend class StaticUnitSet;
+};
+
+/*!
+  @struct PeriodicMeasurementView
+  @brief Stored periodic measurement data viewed in place
+  @details Up to 2 contiguous segments of the buffer, oldest first
+  @tparam MD Type of the measurement data group
+  @warning Invalidated by the next update of the unit
+  @note See also PeriodicMeasurementAdapter::view, commit
+*/
+template <typename MD>
+struct PeriodicMeasurementView {
+    using segment_type = typename m5::container::CircularBuffer<MD>::segment_type;
+
+    segment_type first{}, second{};
+
+    //! @brief Gets the number of data
+    inline size_t size() const
+    {
+        return first.size + second.size;
+    }
+    //! @brief Is empty?
+    inline bool empty() const
+    {
+        return size() == 0;
+    }
+    //! @brief Access specified data (0 is the oldest)
+    inline const MD& operator[](const size_t i) const
+    {
+        return (i < first.size) ? first[i] : second[i - first.size];
+    }
+    //! @brief Call the function for each data in order
+    template <typename F>
+    inline void for_each(F&& func) const
+    {
+        for (auto&& d : first) {
+            func(d);
+        }
+        for (auto&& d : second) {
+            func(d);
+        }
+    }
 };
 
 /*!
@@ -597,6 +734,7 @@ private:
   @warning MUST IMPLEMENT some functions (NOT VERTUAL)
   - MD Derived::oldest_periodic_data() const;
   - MD Derived::latestt_periodic_data() const;
+  - PeriodicMeasurementView<MD> Derived::periodic_data_view(const size_t) const;
   - bool Derived::start_periodic_measurement(any arguments);
   - bool Derived::stop_periodic_measurement():
   @warning  MUST ADD std::unique_ptr<m5::container::CircularBuffer<MD>> _data{}
@@ -667,6 +805,31 @@ public:
     {
         discard_periodic_measurement_data();
     }
+    //! @brief Discard the num oldest data accumulated
+    inline void discard(const size_t num)
+    {
+        discard_periodic_measurement_data(num);
+    }
+    /*!
+      @brief View the oldest stored data in place
+      @param num Max number of data
+      @return View of up to num data, oldest first
+      @note Process the view and then commit it, no data is copied
+      @code
+      auto v = unit.view();
+      v.for_each([](const MD& d) { ... });
+      unit.commit(v);
+      @endcode
+    */
+    inline PeriodicMeasurementView<MD> view(const size_t num = SIZE_MAX) const
+    {
+        return static_cast<const Derived*>(this)->periodic_data_view(num);
+    }
+    //! @brief Discard the data of the view as consumed
+    inline void commit(const PeriodicMeasurementView<MD>& v)
+    {
+        discard_periodic_measurement_data(v.size());
+    }
     //! @brief Discard all data
     inline void flush()
     {
@@ -684,6 +847,13 @@ protected:
     virtual void discard_periodic_measurement_data()           = 0;
     virtual void flush_periodic_measurement_data()             = 0;
     ///@}
+    //! @brief Discard the num oldest data (Derived can override to discard at once)
+    virtual void discard_periodic_measurement_data(size_t num)
+    {
+        while (num-- && !empty_periodic_measurement_data()) {
+            discard_periodic_measurement_data();
+        }
+    }
 };
 
 }  // namespace unit
@@ -733,6 +903,11 @@ protected:                                                                     \
     {                                                                          \
         return !_data->empty() ? _data->back().value() : md{};                 \
     }                                                                          \
+    inline PeriodicMeasurementView<md> periodic_data_view(size_t n) const      \
+    {                                                                          \
+        auto seg = _data->segments(n);                                         \
+        return PeriodicMeasurementView<md>{seg.first, seg.second};             \
+    }                                                                          \
     inline virtual size_t available_periodic_measurement_data() const override \
     {                                                                          \
         return _data->size();                                                  \
@@ -749,6 +924,10 @@ protected:                                                                     \
     {                                                                          \
         _data->pop_front();                                                    \
     }                                                                          \
+    inline virtual void discard_periodic_measurement_data(size_t n) override   \
+    {                                                                          \
+        _data->pop_front(n);                                                   \
+    }                                                                          \
     inline virtual void flush_periodic_measurement_data() override             \
     {                                                                          \
         _data->clear();                                                        \
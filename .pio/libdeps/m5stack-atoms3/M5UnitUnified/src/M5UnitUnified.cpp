@@ -9,6 +9,8 @@
 */
 #include "M5UnitUnified.hpp"
 #include <M5Utility.hpp>
+#include <algorithm>
+#include <tuple>
 
 namespace m5 {
 namespace unit {
@@ -38,6 +40,30 @@ bool UnitUnified::add(Component& u, m5::hal::bus::Bus* bus)
     return false;
 }
 
+bool UnitUnified::add(Component& u, AdapterI2C::I2CImpl* impl)
+{
+    if (u.isRegistered()) {
+        M5_LIB_LOGW("Already added");
+        delete impl;
+        return false;
+    }
+    if (!impl) {
+        M5_LIB_LOGE("Impl null");
+        return false;
+    }
+
+    M5_LIB_LOGD("Add [%s] addr:%02x children:%zu", u.deviceName(), u.address(), u.childrenSize());
+
+    u._manager = this;
+    if (u.assign(impl)) {
+        u._order = ++_registerCount;
+        _units.emplace_back(&u);
+        return add_children(u);
+    }
+    M5_LIB_LOGE("Failed to assign %s:%u", u.deviceName(), u.canAccessI2C());
+    return false;
+}
+
 bool UnitUnified::add(Component& u, TwoWire& wire)
 {
     if (u.isRegistered()) {
@@ -142,6 +168,21 @@ bool UnitUnified::add_children(Component& u)
 
 bool UnitUnified::begin()
 {
+    if (_attach_policy.enabled) {
+        // Try all units, the absent ones are attached later
+        bool ret{true};
+        for (auto&& c : _units) {
+            M5_LIB_LOGV("Try begin:%s", c->deviceName());
+            c->_begun = c->begin();
+            if (!c->_begun) {
+                M5_LIB_LOGW("Not attached yet: %s", c->debugInfo().c_str());
+                ret = false;
+            }
+        }
+        _scan_at = m5::utility::millis();
+        return ret;
+    }
+
     return !std::any_of(_units.begin(), _units.end(), [](Component* c) {
         M5_LIB_LOGV("Try begin:%s", c->deviceName());
         bool ret = c->_begun = c->begin();
@@ -154,12 +195,349 @@ bool UnitUnified::begin()
 
 void UnitUnified::update(const bool force)
 {
-    // Order of registration
+    // Deliver completions before each unit checks its data
+    poll();
+
+    if (!_scheduling) {
+        // Order of registration
+        for (auto&& u : _units) {
+            if (!u->_component_cfg.self_update && u->_begun) {
+                u->update(force);
+            }
+        }
+    } else {
+        if (_schedule.size() != _units.size()) {
+            make_schedule();
+        }
+        const auto now = m5::utility::millis();
+        for (auto&& u : _schedule) {
+            if (u->_component_cfg.self_update || !u->_begun) {
+                continue;
+            }
+            if (force || (long)(now - due_time(u, now)) >= 0) {
+                u->update(force);
+            } else {
+                // Same as the unit would do if called before the interval
+                u->_updated = false;
+            }
+        }
+    }
+
+    // Start the transactions submitted in update
+    poll();
+
+    if (_clock_policy.enabled) {
+        adapt_clock();
+    }
+    // After the attached units, so that scanning does not delay them
+    if (_attach_policy.enabled) {
+        detach_lost();
+        scan();
+    }
+}
+
+// Group by bus, then by clock and address to minimise switching.
+// Children follow the parent grouped by channel
+void UnitUnified::make_schedule()
+{
+    struct key_t {
+        const void* bus;
+        uint32_t clock;
+        uint8_t addr;
+        int16_t channel;
+        uint32_t order;
+    };
+    auto make_key = [](const Component* u) {
+        auto root = u;
+        while (root->_parent) {
+            root = root->_parent;
+        }
+        key_t k{root->_adapter.get(), 0, root->address(), u->_parent ? u->channel() : (int16_t)-1, u->order()};
+        auto ad = root->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        if (ad) {
+            k.bus   = bus_identifier(root);
+            k.clock = ad->clock();
+        }
+        return k;
+    };
+
+    std::vector<std::pair<key_t, Component*>> tmp{};
+    tmp.reserve(_units.size());
     for (auto&& u : _units) {
+        tmp.emplace_back(make_key(u), u);
+    }
+    std::sort(tmp.begin(), tmp.end(), [](const std::pair<key_t, Component*>& a, const std::pair<key_t, Component*>& b) {
+        return std::make_tuple((uintptr_t)a.first.bus, a.first.clock, a.first.addr, a.first.channel, a.first.order) <
+               std::make_tuple((uintptr_t)b.first.bus, b.first.clock, b.first.addr, b.first.channel, b.first.order);
+    });
+
+    _schedule.clear();
+    for (auto&& t : tmp) {
+        _schedule.push_back(t.second);
+    }
+}
+
+types::elapsed_time_t UnitUnified::due_time(const Component* u, const types::elapsed_time_t now)
+{
+    // Only periodic measurement units can tell when the next data comes
+    if (!u->inPeriodic() || !u->interval() || !u->updatedMillis()) {
+        return now;
+    }
+    return u->updatedMillis() + u->interval();
+}
+
+types::elapsed_time_t UnitUnified::nextWakeup() const
+{
+    const auto now = m5::utility::millis();
+    bool found{};
+    types::elapsed_time_t next{};
+    auto earlier = [&found, &next, &now](const types::elapsed_time_t t) {
+        if (!found || (long)(t - next) < 0) {
+            next  = ((long)(t - now) < 0) ? now : t;
+            found = true;
+        }
+    };
+
+    for (auto&& u : _units) {
+        auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        if (ad && ad->pending()) {
+            earlier(ad->nextPollMillis());
+        }
         if (!u->_component_cfg.self_update && u->_begun) {
-            u->update(force);
+            earlier(due_time(u, now));
+        }
+    }
+    if (_attach_policy.enabled && detachedSize()) {
+        earlier(_scan_at + _attach_policy.scan_interval);
+    }
+    return found ? next : now;
+}
+
+uint32_t UnitUnified::idleMillis() const
+{
+    const auto next = nextWakeup();
+    const auto now  = m5::utility::millis();
+    return ((long)(next - now) > 0) ? next - now : 0U;
+}
+
+size_t UnitUnified::poll()
+{
+    size_t cnt{};
+    std::vector<const Adapter*> polled{};
+    for (auto&& u : _units) {
+        // Adapter may be shared with the parent unit, poll it only once
+        auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        if (ad && ad->pending() && std::find(polled.begin(), polled.end(), ad) == polled.end()) {
+            polled.push_back(ad);
+            cnt += ad->poll();
         }
     }
+    return cnt;
+}
+
+const void* UnitUnified::bus_identifier(const Component* u)
+{
+    while (u->_parent) {
+        u = u->_parent;
+    }
+    auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+    return ad ? ad->impl()->busIdentifier() : nullptr;
+}
+
+void UnitUnified::setClockPolicy(const clock_policy_t& policy)
+{
+    _clock_policy = policy;
+    _bus_states.clear();
+    _clock_window_at = m5::utility::millis() - policy.window;  // Evaluate on the next update
+    // Restore the clock of each unit, the policy starts from there
+    for (auto&& u : _units) {
+        auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        if (ad && !u->hasParent()) {
+            ad->setClock(u->_component_cfg.clock);
+        }
+    }
+    _schedule.clear();
+}
+
+void UnitUnified::adapt_clock()
+{
+    const auto now = m5::utility::millis();
+    // All buses share the window, so nothing is due before it elapses.
+    // Checked first since busHealth() allocates and merges histograms
+    if (now - _clock_window_at < _clock_policy.window) {
+        return;
+    }
+    _clock_window_at = now;
+    bool changed{};
+
+    for (auto&& bh : busHealth()) {
+        auto it = std::find_if(_bus_states.begin(), _bus_states.end(),
+                               [&bh](const bus_state_t& bs) { return bs.bus == bh.bus; });
+        const uint32_t errors = bh.health.errors() - (_clock_policy.nack_is_error ? 0 : bh.health.nacks);
+        if (it == _bus_states.end()) {
+            _bus_states.emplace_back(bus_state_t{bh.bus, bh.clock, errors, now, now});
+            continue;
+        }
+        if (now - it->window_at < _clock_policy.window) {
+            continue;
+        }
+
+        // Maximum is the fastest clock of the units on the bus
+        uint32_t max_clock{};
+        for (auto&& u : _units) {
+            if (!u->hasParent() && u->asAdapter<AdapterI2C>(Adapter::Type::I2C) && bus_identifier(u) == it->bus) {
+                max_clock = std::max(max_clock, u->_component_cfg.clock);
+            }
+        }
+
+        // Counters may have been reset by the unit
+        const uint32_t delta = (errors >= it->errors) ? errors - it->errors : errors;
+        auto limit           = it->limit;
+        if (delta >= _clock_policy.error_threshold) {
+            limit = std::max(it->limit / 2, std::min(_clock_policy.min_clock, max_clock));
+        } else if (!delta && it->limit < max_clock && now - it->changed_at >= _clock_policy.probe_interval) {
+            limit = std::min(it->limit * 2, max_clock);
+        }
+        if (limit != it->limit) {
+            M5_LIB_LOGW("Bus %p clock %u -> %u (errors:%u)", it->bus, it->limit, limit, delta);
+            it->limit      = limit;
+            it->changed_at = now;
+            for (auto&& u : _units) {
+                auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+                if (ad && !u->hasParent() && bus_identifier(u) == it->bus) {
+                    ad->setClock(std::min(u->_component_cfg.clock, limit));
+                }
+            }
+            changed = true;
+        }
+        it->errors    = errors;
+        it->window_at = now;
+    }
+
+    if (changed) {
+        _schedule.clear();  // Clock is a part of the order
+    }
+}
+
+size_t UnitUnified::detachedSize() const
+{
+    return std::count_if(_units.begin(), _units.end(), [](const Component* u) { return !u->_begun; });
+}
+
+void UnitUnified::detach_lost()
+{
+    if (!_attach_policy.lost_threshold) {
+        return;
+    }
+    // Not ready devices also NACK, so failures must last for a while
+    const auto now = m5::utility::millis();
+    for (auto&& u : _units) {
+        if (u->_begun && u->_health.consecutive >= _attach_policy.lost_threshold &&
+            now - u->_health.succeeded_at >= _attach_policy.lost_millis) {
+            M5_LIB_LOGW("Lost: %s", u->debugInfo().c_str());
+            u->_begun   = false;
+            u->_updated = false;
+        }
+    }
+}
+
+// Address-only write, the device acknowledges if present
+bool UnitUnified::probe(Component* u)
+{
+    auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+    if (!ad) {
+        return true;  // Only begin() can tell
+    }
+    if (ad->pending()) {
+        return false;  // Shared adapter is busy, try next time
+    }
+    u->selectChannel(u->channel());
+    return m5::hal::error::isOk(ad->writeWithTransaction((const uint8_t*)nullptr, 0, 1));
+}
+
+void UnitUnified::scan()
+{
+    const auto now = m5::utility::millis();
+    if (_units.empty() || now - _scan_at < _attach_policy.scan_interval) {
+        return;
+    }
+    _scan_at = now;
+
+    // One detached unit per interval in turn
+    for (size_t i = 0; i < _units.size(); ++i) {
+        auto u = _units[(_scan_index + i) % _units.size()];
+        if (u->_begun || (u->_parent && !u->_parent->_begun)) {
+            continue;
+        }
+        _scan_index = (_scan_index + i + 1) % _units.size();
+        if (probe(u)) {
+            u->_health.consecutive = 0;
+            u->_begun              = u->begin();
+            if (u->_begun) {
+                M5_LIB_LOGI("Attached: %s", u->debugInfo().c_str());
+            } else {
+                M5_LIB_LOGW("Failed to begin: %s", u->debugInfo().c_str());
+            }
+        }
+        return;
+    }
+}
+
+std::vector<UnitUnified::bus_health_t> UnitUnified::busHealth() const
+{
+    std::vector<bus_health_t> v{};
+    for (auto&& u : _units) {
+        auto bus = bus_identifier(u);
+        if (!bus) {
+            continue;
+        }
+        auto it = std::find_if(v.begin(), v.end(), [&bus](const bus_health_t& bh) { return bh.bus == bus; });
+        if (it == v.end()) {
+            v.emplace_back(bus_health_t{});
+            it      = v.end() - 1;
+            it->bus = bus;
+        }
+        auto ad = u->asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        if (ad && !u->hasParent()) {
+            it->clock = std::max(it->clock, ad->clock());
+        }
+        ++it->units;
+        it->health.merge(u->health());
+    }
+    return v;
+}
+
+std::string UnitUnified::healthJSON() const
+{
+    std::string s{"["};
+    for (auto&& bh : busHealth()) {
+        if (s.size() > 1) {
+            s += ',';
+        }
+        s += m5::utility::formatString("{\"bus\":\"%p\",\"clock\":%u,\"health\":%s,\"units\":[", bh.bus, bh.clock,
+                                       bh.health.toJSON().c_str());
+        bool first{true};
+        for (auto&& u : _units) {
+            if (bus_identifier(u) != bh.bus) {
+                continue;
+            }
+            s += m5::utility::formatString("%s{\"name\":\"%s\",\"addr\":%u,\"health\":%s}", first ? "" : ",",
+                                           u->deviceName(), u->address(), u->health().toJSON().c_str());
+            first = false;
+        }
+        s += "]}";
+    }
+    return s += ']';
+}
+
+void UnitUnified::resetHealth()
+{
+    for (auto&& u : _units) {
+        u->resetHealth();
+    }
+    for (auto&& bs : _bus_states) {
+        bs.errors = 0;
+    }
 }
 
 std::string UnitUnified::debugInfo() const
@@ -170,6 +548,10 @@ std::string UnitUnified::debugInfo() const
             s += make_unit_info(u, 0);
         }
     }
+    for (auto&& bh : busHealth()) {
+        s += m5::utility::formatString("Bus:%p %uHz units:%zu %s\n", bh.bus, bh.clock, bh.units,
+                                       bh.health.toString().c_str());
+    }
     return m5::utility::trim(s);
 }
 
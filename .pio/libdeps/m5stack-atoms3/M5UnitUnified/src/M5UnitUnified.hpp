@@ -17,6 +17,7 @@
 #define M5_UNIT_UNIFIED_HPP
 
 #include "M5UnitComponent.hpp"
+#include "m5_unit_component/static_unit_set.hpp"
 #include <M5HAL.hpp>
 #if defined(M5_UNIT_UNIFIED_USING_RMT_V2)
 #else
@@ -104,12 +105,151 @@ public:
       @return True if successful
      */
     bool add(Component& u, m5::hal::bus::Bus* bus);
+    /*!
+      @brief Adding unit to be managed (Any I2C implementation)
+      @param u Unit Component
+      @param impl Implementation to be used (Ownership is transferred)
+      @return True if successful
+      @note For example AdapterI2C::MasterImpl or the mock for testing
+     */
+    bool add(Component& u, AdapterI2C::I2CImpl* impl);
     ///@}
 
-    //! @brief Begin of all units under management
+    /*!
+      @brief Begin of all units under management
+      @return True if all units have begun
+      @note If late attachment is enabled, all units are tried and
+      those that failed are attached later by update()
+     */
     bool begin();
-    //! @brief Update of all units under management
+    /*!
+      @brief Update of all units under management
+      @param force Forced communication for updates if true
+      @note Asynchronous transactions are also progressed
+      @note If scheduling is enabled, units are updated in bus order and
+      periodic measurement units whose interval has not elapsed are skipped
+     */
     void update(const bool force = false);
+    /*!
+      @brief Progress asynchronous transactions of all units
+      @return Number of the pending transactions
+      @note Calling it between update() shortens the latency of completion
+     */
+    size_t poll();
+
+    ///@name Scheduling
+    ///@{
+    //! @brief Is scheduling of update enabled? (default as true)
+    inline bool isScheduling() const
+    {
+        return _scheduling;
+    }
+    /*!
+      @brief Enable/disable scheduling of update
+      @note Disabled, update() calls all units in order of registration
+     */
+    inline void enableScheduling(const bool enable)
+    {
+        _scheduling = enable;
+    }
+    /*!
+      @brief Time when update() should be called next
+      @return millis() based time
+      @note Earliest of the periodic measurement and pending transactions,
+      now if any unit can not tell (e.g. not in periodic measurement)
+     */
+    types::elapsed_time_t nextWakeup() const;
+    /*!
+      @brief Time the caller can sleep before calling update()
+      @return Sleeping time (ms)
+    */
+    uint32_t idleMillis() const;
+    ///@}
+
+    ///@name Late attachment
+    ///@{
+    /*!
+      @struct attach_policy_t
+      @brief Attaching units that are absent at begin() or lost later
+      @details update() probes one detached unit per scan interval with an address-only write
+      after updating the attached units, and calls its begin() when it acknowledges.
+      A unit whose transactions keep failing (both the count and the time since the last success)
+      is detached and scanned again
+      @note begin() of the appearing unit is called synchronously in update()
+     */
+    struct attach_policy_t {
+        bool enabled{false};          //!< Attach late?
+        uint32_t scan_interval{500};  //!< Interval between probes (ms)
+        uint32_t lost_threshold{8};   //!< Consecutive failed transactions to detach (0: never)
+        uint32_t lost_millis{3000};   //!< Time without success to detach (ms)
+    };
+
+    //! @brief Gets the attach policy
+    inline const attach_policy_t& attachPolicy() const
+    {
+        return _attach_policy;
+    }
+    //! @brief Set the attach policy
+    inline void setAttachPolicy(const attach_policy_t& policy)
+    {
+        _attach_policy = policy;
+    }
+    //! @brief Is the unit attached? (begun and not lost)
+    inline bool isAttached(const Component& u) const
+    {
+        return u._begun;
+    }
+    //! @brief Number of the detached units
+    size_t detachedSize() const;
+    ///@}
+
+    ///@name Health
+    ///@{
+    /*!
+      @struct clock_policy_t
+      @brief Adaptive clock of I2C buses
+      @details Evaluated in update() every window. The clock of the bus is halved if errors
+      reached the threshold in the window, and doubled (up to the clock of each unit) if no error
+      occurred for the probe interval since the last change
+     */
+    struct clock_policy_t {
+        bool enabled{false};             //!< Adapt the clock?
+        uint32_t min_clock{100000};      //!< Lower limit
+        uint32_t window{1000};           //!< Evaluation window (ms)
+        uint32_t error_threshold{3};     //!< Errors in the window to step down
+        uint32_t probe_interval{30000};  //!< Healthy time to step up (ms)
+        bool nack_is_error{true};        //!< Count NACK as error? (false if devices may be absent)
+    };
+    /*!
+      @struct bus_health_t
+      @brief Health of the bus
+     */
+    struct bus_health_t {
+        const void* bus{};      //!< Bus identifier
+        uint32_t clock{};       //!< Current clock
+        size_t units{};         //!< Number of units on the bus
+        i2c_health_t health{};  //!< Sum of the units
+    };
+
+    //! @brief Gets the clock policy
+    inline const clock_policy_t& clockPolicy() const
+    {
+        return _clock_policy;
+    }
+    //! @brief Set the clock policy
+    void setClockPolicy(const clock_policy_t& policy);
+    //! @brief Gets the health of each I2C bus
+    std::vector<bus_health_t> busHealth() const;
+    /*!
+      @brief Health of buses and units in JSON
+      @code
+      [{"bus":"0x3fc9b2a0","clock":400000,"health":{...},"units":[{"name":"UnitSHT30","addr":68,"health":{...}}]}]
+      @endcode
+     */
+    std::string healthJSON() const;
+    //! @brief Reset the health of all units
+    void resetHealth();
+    ///@}
 
     //! @brief Output information for debug
     std::string debugInfo() const;
@@ -117,9 +257,34 @@ public:
 protected:
     bool add_children(Component& u);
     std::string make_unit_info(const Component* u, const uint8_t indent = 0) const;
+    void make_schedule();
+    static types::elapsed_time_t due_time(const Component* u, const types::elapsed_time_t now);
+    static const void* bus_identifier(const Component* u);
+    void adapt_clock();
+    void detach_lost();
+    void scan();
+    bool probe(Component* u);
 
 protected:
     container_type _units{};
+    container_type _schedule{};  // Units in bus order
+    bool _scheduling{true};
+
+    // For adaptive clock
+    struct bus_state_t {
+        const void* bus;
+        uint32_t limit;
+        uint32_t errors;  // At the beginning of the window
+        types::elapsed_time_t window_at, changed_at;
+    };
+    clock_policy_t _clock_policy{};
+    std::vector<bus_state_t> _bus_states{};
+    types::elapsed_time_t _clock_window_at{};  // Last evaluation of all buses
+
+    // For late attachment
+    attach_policy_t _attach_policy{};
+    types::elapsed_time_t _scan_at{};
+    size_t _scan_index{};
 
 private:
     static uint32_t _registerCount;
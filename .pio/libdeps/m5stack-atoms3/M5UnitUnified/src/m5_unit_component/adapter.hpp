@@ -13,6 +13,7 @@
 
 #include "adapter_base.hpp"
 #include "adapter_i2c.hpp"
+#include "adapter_i2c_trace.hpp"
 #include "identify_functions.hpp"
 #if defined(M5_UNIT_UNIFIED_USING_RMT_V2)
 #include "adapter_gpio_v2.hpp"
@@ -318,6 +318,221 @@ m5::hal::error::error_t AdapterI2C::BusImpl::write_with_transaction(const m5::ha
     return m5::hal::error::error_t::INVALID_ARGUMENT;
 }
 
+#if defined(M5_UNIT_UNIFIED_USING_I2C_MASTER)
+// Impl for ESP-IDF I2C master driver
+namespace {
+constexpr int xfer_timeout_ms{100};
+
+m5::hal::error::error_t esp_to_error(const esp_err_t err)
+{
+    switch (err) {
+        case ESP_OK:
+            return m5::hal::error::error_t::OK;
+        case ESP_ERR_TIMEOUT:
+            return m5::hal::error::error_t::TIMEOUT_ERROR;
+        case ESP_ERR_INVALID_ARG:
+            return m5::hal::error::error_t::INVALID_ARGUMENT;
+        case ESP_ERR_NOT_FOUND:
+            return m5::hal::error::error_t::I2C_NO_ACK;
+        default:
+            return m5::hal::error::error_t::I2C_BUS_ERROR;
+    }
+}
+}  // namespace
+
+AdapterI2C::MasterImpl::MasterImpl(i2c_master_bus_handle_t bus, const uint8_t addr, const uint32_t clock,
+                                   const bool async)
+    : AdapterI2C::I2CImpl(addr, clock), _bus(bus), _async(async)
+{
+}
+
+AdapterI2C::MasterImpl::~MasterImpl()
+{
+    remove_device();
+}
+
+void AdapterI2C::MasterImpl::setAddress(const uint8_t addr)
+{
+    remove_device();
+    I2CImpl::setAddress(addr);
+}
+
+void AdapterI2C::MasterImpl::setClock(const uint32_t clock)
+{
+    if (clock != _clock) {
+        remove_device();
+    }
+    I2CImpl::setClock(clock);
+}
+
+AdapterI2C::I2CImpl* AdapterI2C::MasterImpl::duplicate(const uint8_t addr)
+{
+    return new MasterImpl(_bus, addr, _clock, _async);
+}
+
+bool AdapterI2C::MasterImpl::ensure_device()
+{
+    if (_dev) {
+        return true;
+    }
+    if (!_bus || !_addr) {
+        return false;
+    }
+
+    i2c_device_config_t dcfg{};
+    dcfg.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+    dcfg.device_address  = _addr;
+    dcfg.scl_speed_hz    = _clock;
+    auto err             = i2c_master_bus_add_device(_bus, &dcfg, &_dev);
+    if (err != ESP_OK) {
+        M5_LIB_LOGE("Failed to add device %02X:%d", _addr, err);
+        _dev = nullptr;
+        return false;
+    }
+    if (_async) {
+        i2c_master_event_callbacks_t cbs{};
+        cbs.on_trans_done = on_trans_done;
+        err               = i2c_master_register_event_callbacks(_dev, &cbs, this);
+        if (err != ESP_OK) {
+            M5_LIB_LOGW("Failed to register callbacks, using synchronous transfer %d", err);
+            _async = false;
+        }
+    }
+    return true;
+}
+
+void AdapterI2C::MasterImpl::remove_device()
+{
+    if (_dev) {
+        wait_done();
+        i2c_master_bus_rm_device(_dev);
+        _dev = nullptr;
+    }
+}
+
+// Called from ISR
+bool AdapterI2C::MasterImpl::on_trans_done(i2c_master_dev_handle_t, const i2c_master_event_data_t* edata, void* arg)
+{
+    auto self = static_cast<MasterImpl*>(arg);
+    switch (edata->event) {
+        case I2C_EVENT_DONE:
+            self->_result = m5::hal::error::error_t::OK;
+            break;
+        case I2C_EVENT_NACK:
+            self->_result = m5::hal::error::error_t::I2C_NO_ACK;
+            break;
+        default:
+            self->_result = m5::hal::error::error_t::I2C_BUS_ERROR;
+            break;
+    }
+    self->_busy = false;
+    return false;
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::wait_done()
+{
+    if (_busy) {
+        auto err = i2c_master_bus_wait_all_done(_bus, xfer_timeout_ms);
+        if (err != ESP_OK) {
+            M5_LIB_LOGE("Transfer not completed %d", err);
+            _busy   = false;
+            _result = esp_to_error(err);
+        }
+    }
+    return _result;
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::startWrite(const uint8_t* data, const size_t len)
+{
+    wait_done();
+    if (!ensure_device()) {
+        return _result = m5::hal::error::error_t::I2C_BUS_ERROR;
+    }
+    // Set before the transfer because the completion may be notified before returning
+    _result = _async ? m5::hal::error::error_t::ASYNC_RUNNING : m5::hal::error::error_t::OK;
+    _busy   = _async;
+    auto err = i2c_master_transmit(_dev, data, len, xfer_timeout_ms);
+    if (err != ESP_OK) {
+        _busy   = false;
+        _result = esp_to_error(err);
+    }
+    return _result;
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::startRead(uint8_t* data, const size_t len)
+{
+    wait_done();
+    if (!ensure_device()) {
+        return _result = m5::hal::error::error_t::I2C_BUS_ERROR;
+    }
+    _result  = _async ? m5::hal::error::error_t::ASYNC_RUNNING : m5::hal::error::error_t::OK;
+    _busy    = _async;
+    auto err = i2c_master_receive(_dev, data, len, xfer_timeout_ms);
+    if (err != ESP_OK) {
+        _busy   = false;
+        _result = esp_to_error(err);
+    }
+    return _result;
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::write_bytes(const uint8_t* data, const size_t len)
+{
+    if (!data || !len) {
+        return wakeup();
+    }
+    startWrite(data, len);
+    return wait_done();
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::readWithTransaction(uint8_t* data, const size_t len)
+{
+    if (!data) {
+        return m5::hal::error::error_t::INVALID_ARGUMENT;
+    }
+    startRead(data, len);
+    return wait_done();
+}
+
+// The driver always issues the stop condition
+m5::hal::error::error_t AdapterI2C::MasterImpl::writeWithTransaction(const uint8_t* data, const size_t len,
+                                                                     const uint32_t)
+{
+    wait_done();
+    _wbuf.assign(data, data + (data ? len : 0));
+    return write_bytes(_wbuf.data(), _wbuf.size());
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::writeWithTransaction(const uint8_t reg, const uint8_t* data,
+                                                                     const size_t len, const uint32_t)
+{
+    wait_done();
+    _wbuf.assign(1, reg);
+    if (data && len) {
+        _wbuf.insert(_wbuf.end(), data, data + len);
+    }
+    return write_bytes(_wbuf.data(), _wbuf.size());
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::writeWithTransaction(const uint16_t reg, const uint8_t* data,
+                                                                     const size_t len, const uint32_t)
+{
+    wait_done();
+    m5::types::big_uint16_t r(reg);
+    _wbuf.assign(r.data(), r.data() + r.size());
+    if (data && len) {
+        _wbuf.insert(_wbuf.end(), data, data + len);
+    }
+    return write_bytes(_wbuf.data(), _wbuf.size());
+}
+
+m5::hal::error::error_t AdapterI2C::MasterImpl::wakeup()
+{
+    wait_done();
+    return _bus ? esp_to_error(i2c_master_probe(_bus, _addr, xfer_timeout_ms))
+                : m5::hal::error::error_t::INVALID_ARGUMENT;
+}
+#endif
+
 // Adapter
 #if defined(ARDUINO)
 AdapterI2C::AdapterI2C(TwoWire& wire, const uint8_t addr, const uint32_t clock)
@@ -344,6 +559,11 @@ AdapterI2C::AdapterI2C(m5::hal::bus::Bus* bus, const uint8_t addr, const uint32_
     assert(_impl);
 }
 
+AdapterI2C::AdapterI2C(I2CImpl* impl) : Adapter(Adapter::Type::I2C, impl)
+{
+    assert(_impl);
+}
+
 Adapter* AdapterI2C::duplicate(const uint8_t addr)
 {
     auto ptr = new AdapterI2C();
@@ -358,6 +578,105 @@ Adapter* AdapterI2C::duplicate(const uint8_t addr)
     return nullptr;
 }
 
+bool AdapterI2C::submit(const uint8_t* wdata, const size_t wlen, const size_t rlen, const uint32_t waitMillis,
+                        callback_t callback)
+{
+    if ((!wdata || !wlen) && !rlen) {
+        return false;
+    }
+    if (_transactions.size() >= MAX_PENDING_TRANSACTIONS) {
+        M5_LIB_LOGW("Too many pending transactions");
+        return false;
+    }
+
+    transaction_t t{};
+    if (wdata && wlen) {
+        t.wbuf.assign(wdata, wdata + wlen);
+    }
+    t.rbuf.resize(rlen);
+    t.wait     = waitMillis;
+    t.callback = std::move(callback);
+    _transactions.emplace_back(std::move(t));
+    return true;
+}
+
+size_t AdapterI2C::poll()
+{
+    while (!_transactions.empty()) {
+        if (!step(_transactions.front())) {
+            break;  // In progress
+        }
+        // The callback may submit the next transaction
+        auto t = std::move(_transactions.front());
+        _transactions.pop_front();
+        if (t.callback) {
+            const bool ok = m5::hal::error::isOk(t.result);
+            t.callback(t.result, (ok && !t.rbuf.empty()) ? t.rbuf.data() : nullptr, ok ? t.rbuf.size() : 0U);
+        }
+    }
+    return _transactions.size();
+}
+
+types::elapsed_time_t AdapterI2C::nextPollMillis() const
+{
+    return (!_transactions.empty() && _transactions.front().state == transaction_t::State::Wait)
+               ? _transactions.front().due
+               : m5::utility::millis();
+}
+
+// Returns true if completed
+bool AdapterI2C::step(transaction_t& t)
+{
+    using State = transaction_t::State;
+    auto ip     = impl();
+
+    if (t.state == State::Write) {
+        if (!t.wbuf.empty()) {
+            t.result = ip->startWrite(t.wbuf.data(), t.wbuf.size());
+            if (m5::hal::error::isError(t.result)) {
+                return true;
+            }
+        }
+        t.state = State::Writing;
+    }
+    if (t.state == State::Writing) {
+        if (!t.wbuf.empty()) {
+            if (ip->busy()) {
+                return false;
+            }
+            t.result = ip->result();
+            if (m5::hal::error::isError(t.result)) {
+                return true;
+            }
+        }
+        t.due   = m5::utility::millis() + t.wait;
+        t.state = State::Wait;
+    }
+    if (t.state == State::Wait) {
+        if ((long)(m5::utility::millis() - t.due) < 0) {
+            return false;
+        }
+        t.state = State::Read;
+    }
+    if (t.state == State::Read) {
+        if (t.rbuf.empty()) {
+            t.result = m5::hal::error::error_t::OK;
+            return true;
+        }
+        t.result = ip->startRead(t.rbuf.data(), t.rbuf.size());
+        if (m5::hal::error::isError(t.result)) {
+            return true;
+        }
+        t.state = State::Reading;
+    }
+    // Reading
+    if (ip->busy()) {
+        return false;
+    }
+    t.result = ip->result();
+    return true;
+}
+
 bool AdapterI2C::pushPin()
 {
 #if defined(ARDUINO)
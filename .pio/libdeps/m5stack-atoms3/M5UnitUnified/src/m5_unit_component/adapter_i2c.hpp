@@ -12,6 +12,14 @@
 
 #include "adapter_base.hpp"
 #include "pin.hpp"
+#include "identify_functions.hpp"
+#include <functional>
+#include <deque>
+#include <vector>
+#if defined(M5_UNIT_UNIFIED_USING_I2C_MASTER)
+#include <driver/i2c_master.h>
+#include <atomic>
+#endif
 
 class TwoWire;
 
@@ -37,7 +45,7 @@ public:
         {
             return _addr;
         }
-        inline void setAddress(const uint8_t addr)
+        inline virtual void setAddress(const uint8_t addr)
         {
             _addr = addr;
         }
@@ -90,10 +98,41 @@ public:
         {
             return nullptr;
         }
+        //! @brief Identifier of the physical bus (same value for devices on the same bus)
+        virtual const void* busIdentifier() const
+        {
+            return this;
+        }
+
+        ///@note By default, the transfer is done synchronously inside start functions
+        ///@name Asynchronous transfer
+        ///@{
+        //! @brief Start writing data with stop condition
+        virtual m5::hal::error::error_t startWrite(const uint8_t* data, const size_t len)
+        {
+            return _async_result = writeWithTransaction(data, len, 1U);
+        }
+        //! @brief Start reading data
+        virtual m5::hal::error::error_t startRead(uint8_t* data, const size_t len)
+        {
+            return _async_result = readWithTransaction(data, len);
+        }
+        //! @brief Is the started transfer in progress?
+        virtual bool busy() const
+        {
+            return false;
+        }
+        //! @brief Gets the result of the last started transfer (valid if not busy)
+        virtual m5::hal::error::error_t result() const
+        {
+            return _async_result;
+        }
+        ///@}
 
     protected:
         uint8_t _addr{};
         uint32_t _clock{100 * 1000U};
+        m5::hal::error::error_t _async_result{m5::hal::error::error_t::OK};
     };
 
     //
@@ -105,6 +144,10 @@ public:
         {
             return _wire;
         }
+        inline virtual const void* busIdentifier() const override
+        {
+            return _wire;
+        }
         inline virtual int16_t scl() const override
         {
             return _scl;
@@ -143,6 +186,10 @@ public:
         {
             return _bus;
         }
+        inline virtual const void* busIdentifier() const override
+        {
+            return _bus;
+        }
 
         inline virtual void setClock(const uint32_t clock) override
         {
@@ -170,6 +217,79 @@ public:
         m5::hal::bus::I2CMasterAccessConfig _access_cfg{};
     };
 
+#if defined(M5_UNIT_UNIFIED_USING_I2C_MASTER)
+    /*!
+      @class MasterImpl
+      @brief Impl for the ESP-IDF I2C master driver
+      @note Transfers run in the background if the bus was created with trans_queue_depth > 0
+      @warning Do not use the same port through TwoWire at the same time
+     */
+    class MasterImpl : public I2CImpl {
+    public:
+        /*!
+          @param bus Bus handle
+          @param addr I2C address
+          @param clock Clock
+          @param async Does the bus handle the transfer in the background? (trans_queue_depth > 0)
+         */
+        MasterImpl(i2c_master_bus_handle_t bus, const uint8_t addr, const uint32_t clock, const bool async = true);
+        virtual ~MasterImpl();
+
+        inline virtual const void* busIdentifier() const override
+        {
+            return _bus;
+        }
+        virtual void setAddress(const uint8_t addr) override;
+        virtual void setClock(const uint32_t clock) override;
+        virtual I2CImpl* duplicate(const uint8_t addr) override;
+        virtual m5::hal::error::error_t readWithTransaction(uint8_t* data, const size_t len) override;
+        virtual m5::hal::error::error_t writeWithTransaction(const uint8_t* data, const size_t len,
+                                                             const uint32_t stop) override;
+        virtual m5::hal::error::error_t writeWithTransaction(const uint8_t reg, const uint8_t* data, const size_t len,
+                                                             const uint32_t stop) override;
+        virtual m5::hal::error::error_t writeWithTransaction(const uint16_t reg, const uint8_t* data, const size_t len,
+                                                             const uint32_t stop) override;
+        virtual m5::hal::error::error_t wakeup() override;
+
+        virtual m5::hal::error::error_t startWrite(const uint8_t* data, const size_t len) override;
+        virtual m5::hal::error::error_t startRead(uint8_t* data, const size_t len) override;
+        virtual bool busy() const override
+        {
+            return _busy;
+        }
+        virtual m5::hal::error::error_t result() const override
+        {
+            return _result;
+        }
+
+    protected:
+        bool ensure_device();
+        void remove_device();
+        m5::hal::error::error_t wait_done();
+        m5::hal::error::error_t write_bytes(const uint8_t* data, const size_t len);
+        static bool on_trans_done(i2c_master_dev_handle_t dev, const i2c_master_event_data_t* edata, void* arg);
+
+    private:
+        i2c_master_bus_handle_t _bus{};
+        i2c_master_dev_handle_t _dev{};
+        bool _async{};
+        std::atomic<bool> _busy{};
+        std::atomic<m5::hal::error::error_t> _result{m5::hal::error::error_t::OK};
+        std::vector<uint8_t> _wbuf{};  // Must be alive until the transfer is done
+    };
+#endif
+
+    /*!
+      @brief Callback on completion of the asynchronous transaction
+      @param err Result
+      @param data Read data (nullptr if no reading or failed)
+      @param len Length of the read data
+     */
+    using callback_t = std::function<void(const m5::hal::error::error_t err, const uint8_t* data, const size_t len)>;
+
+    //! @brief Maximum number of pending transactions per adapter
+    static constexpr size_t MAX_PENDING_TRANSACTIONS{16};
+
 #if defined(ARDUINO)
     AdapterI2C(TwoWire& wire, uint8_t addr, const uint32_t clock);
 #endif
@@ -177,6 +297,8 @@ public:
     AdapterI2C(m5::hal::bus::Bus& bus, const uint8_t addr, const uint32_t clock) : AdapterI2C(&bus, addr, clock)
     {
     }
+    //! @brief Using any implementation (Ownership is transferred)
+    explicit AdapterI2C(I2CImpl* impl);
 
     inline I2CImpl* impl()
     {
@@ -217,6 +339,45 @@ public:
 
     virtual Adapter* duplicate(const uint8_t addr) override;
 
+    ///@note Transactions are executed in order of submission by poll()
+    ///@name Asynchronous transaction
+    ///@{
+    /*!
+      @brief Submit the transaction that writes, waits and then reads
+      @param wdata Data to be written (copied, nullptr if no writing)
+      @param wlen Length of the data to be written
+      @param rlen Length of the data to be read (0 if no reading)
+      @param waitMillis Waiting time between writing and reading (ms)
+      @param callback Called on completion from poll()
+      @return True if successful
+     */
+    bool submit(const uint8_t* wdata, const size_t wlen, const size_t rlen, const uint32_t waitMillis,
+                callback_t callback);
+    //! @brief Submit the writing transaction
+    inline bool submitWrite(const uint8_t* data, const size_t len, callback_t callback)
+    {
+        return submit(data, len, 0, 0, std::move(callback));
+    }
+    //! @brief Submit the reading transaction
+    inline bool submitRead(const size_t len, callback_t callback)
+    {
+        return submit(nullptr, 0, len, 0, std::move(callback));
+    }
+    /*!
+      @brief Progress the pending transactions
+      @return Number of the pending transactions
+      @note Callbacks are called from here
+     */
+    size_t poll();
+    //! @brief Gets the number of the pending transactions
+    inline size_t pending() const
+    {
+        return _transactions.size();
+    }
+    //! @brief Gets the time to poll next (millis() based, now if in transfer)
+    types::elapsed_time_t nextPollMillis() const;
+    ///@}
+
     /// @warning Functionality required for a specific unit
     /// @warning Will be improved when integrated with M5HAL
     /// @name Temporary API
@@ -238,8 +399,22 @@ protected:
     {
     }
 
+protected:
+    struct transaction_t {
+        enum class State : uint8_t { Write, Writing, Wait, Read, Reading };
+        std::vector<uint8_t> wbuf{};
+        std::vector<uint8_t> rbuf{};
+        uint32_t wait{};
+        types::elapsed_time_t due{};
+        State state{};
+        m5::hal::error::error_t result{m5::hal::error::error_t::OK};
+        callback_t callback{};
+    };
+    bool step(transaction_t& t);
+
 protected:
     gpio::pin_backup_t _backupSCL{-1}, _backupSDA{-1};
+    std::deque<transaction_t> _transactions{};
 };
 
 }  // namespace unit
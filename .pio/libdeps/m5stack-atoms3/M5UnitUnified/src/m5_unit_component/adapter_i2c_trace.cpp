@@ -0,0 +1,371 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file adapter_i2c_trace.cpp
+  @brief Recording and replaying I2C transactions
+*/
+#include "adapter_i2c_trace.hpp"
+#include <M5Utility.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+int hex_value(const char c)
+{
+    return (c >= '0' && c <= '9') ? c - '0'
+           : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+           : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                    : -1;
+}
+
+void spin_us(const uint32_t us)
+{
+    auto start_at = m5::utility::micros();
+    while (m5::utility::micros() - start_at < us) {
+        // Busy-wait; sleeping is too coarse for bytes on the bus
+    }
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+
+// ---------------------------------------------------------------------------
+// I2CTrace
+I2CTrace::I2CTrace(const size_t maxEntries) : _max{maxEntries}, _origin{m5::utility::micros()}
+{
+}
+
+void I2CTrace::clear()
+{
+    _entries.clear();
+    _dropped = 0;
+    _origin  = m5::utility::micros();
+}
+
+void I2CTrace::add(i2c_trace_entry_t&& e)
+{
+    if (full()) {
+        ++_dropped;
+        return;
+    }
+    _entries.emplace_back(std::move(e));
+}
+
+const char* I2CTrace::textHeader()
+{
+    return "# at_us addr op stop result duration_us data\n";
+}
+
+std::string I2CTrace::toString(const i2c_trace_entry_t& e)
+{
+    static constexpr char hex[] = "0123456789ABCDEF";
+    std::string s = m5::utility::formatString("%u %02X %c %u %d %u ", e.at, e.addr,
+                                              e.op == i2c_trace_entry_t::Op::Write ? 'W' : 'R', e.stop,
+                                              (int)e.result, e.duration);
+    s.reserve(s.size() + e.data.size() * 2 + 1);
+    for (auto&& b : e.data) {
+        s += hex[b >> 4];
+        s += hex[b & 0x0F];
+    }
+    s += '\n';
+    return s;
+}
+
+std::string I2CTrace::toString() const
+{
+    std::string s{textHeader()};
+    for (auto&& e : _entries) {
+        s += toString(e);
+    }
+    return s;
+}
+
+bool I2CTrace::fromString(const char* str)
+{
+    _entries.clear();
+    _dropped = 0;
+    if (!str) {
+        return false;
+    }
+
+    while (*str) {
+        const char* eol = std::strchr(str, '\n');
+        std::string line(str, eol ? eol - str : std::strlen(str));
+        str = eol ? eol + 1 : str + line.size();
+
+        if (line.empty() || line[0] == '#' || line[0] == '\r') {
+            continue;
+        }
+        unsigned at{}, addr{}, stop{}, duration{};
+        int result{};
+        char op{};
+        int consumed{};
+        if (std::sscanf(line.c_str(), "%u %x %c %u %d %u %n", &at, &addr, &op, &stop, &result, &duration,
+                        &consumed) != 6 ||
+            (op != 'W' && op != 'R')) {
+            M5_LIB_LOGE("Invalid line:%s", line.c_str());
+            _entries.clear();
+            return false;
+        }
+
+        i2c_trace_entry_t e{};
+        e.at       = at;
+        e.addr     = addr;
+        e.op       = (op == 'W') ? i2c_trace_entry_t::Op::Write : i2c_trace_entry_t::Op::Read;
+        e.stop     = stop;
+        e.result   = static_cast<m5::hal::error::error_t>(result);
+        e.duration = duration;
+        const char* p = line.c_str() + consumed;
+        while (hex_value(p[0]) >= 0 && hex_value(p[1]) >= 0) {
+            e.data.push_back((hex_value(p[0]) << 4) | hex_value(p[1]));
+            p += 2;
+        }
+        _entries.emplace_back(std::move(e));
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// I2CRecordImpl
+I2CRecordImpl::I2CRecordImpl(AdapterI2C::I2CImpl* impl, std::shared_ptr<I2CTrace> trace)
+    : AdapterI2C::I2CImpl(impl ? impl->address() : 0, impl ? impl->clock() : 100 * 1000U),
+      _impl(impl),
+      _trace(trace)
+{
+    assert(_impl && _trace);
+}
+
+void I2CRecordImpl::setAddress(const uint8_t addr)
+{
+    I2CImpl::setAddress(addr);
+    _impl->setAddress(addr);
+}
+
+void I2CRecordImpl::setClock(const uint32_t clock)
+{
+    I2CImpl::setClock(clock);
+    _impl->setClock(clock);
+}
+
+AdapterI2C::I2CImpl* I2CRecordImpl::duplicate(const uint8_t addr)
+{
+    auto dup = _impl->duplicate(addr);
+    return dup ? new I2CRecordImpl(dup, _trace) : nullptr;
+}
+
+void I2CRecordImpl::record(const uint8_t addr, const i2c_trace_entry_t::Op op, const bool stop,
+                           const unsigned long start_at, const m5::hal::error::error_t result, const uint8_t* data,
+                           const size_t len)
+{
+    i2c_trace_entry_t e{};
+    e.at       = start_at - _trace->origin();
+    e.duration = m5::utility::micros() - start_at;
+    e.addr     = addr;
+    e.op       = op;
+    e.stop     = stop;
+    e.result   = result;
+    if (data && len) {
+        e.data.assign(data, data + len);
+    }
+    _trace->add(std::move(e));
+}
+
+m5::hal::error::error_t I2CRecordImpl::readWithTransaction(uint8_t* data, const size_t len)
+{
+    auto start_at = m5::utility::micros();
+    auto ret      = _impl->readWithTransaction(data, len);
+    record(_addr, i2c_trace_entry_t::Op::Read, true, start_at, ret, m5::hal::error::isOk(ret) ? data : nullptr,
+           len);
+    return ret;
+}
+
+m5::hal::error::error_t I2CRecordImpl::write_with_record(const uint8_t* prefix, const size_t plen,
+                                                         const uint8_t* data, const size_t len, const uint32_t stop)
+{
+    std::vector<uint8_t> buf(prefix, prefix + plen);
+    if (data && len) {
+        buf.insert(buf.end(), data, data + len);
+    }
+    auto start_at = m5::utility::micros();
+    m5::hal::error::error_t ret{};
+    switch (plen) {
+        case 1:
+            ret = _impl->writeWithTransaction(prefix[0], data, len, stop);
+            break;
+        case 2:
+            ret = _impl->writeWithTransaction((uint16_t)((prefix[0] << 8) | prefix[1]), data, len, stop);
+            break;
+        default:
+            ret = _impl->writeWithTransaction(data, len, stop);
+            break;
+    }
+    record(_addr, i2c_trace_entry_t::Op::Write, stop, start_at, ret, buf.data(), buf.size());
+    return ret;
+}
+
+m5::hal::error::error_t I2CRecordImpl::writeWithTransaction(const uint8_t* data, const size_t len,
+                                                            const uint32_t stop)
+{
+    return write_with_record(nullptr, 0, data, len, stop);
+}
+
+m5::hal::error::error_t I2CRecordImpl::writeWithTransaction(const uint8_t reg, const uint8_t* data, const size_t len,
+                                                            const uint32_t stop)
+{
+    return write_with_record(&reg, 1, data, len, stop);
+}
+
+m5::hal::error::error_t I2CRecordImpl::writeWithTransaction(const uint16_t reg, const uint8_t* data,
+                                                            const size_t len, const uint32_t stop)
+{
+    const uint8_t r[2] = {(uint8_t)(reg >> 8), (uint8_t)(reg & 0xFF)};
+    return write_with_record(r, 2, data, len, stop);
+}
+
+m5::hal::error::error_t I2CRecordImpl::generalCall(const uint8_t* data, const size_t len)
+{
+    auto start_at = m5::utility::micros();
+    auto ret      = _impl->generalCall(data, len);
+    record(0x00, i2c_trace_entry_t::Op::Write, true, start_at, ret, data, len);
+    return ret;
+}
+
+m5::hal::error::error_t I2CRecordImpl::wakeup()
+{
+    auto start_at = m5::utility::micros();
+    auto ret      = _impl->wakeup();
+    record(_addr, i2c_trace_entry_t::Op::Write, true, start_at, ret, nullptr, 0);
+    return ret;
+}
+
+// ---------------------------------------------------------------------------
+// I2CReplayImpl
+I2CReplayImpl::I2CReplayImpl(std::shared_ptr<const I2CTrace> trace, const Timing timing, const bool loop)
+    : AdapterI2C::I2CImpl(), _trace(trace), _timing(timing), _loop(loop)
+{
+    assert(_trace);
+}
+
+AdapterI2C::I2CImpl* I2CReplayImpl::duplicate(const uint8_t addr)
+{
+    auto p = new I2CReplayImpl(_trace, _timing, _loop);
+    p->setAddress(addr);
+    p->setClock(_clock);
+    return p;
+}
+
+bool I2CReplayImpl::finished() const
+{
+    auto& v = _trace->entries();
+    return std::none_of(v.begin() + std::min(_cursor, v.size()), v.end(),
+                        [this](const i2c_trace_entry_t& e) { return e.addr == _addr; });
+}
+
+const i2c_trace_entry_t* I2CReplayImpl::next(const i2c_trace_entry_t::Op op)
+{
+    auto& v = _trace->entries();
+    for (uint_fast8_t pass = 0; pass < 2; ++pass) {
+        while (_cursor < v.size()) {
+            auto& e = v[_cursor++];
+            if (e.addr == _addr) {
+                if (e.op != op) {
+                    ++_mismatches;
+                    return nullptr;
+                }
+                ++_replayed;
+                return &e;
+            }
+        }
+        if (!_loop) {
+            break;
+        }
+        _cursor = 0;
+    }
+    ++_mismatches;  // Exhausted
+    return nullptr;
+}
+
+void I2CReplayImpl::spend(const i2c_trace_entry_t& e, const size_t len)
+{
+    uint32_t us{};
+    switch (_timing) {
+        case Timing::Recorded:
+            us = e.duration;
+            break;
+        case Timing::Clock:
+            // Address and data bytes are 9 bits each, plus start and stop
+            us = (uint32_t)(((1 + len) * 9 + 2) * 1000000ULL / (_clock ? _clock : 100000U));
+            break;
+        default:
+            return;
+    }
+    _bus_us += us;
+    spin_us(us);
+}
+
+m5::hal::error::error_t I2CReplayImpl::readWithTransaction(uint8_t* data, const size_t len)
+{
+    auto e = next(i2c_trace_entry_t::Op::Read);
+    if (!e || !data) {
+        return m5::hal::error::error_t::UNKNOWN_ERROR;
+    }
+    if (m5::hal::error::isOk(e->result)) {
+        if (e->data.size() != len) {
+            ++_mismatches;
+        }
+        std::memset(data, 0, len);
+        std::memcpy(data, e->data.data(), std::min(len, e->data.size()));
+    }
+    spend(*e, len);
+    return e->result;
+}
+
+m5::hal::error::error_t I2CReplayImpl::replay_write(const uint8_t* prefix, const size_t plen, const uint8_t* data,
+                                                    const size_t len)
+{
+    auto e = next(i2c_trace_entry_t::Op::Write);
+    if (!e) {
+        return m5::hal::error::error_t::UNKNOWN_ERROR;
+    }
+    const size_t dlen = (data ? len : 0);
+    if (e->data.size() != plen + dlen || (plen && std::memcmp(e->data.data(), prefix, plen)) ||
+        (dlen && std::memcmp(e->data.data() + plen, data, dlen))) {
+        ++_mismatches;
+    }
+    spend(*e, plen + dlen);
+    return e->result;
+}
+
+m5::hal::error::error_t I2CReplayImpl::writeWithTransaction(const uint8_t* data, const size_t len, const uint32_t)
+{
+    return replay_write(nullptr, 0, data, len);
+}
+
+m5::hal::error::error_t I2CReplayImpl::writeWithTransaction(const uint8_t reg, const uint8_t* data, const size_t len,
+                                                            const uint32_t)
+{
+    return replay_write(&reg, 1, data, len);
+}
+
+m5::hal::error::error_t I2CReplayImpl::writeWithTransaction(const uint16_t reg, const uint8_t* data,
+                                                            const size_t len, const uint32_t)
+{
+    const uint8_t r[2] = {(uint8_t)(reg >> 8), (uint8_t)(reg & 0xFF)};
+    return replay_write(r, 2, data, len);
+}
+
+m5::hal::error::error_t I2CReplayImpl::wakeup()
+{
+    return replay_write(nullptr, 0, nullptr, 0);
+}
+
+}  // namespace unit
+}  // namespace m5
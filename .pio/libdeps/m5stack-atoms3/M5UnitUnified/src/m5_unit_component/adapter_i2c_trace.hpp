@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file adapter_i2c_trace.hpp
+  @brief Recording and replaying I2C transactions
+  @details Record the traffic of real devices on target, replay it in-process (e.g. on Linux)
+  to test and benchmark units without hardware
+*/
+#ifndef M5_UNIT_COMPONENT_ADAPTER_I2C_TRACE_HPP
+#define M5_UNIT_COMPONENT_ADAPTER_I2C_TRACE_HPP
+
+#include "adapter_i2c.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @struct i2c_trace_entry_t
+  @brief One I2C transaction
+ */
+struct i2c_trace_entry_t {
+    enum class Op : uint8_t { Write, Read };
+    uint32_t at{};        //!< Start time since recording began (us)
+    uint32_t duration{};  //!< Time taken (us)
+    uint8_t addr{};       //!< I2C address (0x00 for general call)
+    Op op{};              //!< Operation
+    bool stop{true};      //!< Stop condition issued?
+    m5::hal::error::error_t result{m5::hal::error::error_t::OK};
+    std::vector<uint8_t> data{};  //!< Written bytes (register included) or read bytes
+};
+
+/*!
+  @class I2CTrace
+  @brief Recorded I2C transactions
+  @details Text form, one transaction per line
+  @code
+  # at_us addr op stop result duration_us data
+  1234 44 W 1 0 120 E000
+  1400 44 R 1 0 310 6E1A2B5F3C9D
+  @endcode
+ */
+class I2CTrace {
+public:
+    explicit I2CTrace(const size_t maxEntries = 1024);
+
+    inline const std::vector<i2c_trace_entry_t>& entries() const
+    {
+        return _entries;
+    }
+    inline size_t size() const
+    {
+        return _entries.size();
+    }
+    inline bool empty() const
+    {
+        return _entries.empty();
+    }
+    inline bool full() const
+    {
+        return _entries.size() >= _max;
+    }
+    //! @brief Number of transactions not recorded because it was full
+    inline uint32_t dropped() const
+    {
+        return _dropped;
+    }
+    //! @brief Base time of the recording (m5::utility::micros, reset by clear)
+    inline unsigned long origin() const
+    {
+        return _origin;
+    }
+
+    void clear();
+    //! @brief Add the entry (ignored if full)
+    void add(i2c_trace_entry_t&& e);
+
+    //! @brief Gets the text form
+    std::string toString() const;
+    //! @brief Comment line that starts the text form
+    static const char* textHeader();
+    /*!
+      @brief Gets one line of the text form, newline included
+      @note To write out a large trace without building it in one string
+    */
+    static std::string toString(const i2c_trace_entry_t& e);
+    /*!
+      @brief Set entries from the text form
+      @return True if successful
+      @note Lines beginning with '#' and empty lines are ignored
+    */
+    bool fromString(const char* str);
+
+private:
+    std::vector<i2c_trace_entry_t> _entries{};
+    size_t _max{};
+    uint32_t _dropped{};
+    unsigned long _origin{};
+};
+
+/*!
+  @class I2CRecordImpl
+  @brief Recording implementation that wraps the real one
+  @details All accesses are forwarded and recorded into the trace
+  @note Asynchronous transfer of the wrapped implementation is done synchronously while recording
+ */
+class I2CRecordImpl : public AdapterI2C::I2CImpl {
+public:
+    /*!
+      @param impl Implementation to be wrapped (Ownership is transferred)
+      @param trace Trace to record (can be shared by units on the same bus)
+     */
+    I2CRecordImpl(AdapterI2C::I2CImpl* impl, std::shared_ptr<I2CTrace> trace);
+
+    inline std::shared_ptr<I2CTrace> trace() const
+    {
+        return _trace;
+    }
+
+    virtual void setAddress(const uint8_t addr) override;
+    virtual void setClock(const uint32_t clock) override;
+    virtual int16_t scl() const override
+    {
+        return _impl->scl();
+    }
+    virtual int16_t sda() const override
+    {
+        return _impl->sda();
+    }
+    virtual bool begin() override
+    {
+        return _impl->begin();
+    }
+    virtual bool end() override
+    {
+        return _impl->end();
+    }
+    virtual TwoWire* getWire() override
+    {
+        return _impl->getWire();
+    }
+    virtual m5::hal::bus::Bus* getBus() override
+    {
+        return _impl->getBus();
+    }
+    virtual const void* busIdentifier() const override
+    {
+        return _impl->busIdentifier();
+    }
+
+    virtual AdapterI2C::I2CImpl* duplicate(const uint8_t addr) override;
+    virtual m5::hal::error::error_t readWithTransaction(uint8_t* data, const size_t len) override;
+    virtual m5::hal::error::error_t writeWithTransaction(const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override;
+    virtual m5::hal::error::error_t writeWithTransaction(const uint8_t reg, const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override;
+    virtual m5::hal::error::error_t writeWithTransaction(const uint16_t reg, const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override;
+    virtual m5::hal::error::error_t generalCall(const uint8_t* data, const size_t len) override;
+    virtual m5::hal::error::error_t wakeup() override;
+
+protected:
+    void record(const uint8_t addr, const i2c_trace_entry_t::Op op, const bool stop, const unsigned long start_at,
+                const m5::hal::error::error_t result, const uint8_t* data, const size_t len);
+    m5::hal::error::error_t write_with_record(const uint8_t* prefix, const size_t plen, const uint8_t* data,
+                                              const size_t len, const uint32_t stop);
+
+private:
+    std::unique_ptr<AdapterI2C::I2CImpl> _impl{};
+    std::shared_ptr<I2CTrace> _trace{};
+};
+
+/*!
+  @class I2CReplayImpl
+  @brief Implementation that replays the recorded transactions of its address
+  @details Each access takes the next entry of the same address in order.
+  Written bytes are compared with the recording and read bytes come from the recording.
+ */
+class I2CReplayImpl : public AdapterI2C::I2CImpl {
+public:
+    //! @brief Time taken by each transaction
+    enum class Timing : uint8_t {
+        None,      //!< As fast as possible
+        Recorded,  //!< Duration of the recording
+        Clock,     //!< 9 bits per byte plus start/stop at the clock
+    };
+
+    /*!
+      @param trace Trace to be replayed (can be shared by units)
+      @param timing Timing emulation
+      @param loop Restart from the beginning when the trace is exhausted
+     */
+    explicit I2CReplayImpl(std::shared_ptr<const I2CTrace> trace, const Timing timing = Timing::Clock,
+                           const bool loop = false);
+
+    //! @brief Number of accesses that did not match the recording
+    inline uint32_t mismatches() const
+    {
+        return _mismatches;
+    }
+    //! @brief Number of transactions served from the recording
+    inline uint32_t replayed() const
+    {
+        return _replayed;
+    }
+    //! @brief Bus time emulated so far (us, 0 for Timing::None)
+    inline uint64_t busTime() const
+    {
+        return _bus_us;
+    }
+    //! @brief Has all entries of the address been replayed?
+    bool finished() const;
+    //! @brief Restart from the beginning
+    inline void rewind()
+    {
+        _cursor = 0;
+    }
+
+    virtual const void* busIdentifier() const override
+    {
+        return _trace.get();
+    }
+    virtual AdapterI2C::I2CImpl* duplicate(const uint8_t addr) override;
+    virtual m5::hal::error::error_t readWithTransaction(uint8_t* data, const size_t len) override;
+    virtual m5::hal::error::error_t writeWithTransaction(const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override;
+    virtual m5::hal::error::error_t writeWithTransaction(const uint8_t reg, const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override;
+    virtual m5::hal::error::error_t writeWithTransaction(const uint16_t reg, const uint8_t* data, const size_t len,
+                                                         const uint32_t stop) override;
+    virtual m5::hal::error::error_t wakeup() override;
+
+protected:
+    const i2c_trace_entry_t* next(const i2c_trace_entry_t::Op op);
+    m5::hal::error::error_t replay_write(const uint8_t* prefix, const size_t plen, const uint8_t* data,
+                                         const size_t len);
+    void spend(const i2c_trace_entry_t& e, const size_t len);
+
+private:
+    std::shared_ptr<const I2CTrace> _trace{};
+    size_t _cursor{};
+    uint32_t _mismatches{};
+    uint32_t _replayed{};
+    uint64_t _bus_us{};
+    Timing _timing{};
+    bool _loop{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
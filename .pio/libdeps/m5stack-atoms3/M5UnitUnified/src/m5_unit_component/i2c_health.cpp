@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file i2c_health.cpp
+  @brief Health metrics of I2C transactions
+*/
+#include "i2c_health.hpp"
+#include <M5Utility.hpp>
+#include <algorithm>
+
+namespace {
+// us, the last bin has no bound
+constexpr uint32_t bounds[m5::unit::i2c_health_t::LATENCY_BINS - 1] = {50, 100, 200, 500, 1000, 2000, 5000};
+}  // namespace
+
+namespace m5 {
+namespace unit {
+
+constexpr size_t i2c_health_t::LATENCY_BINS;
+
+uint32_t i2c_health_t::latencyBound(const size_t bin)
+{
+    return (bin < LATENCY_BINS - 1) ? bounds[bin] : UINT32_MAX;
+}
+
+void i2c_health_t::record(const m5::hal::error::error_t err, const uint32_t latency_us)
+{
+    ++transactions;
+    if (m5::hal::error::isError(err)) {
+        ++consecutive;
+    } else {
+        consecutive  = 0;
+        succeeded_at = m5::utility::millis();
+    }
+    switch (err) {
+        case m5::hal::error::error_t::OK:
+            break;
+        case m5::hal::error::error_t::I2C_NO_ACK:
+            ++nacks;
+            break;
+        case m5::hal::error::error_t::TIMEOUT_ERROR:
+            ++timeouts;
+            break;
+        default:
+            bus_errors += m5::hal::error::isError(err);
+            break;
+    }
+    ++latency[std::upper_bound(std::begin(bounds), std::end(bounds), latency_us) - std::begin(bounds)];
+    max_latency = std::max(max_latency, latency_us);
+    total_latency += latency_us;
+}
+
+void i2c_health_t::merge(const i2c_health_t& o)
+{
+    transactions += o.transactions;
+    nacks += o.nacks;
+    timeouts += o.timeouts;
+    bus_errors += o.bus_errors;
+    crc_errors += o.crc_errors;
+    consecutive  = std::max(consecutive, o.consecutive);
+    succeeded_at = std::max(succeeded_at, o.succeeded_at);
+    max_latency = std::max(max_latency, o.max_latency);
+    total_latency += o.total_latency;
+    for (size_t i = 0; i < LATENCY_BINS; ++i) {
+        latency[i] += o.latency[i];
+    }
+}
+
+std::string i2c_health_t::toString() const
+{
+    std::string s = m5::utility::formatString("TX:%u NACK:%u TO:%u ERR:%u CRC:%u AVG:%uus MAX:%uus [", transactions,
+                                              nacks, timeouts, bus_errors, crc_errors, averageLatency(), max_latency);
+    for (size_t i = 0; i < LATENCY_BINS; ++i) {
+        s += m5::utility::formatString(i ? " %u" : "%u", latency[i]);
+    }
+    return s += ']';
+}
+
+std::string i2c_health_t::toJSON() const
+{
+    std::string s = m5::utility::formatString(
+        "{\"transactions\":%u,\"nacks\":%u,\"timeouts\":%u,\"bus_errors\":%u,"
+        "\"avg_latency_us\":%u,\"max_latency_us\":%u,\"latency\":[",
+        transactions, nacks, timeouts, bus_errors, averageLatency(), max_latency);
+    for (size_t i = 0; i < LATENCY_BINS; ++i) {
+        s += m5::utility::formatString(i ? ",%u" : "%u", latency[i]);
+    }
+    return s += "]}";
+}
+
+}  // namespace unit
+}  // namespace m5
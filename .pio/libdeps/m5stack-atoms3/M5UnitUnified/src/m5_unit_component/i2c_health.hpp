@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file i2c_health.hpp
+  @brief Health metrics of I2C transactions
+*/
+#ifndef M5_UNIT_COMPONENT_I2C_HEALTH_HPP
+#define M5_UNIT_COMPONENT_I2C_HEALTH_HPP
+
+#include <M5HAL.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @struct i2c_health_t
+  @brief Error counters and latency histogram of I2C transactions
+  @note Latency of asynchronous transactions includes the time in the queue
+ */
+struct i2c_health_t {
+    //! @brief Number of histogram bins
+    static constexpr size_t LATENCY_BINS{8};
+
+    uint32_t transactions{};  //!< All transactions
+    uint32_t nacks{};         //!< Not acknowledged
+    uint32_t timeouts{};      //!< Timed out
+    uint32_t bus_errors{};    //!< Other errors
+    uint32_t crc_errors{};    //!< CRC mismatches reported by the driver (See also Component::reportCrcError)
+    uint32_t max_latency{};   //!< Longest latency (us)
+    uint32_t consecutive{};   //!< Failures since the last success
+    uint32_t succeeded_at{};  //!< Time of the last success (ms)
+    uint64_t total_latency{};
+    uint32_t latency[LATENCY_BINS]{};  //!< Latency histogram (See also latencyBound)
+
+    /*!
+      @brief Upper bound of the bin (us)
+      @return Exclusive bound, UINT32_MAX for the last bin
+     */
+    static uint32_t latencyBound(const size_t bin);
+
+    //! @brief Record the result of the transaction
+    void record(const m5::hal::error::error_t err, const uint32_t latency_us);
+    //! @brief Add counters of the other
+    void merge(const i2c_health_t& o);
+    inline void clear()
+    {
+        *this = i2c_health_t{};
+    }
+
+    //! @brief Number of failures
+    inline uint32_t errors() const
+    {
+        return nacks + timeouts + bus_errors + crc_errors;
+    }
+    //! @brief Average latency (us)
+    inline uint32_t averageLatency() const
+    {
+        return transactions ? (uint32_t)(total_latency / transactions) : 0U;
+    }
+
+    //! @brief Single line summary
+    std::string toString() const;
+    /*!
+      @brief JSON object
+      @note crc_errors is left out, it stays 0 unless the driver calls Component::reportCrcError
+     */
+    std::string toJSON() const;
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -24,4 +24,9 @@
 #define M5_UNIT_UNIFIED_USING_ADC_ONESHOT
 #endif
 
+// I2C master driver (asynchronous transactions)
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0) && __has_include(<driver/i2c_master.h>)
+#define M5_UNIT_UNIFIED_USING_I2C_MASTER
+#endif
+
 #endif
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file register_block.hpp
+  @brief Contiguous registers read in one burst and decoded in place
+*/
+#ifndef M5_UNIT_COMPONENT_REGISTER_BLOCK_HPP
+#define M5_UNIT_COMPONENT_REGISTER_BLOCK_HPP
+
+#include <m5_utility/bit_segment.hpp>
+#include <m5_utility/conversion.hpp>
+#include <m5_utility/crc.hpp>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @class RegisterBlock
+  @brief Contiguous registers read in one burst
+  @details Declares the range once and decodes each field by its offset in the block,
+  instead of reading every field with a separate transaction
+  @tparam Reg Type of the register (uint8_t or uint16_t)
+  @tparam N Number of bytes
+  @code
+  // QMP6988 OTP, b00 is 20 bits of bytes 0,1 and upper nibble of byte 24
+  RegisterBlock<uint8_t, 25> otp{0xA0};
+  if (unit.readRegister(otp)) {
+      int32_t b00 = otp.signedBits<20>((otp.be<0, uint16_t>() << 4) | otp.segment<24, 4>().upper());
+      int16_t bt1 = otp.be<2, int16_t>();
+  }
+  @endcode
+  @note See also Component::readRegister(RegisterBlock&, ...)
+ */
+template <typename Reg, size_t N>
+class RegisterBlock {
+    static_assert(std::is_integral<Reg>::value && std::is_unsigned<Reg>::value && sizeof(Reg) <= 2,
+                  "Reg must be uint8_t or uint16_t");
+    static_assert(N > 0, "N must be not zero");
+
+public:
+    using register_type = Reg;
+
+    constexpr explicit RegisterBlock(const Reg reg) : _reg{reg}
+    {
+    }
+
+    //! @brief First register
+    inline constexpr Reg reg() const
+    {
+        return _reg;
+    }
+    //! @brief Number of bytes
+    static constexpr size_t size()
+    {
+        return N;
+    }
+    inline const uint8_t* data() const
+    {
+        return _buf.data();
+    }
+    inline uint8_t* data()
+    {
+        return _buf.data();
+    }
+    inline uint8_t operator[](const size_t i) const
+    {
+        return _buf[i];
+    }
+
+    ///@name Decoding
+    ///@{
+    //! @brief Big-endian value of sizeof(T) bytes at Offset
+    template <size_t Offset, typename T = uint16_t>
+    inline T be() const
+    {
+        static_assert(std::is_integral<T>::value, "T must be integral");
+        static_assert(Offset + sizeof(T) <= N, "Out of the block");
+        typename std::make_unsigned<T>::type v{};
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            v = (v << 8) | _buf[Offset + i];
+        }
+        return static_cast<T>(v);
+    }
+    //! @brief Little-endian value of sizeof(T) bytes at Offset
+    template <size_t Offset, typename T = uint16_t>
+    inline T le() const
+    {
+        static_assert(std::is_integral<T>::value, "T must be integral");
+        static_assert(Offset + sizeof(T) <= N, "Out of the block");
+        typename std::make_unsigned<T>::type v{};
+        for (size_t i = sizeof(T); i > 0; --i) {
+            v = (v << 8) | _buf[Offset + i - 1];
+        }
+        return static_cast<T>(v);
+    }
+    //! @brief Big-endian value of Bytes bytes at Offset (e.g. 24 bits)
+    template <size_t Offset, size_t Bytes>
+    inline uint32_t bytes() const
+    {
+        static_assert(Bytes > 0 && Bytes <= 4, "Bytes must be 1-4");
+        static_assert(Offset + Bytes <= N, "Out of the block");
+        uint32_t v{};
+        for (size_t i = 0; i < Bytes; ++i) {
+            v = (v << 8) | _buf[Offset + i];
+        }
+        return v;
+    }
+    /*!
+      @brief Split big-endian value of sizeof(T) bytes at Offset into upper and lower bits
+      @tparam LowerBits Number of lower bits
+     */
+    template <size_t Offset, size_t LowerBits, typename T = uint8_t>
+    inline m5::utility::BitSegment<LowerBits, T> segment() const
+    {
+        return m5::utility::BitSegment<LowerBits, T>(be<Offset, T>());
+    }
+    //! @brief Bits-wide two's complement value to signed
+    template <size_t Bits>
+    static inline int32_t signedBits(const uint32_t v)
+    {
+        return m5::utility::unsigned_to_signed<Bits>(v);
+    }
+    /*!
+      @brief Verify CRC8 (CRC8_Checksum) of Len bytes at Offset
+      @note The CRC is the byte following the data (Sensirion style)
+     */
+    template <size_t Offset, size_t Len = 2>
+    inline bool crc8() const
+    {
+        static_assert(Offset + Len < N, "Out of the block");
+        m5::utility::CRC8_Checksum crc{};
+        return crc.range(_buf.data() + Offset, Len) == _buf[Offset + Len];
+    }
+    ///@}
+
+private:
+    std::array<uint8_t, N> _buf{};
+    Reg _reg{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
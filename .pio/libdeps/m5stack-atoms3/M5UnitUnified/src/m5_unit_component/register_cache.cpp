@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file register_cache.cpp
+  @brief Cache of register values for Component
+*/
+#include "register_cache.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace m5 {
+namespace unit {
+
+bool RegisterCache::cacheable(const uint16_t reg, const size_t len) const
+{
+    if (!len) {
+        return false;
+    }
+    const uint32_t first = reg;
+    const uint32_t last  = reg + len - 1;
+    bool covered{};
+    for (auto&& r : _ranges) {
+        if (r.nonvolatile) {
+            covered |= (first >= r.first && last <= r.last);
+        } else if (first <= r.last && last >= r.first) {
+            return false;  // Overlaps volatile
+        }
+    }
+    return covered;
+}
+
+RegisterCache::entry_t* RegisterCache::find(const uint16_t reg)
+{
+    auto it = std::find_if(_entries.begin(), _entries.end(), [&reg](const entry_t& e) { return e.reg == reg; });
+    return (it != _entries.end()) ? &*it : nullptr;
+}
+
+bool RegisterCache::read(const uint16_t reg, uint8_t* buf, const size_t len)
+{
+    if (!cacheable(reg, len)) {
+        ++_bypasses;
+        return false;
+    }
+    auto e = find(reg);
+    if (e && e->data.size() >= len) {
+        std::memcpy(buf, e->data.data(), len);
+        ++_hits;
+        return true;
+    }
+    ++_misses;
+    return false;
+}
+
+void RegisterCache::fill(const uint16_t reg, const uint8_t* buf, const size_t len)
+{
+    if (!cacheable(reg, len)) {
+        return;
+    }
+    auto e = find(reg);
+    if (!e) {
+        _entries.emplace_back(entry_t{reg, {}});
+        e = &_entries.back();
+    }
+    if (e->data.size() <= len) {
+        e->data.assign(buf, buf + len);
+    } else {
+        std::memcpy(e->data.data(), buf, len);
+    }
+}
+
+void RegisterCache::write(const uint16_t reg, const uint8_t* buf, const size_t len)
+{
+    if (!len) {
+        return;  // Command or register pointer only
+    }
+    invalidate(reg, len);
+    if (buf && cacheable(reg, len)) {
+        _entries.emplace_back(entry_t{reg, std::vector<uint8_t>(buf, buf + len)});
+        ++_writes;
+    }
+}
+
+void RegisterCache::invalidate(const uint16_t reg, const size_t len)
+{
+    if (!len) {
+        return;
+    }
+    const uint32_t first = reg;
+    const uint32_t last  = reg + len - 1;
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+                                  [&first, &last](const entry_t& e) {
+                                      return first <= (uint32_t)(e.reg + e.data.size() - 1) && last >= e.reg;
+                                  }),
+                   _entries.end());
+}
+
+}  // namespace unit
+}  // namespace m5
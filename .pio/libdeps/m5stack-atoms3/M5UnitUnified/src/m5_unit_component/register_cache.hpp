@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file register_cache.hpp
+  @brief Cache of register values for Component
+*/
+#ifndef M5_UNIT_COMPONENT_REGISTER_CACHE_HPP
+#define M5_UNIT_COMPONENT_REGISTER_CACHE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @class RegisterCache
+  @brief Serves reading of non-volatile registers from RAM
+  @details Registers are cacheable only if the whole range read is in a declared non-volatile range and
+  not in any declared volatile range. The first read goes to the device, later reads of the same register
+  and length are served from the cache. Writing updates the cache (write-through).
+  @note Registers are assumed to auto-increment, writing invalidates cached data that overlaps it
+  @warning Call invalidate() if the device may change the registers by itself (reset etc.)
+ */
+class RegisterCache {
+public:
+    /*!
+      @struct range_t
+      @brief Declared register range
+     */
+    struct range_t {
+        uint16_t first;    //!< First register
+        uint16_t last;     //!< Last register (inclusive)
+        bool nonvolatile;  //!< Cacheable if true
+    };
+
+    RegisterCache() = default;
+    explicit RegisterCache(std::initializer_list<range_t> ranges) : _ranges(ranges)
+    {
+    }
+
+    ///@name Settings
+    ///@{
+    //! @brief Declare non-volatile (cacheable) registers
+    inline void addNonVolatile(const uint16_t first, const uint16_t last)
+    {
+        _ranges.push_back(range_t{first, last, true});
+    }
+    //! @brief Declare volatile registers (Takes precedence over non-volatile)
+    inline void addVolatile(const uint16_t first, const uint16_t last)
+    {
+        _ranges.push_back(range_t{first, last, false});
+        invalidate(first, last - first + 1);
+    }
+    //! @brief Declared ranges
+    inline const std::vector<range_t>& ranges() const
+    {
+        return _ranges;
+    }
+    ///@}
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of reads served from the cache
+    inline uint32_t hits() const
+    {
+        return _hits;
+    }
+    //! @brief Number of cacheable reads that accessed the device
+    inline uint32_t misses() const
+    {
+        return _misses;
+    }
+    //! @brief Number of reads of volatile registers
+    inline uint32_t bypasses() const
+    {
+        return _bypasses;
+    }
+    //! @brief Number of writes that updated the cache
+    inline uint32_t writes() const
+    {
+        return _writes;
+    }
+    inline void resetStatistics()
+    {
+        _hits = _misses = _bypasses = _writes = 0;
+    }
+    ///@}
+
+    //! @brief Is the range cacheable?
+    bool cacheable(const uint16_t reg, const size_t len) const;
+
+    ///@name For Component
+    ///@{
+    /*!
+      @brief Read from the cache
+      @return True if hit
+      @note Counts a hit, a miss or a bypass
+     */
+    bool read(const uint16_t reg, uint8_t* buf, const size_t len);
+    //! @brief Store the data read from the device
+    void fill(const uint16_t reg, const uint8_t* buf, const size_t len);
+    //! @brief Update by the data written to the device
+    void write(const uint16_t reg, const uint8_t* buf, const size_t len);
+    ///@}
+
+    //! @brief Discard all cached data
+    inline void invalidate()
+    {
+        _entries.clear();
+    }
+    //! @brief Discard cached data that overlaps the range
+    void invalidate(const uint16_t reg, const size_t len);
+
+private:
+    struct entry_t {
+        uint16_t reg;
+        std::vector<uint8_t> data;
+    };
+    entry_t* find(const uint16_t reg);
+
+    std::vector<range_t> _ranges{};
+    std::vector<entry_t> _entries{};
+    uint32_t _hits{}, _misses{}, _bypasses{}, _writes{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file static_unit_set.hpp
+  @brief Fixed set of units composed at compile time
+*/
+#ifndef M5_UNIT_COMPONENT_STATIC_UNIT_SET_HPP
+#define M5_UNIT_COMPONENT_STATIC_UNIT_SET_HPP
+
+#include "../M5UnitComponent.hpp"
+#include <M5Utility.hpp>
+#include <tuple>
+#include <type_traits>
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @class StaticUnitSet
+  @brief Alternative to UnitUnified for a fixed configuration
+  @details Units are held by reference in std::tuple and their begin/update are called
+  with the qualified name of each type, so the calls are resolved at compile time and can be inlined.
+  No container is allocated and no schedule is built
+  @tparam Units Types of the units (each must be derived from Component)
+  @code
+  m5::unit::UnitSHT30 sht30;
+  m5::unit::UnitQMP6988 qmp;
+  m5::unit::StaticUnitSet<m5::unit::UnitSHT30, m5::unit::UnitQMP6988> units{sht30, qmp};
+
+  units.assign(Wire);
+  units.begin();
+  ...
+  units.update();
+  @endcode
+  @note The units can not be added to UnitUnified at the same time
+  @note Each unit still accesses the bus through its adapter
+  @warning Daisy-chained children (hubs) are not supported, use UnitUnified
+ */
+template <class... Units>
+class StaticUnitSet {
+    static_assert(sizeof...(Units) > 0, "At least one unit is required");
+
+public:
+    using tuple_type = std::tuple<Units&...>;
+
+    explicit StaticUnitSet(Units&... units) : _units{units...}
+    {
+    }
+
+    //! @brief Number of the units
+    static constexpr size_t size()
+    {
+        return sizeof...(Units);
+    }
+    //! @brief Gets the I-th unit
+    template <size_t I>
+    inline typename std::tuple_element<I, tuple_type>::type get()
+    {
+        return std::get<I>(_units);
+    }
+
+    ///@name Bus assignment
+    ///@{
+    //! @brief Assign TwoWire to all units
+    inline bool assign(TwoWire& wire)
+    {
+        return assign_each<0>([&wire](Component& u) { return u.assign(wire); });
+    }
+    //! @brief Assign m5::hal::bus to all units
+    inline bool assign(m5::hal::bus::Bus* bus)
+    {
+        return assign_each<0>([&bus](Component& u) { return u.assign(bus); });
+    }
+    ///@}
+
+    /*!
+      @brief Begin of all units
+      @return True if all units have begun
+     */
+    inline bool begin()
+    {
+        return begin_each<0>();
+    }
+    /*!
+      @brief Update of all units
+      @param force Forced communication for updates if true
+      @note Periodic measurement units whose interval has not elapsed are skipped as UnitUnified does
+     */
+    inline void update(const bool force = false)
+    {
+        poll_each<0>();
+        update_each<0>(force, m5::utility::millis());
+        poll_each<0>();
+    }
+    /*!
+      @brief Progress asynchronous transactions of all units
+      @return Number of the pending transactions
+     */
+    inline size_t poll()
+    {
+        return poll_each<0>();
+    }
+    /*!
+      @brief Time when update() should be called next
+      @return millis() based time
+      @note Now if no unit can tell
+     */
+    inline types::elapsed_time_t nextWakeup() const
+    {
+        const auto now   = m5::utility::millis();
+        const auto never = now + 0x7FFFFFFFUL;
+        auto next        = next_each<0>(now, never);
+        return (next == never || (long)(next - now) < 0) ? now : next;
+    }
+    //! @brief Time the caller can sleep before calling update() (ms)
+    inline uint32_t idleMillis() const
+    {
+        const auto next = nextWakeup();
+        const auto now  = m5::utility::millis();
+        return ((long)(next - now) > 0) ? next - now : 0U;
+    }
+
+protected:
+    // Same as UnitUnified, only periodic measurement units can tell when the next data comes
+    static inline bool is_due(const Component& u, const types::elapsed_time_t now)
+    {
+        return !u.inPeriodic() || !u.interval() || !u.updatedMillis() ||
+               (long)(now - (u.updatedMillis() + u.interval())) >= 0;
+    }
+
+    template <size_t I, typename F>
+    inline typename std::enable_if<(I < sizeof...(Units)), bool>::type assign_each(F f)
+    {
+        const bool ret = f(std::get<I>(_units));
+        return assign_each<I + 1>(f) && ret;
+    }
+    template <size_t I, typename F>
+    inline typename std::enable_if<(I == sizeof...(Units)), bool>::type assign_each(F)
+    {
+        return true;
+    }
+
+    template <size_t I>
+    inline typename std::enable_if<(I < sizeof...(Units)), bool>::type begin_each()
+    {
+        using U = typename std::remove_reference<typename std::tuple_element<I, tuple_type>::type>::type;
+        U& u     = std::get<I>(_units);
+        u._begun = u.U::begin();
+        if (!u._begun) {
+            M5_LIB_LOGE("Failed to begin: %s", u.debugInfo().c_str());
+        }
+        return begin_each<I + 1>() && u._begun;
+    }
+    template <size_t I>
+    inline typename std::enable_if<(I == sizeof...(Units)), bool>::type begin_each()
+    {
+        return true;
+    }
+
+    template <size_t I>
+    inline typename std::enable_if<(I < sizeof...(Units))>::type update_each(const bool force,
+                                                                              const types::elapsed_time_t now)
+    {
+        using U = typename std::remove_reference<typename std::tuple_element<I, tuple_type>::type>::type;
+        U& u    = std::get<I>(_units);
+        if (u._begun && !u._component_cfg.self_update) {
+            if (force || is_due(u, now)) {
+                u.U::update(force);
+            } else {
+                u._updated = false;
+            }
+        }
+        update_each<I + 1>(force, now);
+    }
+    template <size_t I>
+    inline typename std::enable_if<(I == sizeof...(Units))>::type update_each(const bool,
+                                                                              const types::elapsed_time_t)
+    {
+    }
+
+    template <size_t I>
+    inline typename std::enable_if<(I < sizeof...(Units)), size_t>::type poll_each()
+    {
+        auto ad = std::get<I>(_units).template asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        return ((ad && ad->pending()) ? ad->poll() : 0U) + poll_each<I + 1>();
+    }
+    template <size_t I>
+    inline typename std::enable_if<(I == sizeof...(Units)), size_t>::type poll_each()
+    {
+        return 0U;
+    }
+
+    // Earliest of the pending transactions and the due time
+    template <size_t I>
+    inline typename std::enable_if<(I < sizeof...(Units)), types::elapsed_time_t>::type next_each(
+        const types::elapsed_time_t now, types::elapsed_time_t next) const
+    {
+        const Component& u = std::get<I>(_units);
+        auto ad            = u.asAdapter<AdapterI2C>(Adapter::Type::I2C);
+        if (ad && ad->pending() && (long)(ad->nextPollMillis() - next) < 0) {
+            next = ad->nextPollMillis();
+        }
+        if (u._begun && !u._component_cfg.self_update) {
+            const auto due = is_due(u, now) ? now : u.updatedMillis() + u.interval();
+            if ((long)(due - next) < 0) {
+                next = due;
+            }
+        }
+        return next_each<I + 1>(now, next);
+    }
+    template <size_t I>
+    inline typename std::enable_if<(I == sizeof...(Units)), types::elapsed_time_t>::type next_each(
+        const types::elapsed_time_t, const types::elapsed_time_t next) const
+    {
+        return next;
+    }
+
+private:
+    tuple_type _units;
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -14,6 +14,7 @@
 #include <vector>
 #include <iterator>
 #include <cassert>
+#include <utility>
 #if __cplusplus >= 201703L
 #include <optional>
 #else
@@ -42,6 +43,7 @@ public:
 #endif
     class iterator;
     class const_iterator;
+    struct segment_type;
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
@@ -198,6 +200,22 @@ public:
         }
         return ret;
     }
+    /*!
+      @brief Contiguous views of the oldest elements without copying
+      @param num Max elements
+      @return Up to 2 segments in order, second is empty unless the range wraps around
+      @warning Segments are invalidated by adding elements
+     */
+    std::pair<segment_type, segment_type> segments(const size_t num) const
+    {
+        size_t sz = std::min(num, size());
+        if (sz == 0) {
+            return {};
+        }
+        size_t elms = std::min(_cap - _tail, sz);
+        return std::make_pair(segment_type{&_buf[_tail], elms},
+                              segment_type{elms < sz ? &_buf[0] : nullptr, sz - elms});
+    }
     /// @}
 
     ///@name Capacity
@@ -271,6 +289,15 @@ public:
             _full = false;
         }
     }
+    //! @brief removes the top num elements
+    inline void pop_front(const size_type num)
+    {
+        const size_type sz = std::min(num, size());
+        if (sz) {
+            _tail = (_tail + sz) % _cap;
+            _full = false;
+        }
+    }
     //! @brief removes the end element
     inline void pop_back()
     {
@@ -309,6 +336,33 @@ public:
     }
     ///@}
 
+    /*!
+      @struct segment_type
+      @brief Contiguous range of elements in the storage
+     */
+    struct segment_type {
+        const value_type* data;
+        size_type size;
+
+        inline bool empty() const
+        {
+            return size == 0;
+        }
+        inline const value_type* begin() const
+        {
+            return data;
+        }
+        inline const value_type* end() const
+        {
+            return data + size;
+        }
+        inline const_reference operator[](size_type i) const
+        {
+            assert(i < size && "index overflow");
+            return data[i];
+        }
+    };
+
     ///@cond
     class iterator {
     public:
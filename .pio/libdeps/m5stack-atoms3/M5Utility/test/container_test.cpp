@@ -368,6 +368,73 @@ void cb_read()
     EXPECT_EQ(*rb.back(), 227);
 }
 
+void cb_segments()
+{
+    SCOPED_TRACE("Segments");
+
+    FixedCircularBuffer<int, 8> rb;
+
+    // empty
+    auto seg = rb.segments(8);
+    EXPECT_TRUE(seg.first.empty());
+    EXPECT_TRUE(seg.second.empty());
+
+    // not wrapped
+    for (int i = 0; i < 6; ++i) {
+        rb.push_back(i);
+    }
+    seg = rb.segments(100);
+    EXPECT_EQ(seg.first.size, 6U);
+    EXPECT_TRUE(seg.second.empty());
+    int c = 0;
+    for (auto&& e : seg.first) {
+        EXPECT_EQ(e, c++);
+    }
+    seg = rb.segments(2);
+    EXPECT_EQ(seg.first.size, 2U);
+    EXPECT_EQ(seg.first[1], 1);
+
+    // wrapped (full)
+    for (int i = 6; i < 12; ++i) {
+        rb.push_back(i);
+    }
+    EXPECT_TRUE(rb.full());
+    seg = rb.segments(8);
+    EXPECT_EQ(seg.first.size + seg.second.size, 8U);
+    EXPECT_FALSE(seg.second.empty());
+    c = 4;
+    for (auto&& e : seg.first) {
+        EXPECT_EQ(e, c++);
+    }
+    for (auto&& e : seg.second) {
+        EXPECT_EQ(e, c++);
+    }
+    EXPECT_EQ(c, 12);
+    // Points to the storage
+    EXPECT_EQ(&seg.first[0], &rb[0]);
+    EXPECT_EQ(&seg.second[0], &rb[seg.first.size]);
+
+    // Limited to the first segment
+    seg = rb.segments(3);
+    EXPECT_EQ(seg.first.size, 3U);
+    EXPECT_TRUE(seg.second.empty());
+
+    // pop_front(n)
+    rb.pop_front(5);
+    EXPECT_FALSE(rb.full());
+    EXPECT_EQ(rb.size(), 3U);
+    EXPECT_EQ(*rb.front(), 9);
+    seg = rb.segments(8);
+    EXPECT_EQ(seg.first.size + seg.second.size, 3U);
+    rb.pop_front(100);
+    EXPECT_TRUE(rb.empty());
+    rb.pop_front(1);
+    EXPECT_TRUE(rb.empty());
+    rb.push_back(42);
+    EXPECT_EQ(*rb.front(), 42);
+    EXPECT_EQ(*rb.back(), 42);
+}
+
 void cb_iterator_test()
 {
     SCOPED_TRACE("Iterators");
@@ -469,5 +536,6 @@ TEST(Utility, CircularBuffer)
     cb_basic_test();
     cb_constructor_test();
     cb_read();
+    cb_segments();
     cb_iterator_test();
 }
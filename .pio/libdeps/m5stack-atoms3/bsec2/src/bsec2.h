@@ -223,6 +223,15 @@ public:
      */
     int64_t getTimeMs(void);
 
+    /**
+     * @brief Function to get the time at which run() has to be called next
+     * @return Timestamp in nanoseconds on the getTimeMs() time base, 0 before the first run()
+     */
+    int64_t getNextCall(void) const
+    {
+        return bmeConf.next_call;
+    }
+
     /**
      * @brief Function to assign the memory block to the bsec instance
      * 
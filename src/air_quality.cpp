@@ -0,0 +1,123 @@
+#include "air_quality.h"
+
+#if BME688_BSEC
+
+#include <bsec2.h>
+
+AirQuality airQuality;
+AirQualityStats airQualityStats;
+
+static Bsec2 bsec;
+static bool begun = false;
+// BSEC instance in .bss instead of the heap
+static uint8_t bsecMemory[BSEC_INSTANCE_SIZE];
+// Output time stamp of the last sample taken, to spot new ones
+static int64_t lastOutputNs = 0;
+// BSEC sample period (LP 3 s, ULP 300 s); samples older than
+// STALE_PERIODS of them are no longer current
+static uint32_t samplePeriodMs = 0;
+static const uint32_t STALE_PERIODS = 3;
+
+bool airQualityBegin(TwoWire& wire, uint8_t addr, bool lowPower) {
+    bsecSensor outputs[] = {
+        BSEC_OUTPUT_IAQ,
+        BSEC_OUTPUT_BREATH_VOC_EQUIVALENT,
+        BSEC_OUTPUT_CO2_EQUIVALENT,
+        BSEC_OUTPUT_SENSOR_HEAT_COMPENSATED_TEMPERATURE,
+        BSEC_OUTPUT_SENSOR_HEAT_COMPENSATED_HUMIDITY,
+    };
+
+    bsec.allocateMemory(bsecMemory);
+    if (!bsec.begin(addr, wire)) {
+        Serial.printf("BME688: begin failed (BSEC %d, sensor %d)\n", (int)bsec.status,
+                      (int)bsec.sensor.status);
+        return false;
+    }
+    // Self-heating of the sensor, used by BSEC for the compensated T/RH
+    bsec.setTemperatureOffset(lowPower ? TEMP_OFFSET_ULP : TEMP_OFFSET_LP);
+    if (!bsec.updateSubscription(outputs, ARRAY_LEN(outputs),
+                                 lowPower ? BSEC_SAMPLE_RATE_ULP : BSEC_SAMPLE_RATE_LP)) {
+        Serial.printf("BME688: subscription failed (BSEC %d)\n", (int)bsec.status);
+        return false;
+    }
+
+    samplePeriodMs = lowPower ? 300000 : 3000;
+
+    Serial.printf("BME688: BSEC %d.%d.%d.%d\n", bsec.version.major, bsec.version.minor,
+                  bsec.version.major_bugfix, bsec.version.minor_bugfix);
+    begun = true;
+    return true;
+}
+
+bool airQualityReady() {
+    return begun;
+}
+
+bool airQualityFresh() {
+    return begun && airQuality.sampleMs &&
+           millis() - airQuality.sampleMs <= STALE_PERIODS * samplePeriodMs;
+}
+
+bool airQualityUpdate() {
+    if (!begun) return false;
+
+    // next_call is 0 before the first run(), which is then due at once
+    int64_t nowMs = bsec.getTimeMs();
+    int64_t dueMs = bsec.getNextCall() / INT64_C(1000000);
+    if (nowMs < dueMs) return false;
+
+    uint32_t late = (uint32_t)(nowMs - dueMs);
+    if (bsec.getNextCall()) {
+        airQualityStats.lastLateMs = late;
+        if (late > airQualityStats.maxLateMs) airQualityStats.maxLateMs = late;
+    }
+
+    airQualityStats.runs++;
+    if (!bsec.run()) {
+        airQualityStats.errors++;
+        Serial.printf("BME688: run failed (BSEC %d, sensor %d)\n", (int)bsec.status,
+                      (int)bsec.sensor.status);
+        return false;
+    }
+
+    // Outputs stay in place until the next sample replaces them
+    const bsecOutputs* out = bsec.getOutputs();
+    if (!out || out->output[0].time_stamp == lastOutputNs) return false;
+    lastOutputNs = out->output[0].time_stamp;
+
+    for (uint8_t i = 0; i < out->nOutputs; i++) {
+        const bsecData& d = out->output[i];
+        switch (d.sensor_id) {
+            case BSEC_OUTPUT_IAQ:
+                airQuality.iaq      = d.signal;
+                airQuality.accuracy = d.accuracy;
+                break;
+            case BSEC_OUTPUT_BREATH_VOC_EQUIVALENT:
+                airQuality.voc = d.signal;
+                break;
+            case BSEC_OUTPUT_CO2_EQUIVALENT:
+                airQuality.co2eq = d.signal;
+                break;
+            case BSEC_OUTPUT_SENSOR_HEAT_COMPENSATED_TEMPERATURE:
+                airQuality.temperature = d.signal;
+                break;
+            case BSEC_OUTPUT_SENSOR_HEAT_COMPENSATED_HUMIDITY:
+                airQuality.humidity = d.signal;
+                break;
+            default:
+                break;
+        }
+    }
+    airQuality.sampleMs = millis();
+    airQualityStats.samples++;
+    return true;
+}
+
+uint32_t airQualityIdleMillis() {
+    if (!begun) return UINT32_MAX;
+
+    int64_t left = bsec.getNextCall() / INT64_C(1000000) - bsec.getTimeMs();
+    return left > 0 ? (uint32_t)left : 0;
+}
+
+#endif // BME688_BSEC
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// -------------------------------------------------------------------
+// Optional BME688 air quality through Bosch BSEC2 (-DBME688_BSEC=1).
+//
+// BSEC decides when the sensor is measured: it reports the time of
+// its next call after every run(). airQualityUpdate() only calls
+// run() once that deadline has passed, and airQualityIdleMillis()
+// tells the loop how long it may sleep before it is due again.
+// Values are NAN until BSEC has produced them.
+// -------------------------------------------------------------------
+
+struct AirQuality {
+    float iaq         = NAN; // indoor air quality index, 0..500
+    uint8_t accuracy  = 0;   // IAQ accuracy, 0 (calibrating) .. 3
+    float voc         = NAN; // breath-VOC equivalent, ppm
+    float co2eq       = NAN; // CO2 equivalent, ppm
+    float temperature = NAN; // °C, heat compensated
+    float humidity    = NAN; // %RH, heat compensated
+    uint32_t sampleMs = 0;   // millis() of the last sample, 0 before the first
+};
+
+struct AirQualityStats {
+    uint32_t runs       = 0; // run() calls made on the deadline
+    uint32_t samples    = 0; // runs that produced new outputs
+    uint32_t errors     = 0; // run() failures
+    uint32_t lastLateMs = 0; // how late the last run() was
+    uint32_t maxLateMs  = 0;
+};
+
+extern AirQuality airQuality;
+extern AirQualityStats airQualityStats;
+
+// Begin BSEC on the sensor; lowPower selects ULP (5 min) instead of
+// LP (3 s) sampling. Returns false if the BME688 does not answer.
+bool airQualityBegin(TwoWire& wire, uint8_t addr, bool lowPower);
+
+bool airQualityReady();
+
+// A sample came in within the last few sample periods. When BSEC stops
+// producing them (run errors, sensor unplugged) the values above stay
+// as they were; callers that merge them should check this first.
+bool airQualityFresh();
+
+// Call run() if its deadline has passed. Returns true on new values.
+bool airQualityUpdate();
+
+// ms until run() is due, 0 if overdue (or UINT32_MAX if not begun)
+uint32_t airQualityIdleMillis();
@@ -0,0 +1,206 @@
+#include "chart.h"
+
+#include <M5GFX.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ChartStats chartStats;
+
+// Same look as the JS charts on /history. Palette indices for the 4bpp
+// sprite.
+enum : uint32_t { C_BG = 0, C_GRID, C_LABEL, C_LINE };
+
+static const uint32_t BG_COLOR    = 0x2A2A2Au;
+static const uint32_t GRID_COLOR  = 0x444444u;
+static const uint32_t LABEL_COLOR = 0x888888u;
+
+static const uint32_t LINE_COLOR[CHART_CHANNELS] = {
+    0x4BC0C0u, // humidity,    rgb(75,192,192)
+    0xFF6384u, // temperature, rgb(255,99,132)
+    0xFFCD56u, // pressure,    rgb(255,205,86)
+};
+
+static const char* const CHANNEL_NAME[CHART_CHANNELS] = {
+    "humidity", "temperature", "pressure"
+};
+
+static const char* const CHANNEL_TITLE[CHART_CHANNELS] = {
+    "Humidity (%)", "Temperature (C)", "Pressure (mbar)"
+};
+
+static const int32_t PAD_L = 40;
+static const int32_t PAD_R = 8;
+static const int32_t PAD_T = 16;
+static const int32_t PAD_B = 8;
+
+struct CachedChart {
+    uint8_t* png     = nullptr;
+    size_t   len     = 0;
+    uint32_t spanMin = 0;
+};
+
+static CachedChart cache[CHART_CHANNELS];
+
+bool chartParseChannel(const char* name, ChartChannel* ch) {
+    for (uint8_t i = 0; i < CHART_CHANNELS; ++i) {
+        if (strcmp(name, CHANNEL_NAME[i]) == 0) {
+            *ch = (ChartChannel)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t chartParseSpan(const char* span) {
+    char* end = nullptr;
+    unsigned long v = strtoul(span, &end, 10);
+    if (end == span) return 0;
+    switch (*end) {
+        case '\0':
+        case 'm': break;
+        case 'h': v *= 60; break;
+        case 'd': v *= 24 * 60; break;
+        default:  return 0;
+    }
+    return (uint32_t)v;
+}
+
+const uint8_t* chartCached(ChartChannel ch, uint32_t spanMin, size_t* len) {
+    CachedChart& c = cache[ch];
+    if (!c.png || c.spanMin != spanMin) return nullptr;
+    chartStats.cacheHits++;
+    *len = c.len;
+    return c.png;
+}
+
+void chartInvalidate() {
+    for (auto& c : cache) {
+        free(c.png);
+        c.png = nullptr;
+        c.len = 0;
+    }
+}
+
+static void drawChart(LGFX_Sprite& s, ChartChannel ch, uint32_t spanMin, const float* values, size_t n) {
+    s.fillScreen(C_BG);
+    s.setFont(&fonts::Font0);
+    s.setTextColor(C_LABEL);
+
+    char text[24];
+    s.setTextDatum(top_left);
+    s.drawString(CHANNEL_TITLE[ch], PAD_L, 4);
+    if (spanMin % (24 * 60) == 0)  snprintf(text, sizeof(text), "last %lud", (unsigned long)spanMin / (24 * 60));
+    else if (spanMin % 60 == 0)    snprintf(text, sizeof(text), "last %luh", (unsigned long)spanMin / 60);
+    else                           snprintf(text, sizeof(text), "last %lum", (unsigned long)spanMin);
+    s.setTextDatum(top_right);
+    s.drawString(text, CHART_WIDTH - PAD_R, 4);
+
+    int32_t chartW = CHART_WIDTH - PAD_L - PAD_R;
+    int32_t chartH = CHART_HEIGHT - PAD_T - PAD_B;
+    if (n == 0) {
+        s.setTextDatum(middle_center);
+        s.drawString("No data logged yet", PAD_L + chartW / 2, PAD_T + chartH / 2);
+        return;
+    }
+
+    float lo = values[0], hi = values[0];
+    for (size_t i = 1; i < n; ++i) {
+        if (values[i] < lo) lo = values[i];
+        if (values[i] > hi) hi = values[i];
+    }
+    float range = (hi - lo) > 0 ? (hi - lo) : 1;
+
+    s.setTextDatum(middle_right);
+    for (int i = 0; i <= 4; ++i) {
+        int32_t y = PAD_T + i * (chartH - 1) / 4;
+        s.drawFastHLine(PAD_L, y, chartW, C_GRID);
+        snprintf(text, sizeof(text), "%.1f", hi - i * range / 4);
+        s.drawString(text, PAD_L - 4, y);
+    }
+
+    int32_t px = 0, py = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int32_t x = PAD_L + (n > 1 ? (int32_t)(i * (chartW - 1) / (n - 1)) : chartW / 2);
+        int32_t y = PAD_T + (chartH - 2) - (int32_t)lroundf((values[i] - lo) * (chartH - 2) / range);
+        if (i) {
+            // 2 px line, like lineWidth=2 on the canvas
+            s.drawLine(px, py,     x, y,     C_LINE);
+            s.drawLine(px, py + 1, x, y + 1, C_LINE);
+        }
+        px = x;
+        py = y;
+    }
+    if (n == 1) s.fillRect(px - 1, py, 2, 2, C_LINE);
+}
+
+// Growable output for LGFXBase::writePng; the PNG is only a few KB
+struct PngBuffer {
+    uint8_t* data = nullptr;
+    size_t   len  = 0;
+    size_t   cap  = 0;
+};
+
+static bool appendPng(const void* data, size_t len, void* user) {
+    PngBuffer* b = (PngBuffer*)user;
+    if (b->len + len > b->cap) {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->len + len) cap *= 2;
+        uint8_t* p = (uint8_t*)realloc(b->data, cap);
+        if (!p) return false;
+        b->data = p;
+        b->cap  = cap;
+    }
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+    return true;
+}
+
+const uint8_t* chartRender(ChartChannel ch, uint32_t spanMin, const float* values, size_t n, size_t* len) {
+    CachedChart& c = cache[ch];
+    free(c.png);
+    c.png = nullptr;
+    c.len = 0;
+
+    // 4bpp palette keeps the sprite at 25 KB; only held while encoding.
+    // The encoder then needs its ~45 KB compressor on top, so a heap
+    // without a 25 KB piece could never finish: give up (503) instead.
+    // For the same reason a divided sprite (createDividedSprite) is not
+    // used here: its small blocks would still be followed by the 45 KB.
+    LGFX_Sprite s;
+    s.setColorDepth(4);
+    if (!s.createSprite(CHART_WIDTH, CHART_HEIGHT)) {
+        chartStats.failedRenders++;
+        return nullptr;
+    }
+    s.setPaletteColor(C_BG,    BG_COLOR);
+    s.setPaletteColor(C_GRID,  GRID_COLOR);
+    s.setPaletteColor(C_LABEL, LABEL_COLOR);
+    s.setPaletteColor(C_LINE,  LINE_COLOR[ch]);
+
+    uint32_t t0 = lgfx::micros();
+    drawChart(s, ch, spanMin, values, n);
+    uint32_t t1 = lgfx::micros();
+    PngBuffer out;
+    size_t pngLen = s.writePng(appendPng, &out);
+    uint32_t t2 = lgfx::micros();
+    s.deleteSprite();
+    if (!pngLen) {
+        free(out.data);
+        chartStats.failedRenders++;
+        return nullptr;
+    }
+
+    c.png     = out.data;
+    c.len     = pngLen;
+    c.spanMin = spanMin;
+
+    chartStats.renders++;
+    chartStats.lastRenderUs = t1 - t0;
+    chartStats.lastEncodeUs = t2 - t1;
+    chartStats.lastBytes    = pngLen;
+
+    *len = pngLen;
+    return c.png;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// -------------------------------------------------------------------
+// Server-rendered history charts (/chart.png).
+//
+// Draws one channel into an off-screen 4bpp sprite, encodes it with
+// M5GFX's streaming PNG encoder and keeps the result per channel until the next
+// logged sample (chartInvalidate), so repeated requests just send the
+// cached bytes.
+// -------------------------------------------------------------------
+
+enum ChartChannel : uint8_t {
+    CHART_HUMIDITY = 0,
+    CHART_TEMPERATURE,
+    CHART_PRESSURE,
+    CHART_CHANNELS
+};
+
+struct ChartStats {
+    uint32_t renders       = 0;
+    uint32_t cacheHits     = 0;
+    uint32_t lastRenderUs  = 0; // drawing the sprite
+    uint32_t lastEncodeUs  = 0; // PNG encoding
+    uint32_t lastBytes     = 0;
+    uint32_t failedRenders = 0; // out of memory for the sprite or the encoder
+};
+
+extern ChartStats chartStats;
+
+const int32_t CHART_WIDTH  = 320;
+const int32_t CHART_HEIGHT = 160;
+
+// "humidity" / "temperature" / "pressure"
+bool chartParseChannel(const char* name, ChartChannel* ch);
+
+// "90", "90m", "6h", "2d" -> minutes; 0 if invalid
+uint32_t chartParseSpan(const char* span);
+
+// Cached PNG for this channel and span, nullptr if it must be rendered
+const uint8_t* chartCached(ChartChannel ch, uint32_t spanMin, size_t* len);
+
+// Render values (oldest first) and cache the PNG; nullptr if out of memory
+const uint8_t* chartRender(ChartChannel ch, uint32_t spanMin, const float* values, size_t n, size_t* len);
+
+// New data logged (or cleared): drop all cached images
+void chartInvalidate();
@@ -0,0 +1,29 @@
+#include "fusion.h"
+
+FusionOutput fuseTemperatureHumidity(const FusionSensor* sensors, const FusionInput* inputs, size_t n) {
+    float tSum = 0.0f, tWeight = 0.0f;
+    float hSum = 0.0f, hWeight = 0.0f;
+    FusionOutput out;
+
+    for (size_t i = 0; i < n; ++i) {
+        const FusionSensor& s = sensors[i];
+        if (s.weight <= 0.0f) continue;
+
+        bool used = false;
+        if (!isnan(inputs[i].temperature)) {
+            tSum    += (inputs[i].temperature + s.temperatureOffset) * s.weight;
+            tWeight += s.weight;
+            used     = true;
+        }
+        if (!isnan(inputs[i].humidity)) {
+            hSum    += (inputs[i].humidity + s.humidityOffset) * s.weight;
+            hWeight += s.weight;
+            used     = true;
+        }
+        if (used) out.sources++;
+    }
+
+    if (tWeight > 0.0f) out.temperature = tSum / tWeight;
+    if (hWeight > 0.0f) out.humidity = fminf(100.0f, fmaxf(0.0f, hSum / hWeight));
+    return out;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+
+// -------------------------------------------------------------------
+// Temperature/humidity fusion of several sensors (SHT30, BME688).
+//
+// Each sensor's reading is corrected by its own offsets, then the
+// sensors that have a value are averaged by weight. Temperature and
+// humidity are fused separately, so a sensor may provide only one.
+// Arduino-free so the native env can test it.
+// -------------------------------------------------------------------
+
+// Per-sensor correction and trust; offsets are added to the reading
+struct FusionSensor {
+    float temperatureOffset = 0.0f; // °C
+    float humidityOffset    = 0.0f; // %RH
+    float weight            = 1.0f; // relative, 0 = ignored
+};
+
+// Latest reading of one sensor; NAN = none (absent, warming up)
+struct FusionInput {
+    float temperature = NAN;
+    float humidity    = NAN;
+};
+
+struct FusionOutput {
+    float temperature = NAN; // NAN if no sensor has a value
+    float humidity    = NAN; // clamped to 0..100
+    size_t sources    = 0;   // sensors that contributed to either
+};
+
+FusionOutput fuseTemperatureHumidity(const FusionSensor* sensors, const FusionInput* inputs, size_t n);
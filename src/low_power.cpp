@@ -0,0 +1,56 @@
+#include "low_power.h"
+
+#include <M5Unified.h>
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+LowPowerStats lowPowerStats;
+
+static uint64_t lastWakeUs = 0;
+
+float LowPowerStats::dutyCycle() const {
+    uint64_t total = awakeUs + asleepUs;
+    return total ? (float)awakeUs / (float)total : 1.0f;
+}
+
+uint32_t LowPowerStats::avgLatencyUs() const {
+    return timerWakes ? (uint32_t)(totalLatencyUs / timerWakes) : 0;
+}
+
+void lowPowerBegin(uint8_t buttonPin) {
+    // Button is active low
+    gpio_wakeup_enable((gpio_num_t)buttonPin, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    lastWakeUs = esp_timer_get_time();
+}
+
+bool lowPowerSleep(uint32_t ms) {
+    uint64_t sleepUs = (uint64_t)ms * 1000ULL;
+    uint64_t start   = esp_timer_get_time();
+
+    lowPowerStats.awakeUs += start - lastWakeUs;
+    lowPowerStats.sleeps++;
+
+    Serial.flush();
+    M5.Power.lightSleep(sleepUs, false);
+
+    uint64_t now = esp_timer_get_time();
+    lowPowerStats.asleepUs += now - start;
+    lastWakeUs = now;
+
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO) {
+        lowPowerStats.buttonWakes++;
+        return true;
+    }
+
+    // Overshoot past the requested wake time
+    uint32_t latency = (now - start > sleepUs) ? (uint32_t)(now - start - sleepUs) : 0;
+    lowPowerStats.timerWakes++;
+    lowPowerStats.lastLatencyUs   = latency;
+    lowPowerStats.totalLatencyUs += latency;
+    if (latency > lowPowerStats.maxLatencyUs) {
+        lowPowerStats.maxLatencyUs = latency;
+    }
+    return false;
+}
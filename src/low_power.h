@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------
+// Opt-in low-power logging: light-sleep between samples.
+//
+// Timer wakeups drive the sampling; the button (GPIO) wakes the device
+// early so the user can bring the AP up. Awake/asleep time and the
+// overshoot of each timer wakeup are measured so the duty cycle and
+// wake latency can be reported.
+// -------------------------------------------------------------------
+
+struct LowPowerStats {
+    uint32_t sleeps       = 0;
+    uint32_t timerWakes   = 0;
+    uint32_t buttonWakes  = 0;
+    uint64_t awakeUs      = 0;
+    uint64_t asleepUs     = 0;
+    uint32_t lastLatencyUs  = 0; // timer wakeups only
+    uint32_t maxLatencyUs   = 0;
+    uint64_t totalLatencyUs = 0;
+
+    float    dutyCycle() const;    // 0.0 .. 1.0
+    uint32_t avgLatencyUs() const;
+};
+
+extern LowPowerStats lowPowerStats;
+
+// Arm the button pin as a light-sleep wakeup source.
+void lowPowerBegin(uint8_t buttonPin);
+
+// Light-sleep for up to 'ms'. Returns true if the button woke us.
+bool lowPowerSleep(uint32_t ms);
@@ -7,28 +7,96 @@
  * Hardwares: M5AtomS3 + Unit ENV_III
  * Dependent Library:
  * M5UnitENV: https://github.com/m5stack/M5Unit-ENV
+ * M5UnitUnified: https://github.com/m5stack/M5UnitUnified
  */
 
-#include <M5GFX.h>
-#include "M5UnitENV.h"
+#include <M5Unified.h>
+#include <Wire.h>
+#include <M5UnitUnified.h>
+#include <M5UnitUnifiedENV.h>
 #include <WiFi.h>
 #include <WebServer.h>
 #include <SPIFFS.h>
 #include <FS.h>
+#include <esp_heap_caps.h>
 
-SHT3X sht3x;
-QMP6988 qmp;
+#include "air_quality.h"
+#include "chart.h"
+#include "fusion.h"
+#include "low_power.h"
+#include "qr.h"
+#include "recent.h"
+#include "render.h"
+#include "screens.h"
+#include "trend.h"
 
-M5GFX display;
+// ENV III: SHT30 + QMP6988 on Port A, both in hardware periodic mode
+m5::unit::UnitUnified Units;
+m5::unit::UnitSHT30 sht30;
+m5::unit::UnitQMP6988 qmp;
+
+const uint32_t I2C_CLOCK   = 400000U;
+const uint8_t  PIN_I2C_SDA = 2;
+const uint8_t  PIN_I2C_SCL = 1;
+
+// Number of periodic samples each component may buffer between drains
+const uint32_t SENSOR_STORED_SIZE = 8;
+
+#if BME688_BSEC
+// Optional BME688 (ENV Pro) on the same Port A bus, driven by BSEC2
+const uint8_t BME688_ADDRESS = 0x77;
+#endif
+
+// Per-sensor corrections for the fused temperature/RH, added to each
+// sensor's reading; tune against a reference hygrometer
+const float SHT30_TEMP_OFFSET  = 0.0f;
+const float SHT30_RH_OFFSET    = 0.0f;
+const float BME688_TEMP_OFFSET = 0.0f;
+const float BME688_RH_OFFSET   = 0.0f;
+
+enum { FUSION_SHT30, FUSION_BME688, FUSION_COUNT };
+FusionSensor fusionSensors[FUSION_COUNT];
+FusionInput fusionInputs[FUSION_COUNT];
+
+#if I2C_TRACE
+// Port A traffic of both sensors, dumped on serial 't' for host replay
+auto i2cTrace = std::make_shared<m5::unit::I2CTrace>(2048);
+#endif
+
+M5GFX& display = M5.Display;
 M5Canvas canvas(&display);
 
-const char* DATA_FILE   = "/sensor_data.bin";
-const char* MINMAX_FILE = "/minmax.bin";
+#if BME688_BSEC
+// Records with the IAQ channels; a log written without them is
+// converted once at boot (migrateDataFile)
+const char* DATA_FILE        = "/sensor_data_aq.bin";
+const char* LEGACY_DATA_FILE = "/sensor_data.bin";
+#else
+const char* DATA_FILE        = "/sensor_data.bin";
+#endif
+const char* MINMAX_FILE      = "/minmax.bin";
+const char* QR_FILE          = "/qr.bin";
 
 // *** WiFi AP ***
 const char* ssid     = "AtomS3-RH-Sensor";
 const char* password = "12345678";
 
+// *** Low-power logging mode (opt-in) ***
+// Light-sleeps between samples, display off and AP off until the
+// button is pressed. The AP then stays up for LP_AP_AWAKE_MS.
+const bool LOW_POWER_MODE          = false;
+const uint32_t LP_WAKE_INTERVAL_MS = 30000UL;
+const uint32_t LP_AP_AWAKE_MS      = 5 * 60000UL;
+const uint8_t  PIN_BUTTON          = 41;
+
+bool apActive = false;
+unsigned long apStartedAt = 0;
+
+// QR modules for the AP screen. The URL code is loaded from QR_FILE or
+// encoded once; the WiFi code holds the password, so it stays in RAM.
+QrCache qrCache;
+QrBitmap qrWifi;
+
 // RH threshold for alert
 const int RH_THRESHOLD = 50;
 
@@ -49,8 +117,25 @@ struct DataPoint {
     float temperature;
     float pressure;
     unsigned long timestamp; // Minutes since boot (ikke brugt direkte)
+#if BME688_BSEC
+    // BME688 channels, NAN when it is missing or still warming up.
+    // Only in this build: without them a record stays 16 bytes.
+    float iaq;
+    float voc;               // ppm
+    float co2eq;             // ppm
+#endif
 };
 
+#if BME688_BSEC
+// Record layout of LEGACY_DATA_FILE
+struct LegacyDataPoint {
+    float humidity;
+    float temperature;
+    float pressure;
+    unsigned long timestamp;
+};
+#endif
+
 // Min/Max tracking
 struct MinMax {
     float minHumidity   = 999.0;
@@ -63,6 +148,22 @@ struct MinMax {
 
 MinMax minMaxValues;
 
+Reading current;
+// Sensors that went into the last fused temperature/RH
+size_t fusedSources = 0;
+// Some sensor supplied the RH in current; false before the first sample
+// and while the SHT30 is detached (and no BME688 fills in)
+bool humidityLive = false;
+// Same for the temperature in current
+bool temperatureLive = false;
+
+// When the recent window (recent.cpp) was last fed
+unsigned long lastRecentTime = 0;
+
+// Button toggles between the big RH number and the trend view
+bool showTrend = false;
+bool buttonWake = false;
+
 // Web server on port 80
 WebServer server(80);
 
@@ -70,11 +171,13 @@ WebServer server(80);
 // HTML: Forside /
 // -------------------------------------------------------------------
 void handleRoot() {
-    int humidity      = (int)sht3x.humidity;
-    float temperature = sht3x.cTemp;
-    float pressure    = qmp.pressure / 100.0; // Pa -> mbar
-    bool isAlert      = (humidity >= RH_THRESHOLD);
-    String bgColor    = isAlert ? "#cc0000" : "#1a1a1a";
+    // As on the display: a sensor that is gone shows "--", not its last value
+    int humidity       = (int)current.humidity;
+    String rhText      = humidityLive ? String(humidity) : String("--");
+    String tempText    = temperatureLive ? String(current.temperature, 1) : String("--");
+    String pressText   = Units.isAttached(qmp) ? String(current.pressure, 1) : String("--");
+    bool isAlert       = humidityLive && (humidity >= RH_THRESHOLD);
+    String bgColor     = isAlert ? "#cc0000" : "#1a1a1a";
     
     String html = "<!DOCTYPE html><html><head>";
     html += "<meta charset='UTF-8'>";
@@ -93,9 +196,15 @@ void handleRoot() {
     html += "</head><body>";
     html += "<div class='container'>";
     html += "<div class='label'>Relative Humidity</div>";
-    html += "<div class='rh-value'>" + String(humidity) + "%</div>";
-    html += "<div class='other-values'>Temperature: " + String(temperature, 1) + " °C</div>";
-    html += "<div class='other-values'>Pressure: " + String(pressure, 1) + " mbar</div>";
+    html += "<div class='rh-value'>" + rhText + "%</div>";
+    html += "<div class='other-values'>Temperature: " + tempText + " °C</div>";
+    html += "<div class='other-values'>Pressure: " + pressText + " mbar</div>";
+#if BME688_BSEC
+    if (!isnan(airQuality.iaq)) {
+        html += "<div class='other-values'>IAQ: " + String(airQuality.iaq, 0) + " (accuracy " + String(airQuality.accuracy) + ")</div>";
+        html += "<div class='other-values'>VOC: " + String(airQuality.voc, 2) + " ppm, CO2eq: " + String(airQuality.co2eq, 0) + " ppm</div>";
+    }
+#endif
     html += "<div style='margin-top: 30px; font-size: 20px; color: #888;'>Recorded Min/Max</div>";
     html += "<div class='other-values' style='font-size: 18px;'>RH: " + String(minMaxValues.minHumidity, 1) + "% - " + String(minMaxValues.maxHumidity, 1) + "%</div>";
     html += "<div class='other-values' style='font-size: 18px;'>Temp: " + String(minMaxValues.minTemperature, 1) + "°C - " + String(minMaxValues.maxTemperature, 1) + "°C</div>";
@@ -134,6 +243,7 @@ void handleHistory() {
     html += "<div class='chart-container'><h2>Humidity (%)</h2><canvas id='chart1'></canvas></div>";
     html += "<div class='chart-container'><h2>Temperature (°C)</h2><canvas id='chart2'></canvas></div>";
     html += "<div class='chart-container'><h2>Pressure (mbar)</h2><canvas id='chart3'></canvas></div>";
+    html += "<div class='chart-container' id='aq' style='display:none'><h2>IAQ</h2><canvas id='chart4'></canvas></div>";
     html += "<script>";
     // JS-konstant med samme interval som i C++
     html += "const SAMPLE_INTERVAL_MIN=" + String(SAMPLE_INTERVAL_MIN) + ";";
@@ -209,6 +319,12 @@ void handleHistory() {
     html += "  drawChart('chart1',hum,'rgb(75,192,192)','Humidity');";
     html += "  drawChart('chart2',tmp,'rgb(255,99,132)','Temperature');";
     html += "  drawChart('chart3',prs,'rgb(255,205,86)','Pressure');";
+    // Only records logged with a BME688 carry IAQ
+    html += "  const iaq=data.filter(d=>d.iaq!==undefined).map(d=>d.iaq);";
+    html += "  if(iaq.length){";
+    html += "    document.getElementById('aq').style.display='block';";
+    html += "    drawChart('chart4',iaq,'rgb(153,102,255)','IAQ');";
+    html += "  }";
     html += "}).catch(e=>{";
     html += "  document.getElementById('loading').textContent='Error loading data: '+e;";
     html += "});";
@@ -227,7 +343,11 @@ void handleCSV() {
     server.setContentLength(CONTENT_LENGTH_UNKNOWN);
     server.send(200, "text/csv", "");
 
+#if BME688_BSEC
+    server.sendContent("Minutes Ago,Humidity (%),Temperature (°C),Pressure (mbar),IAQ,VOC (ppm),CO2eq (ppm)\n");
+#else
     server.sendContent("Minutes Ago,Humidity (%),Temperature (°C),Pressure (mbar)\n");
+#endif
     
     File file = SPIFFS.open(DATA_FILE, "r");
     if (file) {
@@ -242,7 +362,7 @@ void handleCSV() {
             unsigned long minutesAgo = (unsigned long)(totalPoints - 1 - index) * SAMPLE_INTERVAL_MIN;
 
             String line;
-            line.reserve(64);
+            line.reserve(96);
             line  = String(minutesAgo);
             line += ",";
             line += String(dp.humidity, 1);
@@ -250,6 +370,15 @@ void handleCSV() {
             line += String(dp.temperature, 1);
             line += ",";
             line += String(dp.pressure, 1);
+#if BME688_BSEC
+            // Empty cells when the BME688 had no value
+            line += ",";
+            if (!isnan(dp.iaq)) line += String(dp.iaq, 0);
+            line += ",";
+            if (!isnan(dp.voc)) line += String(dp.voc, 2);
+            line += ",";
+            if (!isnan(dp.co2eq)) line += String(dp.co2eq, 0);
+#endif
             line += "\n";
 
             server.sendContent(line);
@@ -290,13 +419,28 @@ void handleData() {
             first = false;
 
             String json;
-            json.reserve(80);
+            json.reserve(128);
             json  = "{\"humidity\":";
             json += String(dp.humidity, 1);
             json += ",\"temperature\":";
             json += String(dp.temperature, 1);
             json += ",\"pressure\":";
             json += String(dp.pressure, 1);
+#if BME688_BSEC
+            // BME688 channels only when logged (JSON has no NAN)
+            if (!isnan(dp.iaq)) {
+                json += ",\"iaq\":";
+                json += String(dp.iaq, 0);
+            }
+            if (!isnan(dp.voc)) {
+                json += ",\"voc\":";
+                json += String(dp.voc, 2);
+            }
+            if (!isnan(dp.co2eq)) {
+                json += ",\"co2eq\":";
+                json += String(dp.co2eq, 0);
+            }
+#endif
             json += "}";
 
             server.sendContent(json);
@@ -309,6 +453,215 @@ void handleData() {
     server.sendContent("");
 }
 
+// -------------------------------------------------------------------
+// PNG chart: /chart.png?ch=humidity&span=24h
+// Rendered on the device, cached until the next logged sample
+// -------------------------------------------------------------------
+void handleChart() {
+    ChartChannel ch = CHART_HUMIDITY;
+    if (server.hasArg("ch") && !chartParseChannel(server.arg("ch").c_str(), &ch)) {
+        server.send(400, "text/plain", "ch must be humidity, temperature or pressure");
+        return;
+    }
+
+    const uint32_t maxSpan = (uint32_t)MAX_DATA_POINTS * SAMPLE_INTERVAL_MIN;
+    uint32_t span = 24 * 60;
+    if (server.hasArg("span")) {
+        span = chartParseSpan(server.arg("span").c_str());
+        if (span < SAMPLE_INTERVAL_MIN) {
+            server.send(400, "text/plain", "span must be e.g. 90, 6h or 2d");
+            return;
+        }
+    }
+    if (span > maxSpan) span = maxSpan;
+
+    size_t len = 0;
+    const uint8_t* png = chartCached(ch, span, &len);
+    if (!png) {
+        int wanted = span / SAMPLE_INTERVAL_MIN;
+        float* values = new float[wanted];
+        int n = 0;
+
+        File file = SPIFFS.open(DATA_FILE, "r");
+        if (file) {
+            int totalPoints = file.size() / sizeof(DataPoint);
+            int startIndex  = totalPoints > wanted ? totalPoints - wanted : 0;
+            file.seek(startIndex * sizeof(DataPoint));
+
+            DataPoint dp;
+            while (n < wanted && file.available() >= (int)sizeof(DataPoint)) {
+                file.read((uint8_t*)&dp, sizeof(DataPoint));
+                values[n++] = ch == CHART_HUMIDITY    ? dp.humidity
+                            : ch == CHART_TEMPERATURE ? dp.temperature
+                                                      : dp.pressure;
+            }
+            file.close();
+        }
+
+        png = chartRender(ch, span, values, n, &len);
+        delete[] values;
+    }
+
+    if (!png) {
+        server.send(503, "text/plain", "Out of memory");
+        return;
+    }
+    server.send_P(200, "image/png", (PGM_P)png, len);
+}
+
+// -------------------------------------------------------------------
+// Stats (JSON)
+// -------------------------------------------------------------------
+void handleStats() {
+    String json;
+    json.reserve(512);
+    json  = "{\"lowPower\":";
+    json += LOW_POWER_MODE ? "true" : "false";
+    json += ",\"sleeps\":";
+    json += String(lowPowerStats.sleeps);
+    json += ",\"timerWakes\":";
+    json += String(lowPowerStats.timerWakes);
+    json += ",\"buttonWakes\":";
+    json += String(lowPowerStats.buttonWakes);
+    json += ",\"dutyCycle\":";
+    json += String(lowPowerStats.dutyCycle(), 4);
+    json += ",\"wakeLatencyUs\":{\"last\":";
+    json += String(lowPowerStats.lastLatencyUs);
+    json += ",\"avg\":";
+    json += String(lowPowerStats.avgLatencyUs());
+    json += ",\"max\":";
+    json += String(lowPowerStats.maxLatencyUs);
+    json += "},\"render\":{\"framesPushed\":";
+    json += String(renderStats.framesPushed);
+    json += ",\"framesSkipped\":";
+    json += String(renderStats.framesSkipped);
+    json += ",\"rectsPushed\":";
+    json += String(renderStats.rectsPushed);
+    json += ",\"bytesPushed\":";
+    json += String((double)renderStats.bytesPushed, 0);
+    json += ",\"glyphHits\":";
+    json += String(renderGlyphCache().getHitCount());
+    json += ",\"glyphMisses\":";
+    json += String(renderGlyphCache().getMissCount());
+    json += ",\"glyphBytes\":";
+    json += String(renderGlyphCache().getUsedBytes());
+    // DMA push of the last frame: CPU time in the push call, transfer
+    // time and how much of it the CPU was free
+    json += ",\"dma\":{\"backBuffer\":";
+    json += canvas.hasBackBuffer() ? "true" : "false";
+    json += ",\"pushUs\":";
+    json += String(canvas.getDMAPushStats().push_us);
+    json += ",\"transferUs\":";
+    json += String(canvas.getDMAPushStats().transfer_us);
+    json += ",\"savedUs\":";
+    json += String(canvas.getDMAPushStats().saved_us);
+    json += ",\"totalSavedMs\":";
+    json += String((double)(canvas.getDMAPushStats().total_saved_us / 1000), 0);
+    json += "}";
+    json += "},\"chart\":{\"renders\":";
+    json += String(chartStats.renders);
+    json += ",\"cacheHits\":";
+    json += String(chartStats.cacheHits);
+    json += ",\"lastRenderUs\":";
+    json += String(chartStats.lastRenderUs);
+    json += ",\"lastEncodeUs\":";
+    json += String(chartStats.lastEncodeUs);
+    json += ",\"lastBytes\":";
+    json += String(chartStats.lastBytes);
+    json += ",\"failedRenders\":";
+    json += String(chartStats.failedRenders);
+    json += "},\"qr\":{\"cacheHit\":";
+    json += qrStats.cacheHit ? "true" : "false";
+    json += ",\"buildUs\":";
+    json += String(qrStats.buildUs);
+    json += ",\"drawUs\":";
+    json += String(qrStats.drawUs);
+    json += ",\"bootReadyMs\":";
+    json += String(qrStats.bootReadyMs);
+    json += "},\"sensors\":{\"sht30\":";
+    json += Units.isAttached(sht30) ? "true" : "false";
+    json += ",\"qmp6988\":";
+    json += Units.isAttached(qmp) ? "true" : "false";
+    json += ",\"fused\":";
+    json += String(fusedSources);
+#if BME688_BSEC
+    // BSEC runs are made on its own deadline; late is how far past it
+    json += ",\"bme688\":{\"ready\":";
+    json += airQualityReady() ? "true" : "false";
+    json += ",\"fresh\":";
+    json += airQualityFresh() ? "true" : "false";
+    json += ",\"iaqAccuracy\":";
+    json += String(airQuality.accuracy);
+    json += ",\"runs\":";
+    json += String(airQualityStats.runs);
+    json += ",\"samples\":";
+    json += String(airQualityStats.samples);
+    json += ",\"errors\":";
+    json += String(airQualityStats.errors);
+    json += ",\"lastLateMs\":";
+    json += String(airQualityStats.lastLateMs);
+    json += ",\"maxLateMs\":";
+    json += String(airQualityStats.maxLateMs);
+    json += "}";
+#endif
+    // Port A errors, latency histogram and current clock per bus/unit
+    json += "},\"i2c\":";
+    json += Units.healthJSON().c_str();
+    // Canvas, chart sprite and PNG compressor all need contiguous blocks
+    json += ",\"heap\":{\"free\":";
+    json += String(ESP.getFreeHeap());
+    json += ",\"largestBlock\":";
+    json += String(heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    json += "}}";
+
+    server.send(200, "application/json", json);
+}
+
+#if LGFX_PROFILER
+// -------------------------------------------------------------------
+// M5GFX profiler: calls, time and bus bytes per drawing primitive
+// -------------------------------------------------------------------
+void handleProfile() {
+    static char buf[1024];
+    lgfx::Profiler::printJson(buf, sizeof(buf));
+    server.send(200, "application/json", buf);
+    if (server.hasArg("reset")) {
+        lgfx::Profiler::reset();
+    }
+}
+
+void dumpProfile() {
+    static char buf[1024];
+    lgfx::Profiler::printTo(buf, sizeof(buf));
+    Serial.print(buf);
+}
+#endif
+
+#if I2C_TRACE
+// -------------------------------------------------------------------
+// I2C trace: load the dump with I2CTrace::fromString and replay it
+// through I2CReplayImpl to run the sensor read paths off-target
+// -------------------------------------------------------------------
+bool addSensor(m5::unit::Component& u) {
+    return Units.add(u, new m5::unit::I2CRecordImpl(
+        new m5::unit::AdapterI2C::WireImpl(Wire, u.address(), I2C_CLOCK), i2cTrace));
+}
+
+// One line at a time; a full trace as one string would need ~70 KB
+void dumpI2CTrace() {
+    Serial.print(m5::unit::I2CTrace::textHeader());
+    for (auto&& e : i2cTrace->entries()) {
+        Serial.print(m5::unit::I2CTrace::toString(e).c_str());
+    }
+    Serial.printf("# %u entries, %u dropped\n", (unsigned)i2cTrace->size(), (unsigned)i2cTrace->dropped());
+    i2cTrace->clear();
+}
+#else
+bool addSensor(m5::unit::Component& u) {
+    return Units.add(u, Wire);
+}
+#endif
+
 // -------------------------------------------------------------------
 // Clear data
 // -------------------------------------------------------------------
@@ -323,6 +676,12 @@ void handleClear() {
     minMaxValues.minPressure    = 9999.0;
     minMaxValues.maxPressure    = 0.0;
     
+    recent.clear();
+    chartInvalidate();
+    if (showTrend) {
+        trendShow();
+    }
+    
     if (dataCleared || minMaxCleared) {
         Serial.println("All data and min/max cleared");
         server.send(200, "text/plain", "Data cleared");
@@ -354,6 +713,52 @@ void saveMinMax() {
     }
 }
 
+// -------------------------------------------------------------------
+// QR codes for the AP screen: encode the WiFi code, load the URL code
+// from flash and encode it only on a key miss
+// -------------------------------------------------------------------
+bool prepareQrCodes(const char* url) {
+    uint32_t key = qrCacheKey(url);
+    uint32_t t0  = micros();
+
+    char wifiText[256];
+    if (!qrWifiText(wifiText, sizeof(wifiText), ssid, password) ||
+        !qrEncode(wifiText, &qrWifi)) {
+        Serial.println("QR: SSID/password too long");
+        return false;
+    }
+
+    if (!qrCache.valid(key)) {
+        File file = SPIFFS.open(QR_FILE, "r");
+        if (file) {
+            if (file.size() == sizeof(QrCache)) {
+                file.read((uint8_t*)&qrCache, sizeof(QrCache));
+            }
+            file.close();
+        }
+    }
+
+    qrStats.cacheHit = qrCache.valid(key);
+    if (!qrStats.cacheHit) {
+        if (!qrBuild(&qrCache, key, url)) {
+            Serial.println("QR: URL too long");
+            return false;
+        }
+        // Also replaces a "QRC1" file from older firmware, which held the
+        // WiFi code and with it the password
+        File file = SPIFFS.open(QR_FILE, "w");
+        if (file) {
+            file.write((uint8_t*)&qrCache, sizeof(QrCache));
+            file.close();
+        }
+    }
+    qrStats.buildUs = micros() - t0;
+
+    Serial.printf("QR URL %s, WiFi encoded, %lu us\n", qrStats.cacheHit ? "loaded" : "encoded",
+                  (unsigned long)qrStats.buildUs);
+    return true;
+}
+
 // -------------------------------------------------------------------
 // Update min/max
 // -------------------------------------------------------------------
@@ -399,6 +804,11 @@ void saveDataPoint(float humidity, float temperature, float pressure) {
     dp.temperature = temperature;
     dp.pressure    = pressure;
     dp.timestamp   = millis() / 60000UL; // Minutes since boot
+#if BME688_BSEC
+    dp.iaq         = airQuality.iaq;
+    dp.voc         = airQuality.voc;
+    dp.co2eq       = airQuality.co2eq;
+#endif
     
     int count = 0;
     File file = SPIFFS.open(DATA_FILE, "r");
@@ -432,6 +842,7 @@ void saveDataPoint(float humidity, float temperature, float pressure) {
     if (file) {
         file.write((uint8_t*)&dp, sizeof(DataPoint));
         file.close();
+        chartInvalidate();
         Serial.println("Data point saved: RH=" + String(humidity) + "% T=" + String(temperature) + "°C P=" + String(pressure) + "mbar");
         updateMinMax(humidity, temperature, pressure);
     } else {
@@ -439,37 +850,278 @@ void saveDataPoint(float humidity, float temperature, float pressure) {
     }
 }
 
+#if BME688_BSEC
+// -------------------------------------------------------------------
+// Convert a log written without the IAQ channels, once.
+// Everything goes to a temp file first; the old log is only removed
+// after the new one is complete and in place. The current log is moved
+// aside, never deleted, until the converted one has replaced it.
+// -------------------------------------------------------------------
+void migrateDataFile() {
+    const char* TEMP_FILE  = "/migrate.bin";
+    const char* ASIDE_FILE = "/migrate_cur.bin";
+
+    // An earlier attempt stopped inside the swap at the end
+    if (SPIFFS.exists(ASIDE_FILE)) {
+        if (!SPIFFS.exists(TEMP_FILE)) {
+            // The converted log already got in place
+            SPIFFS.remove(LEGACY_DATA_FILE);
+            SPIFFS.remove(ASIDE_FILE);
+            return;
+        }
+        if (SPIFFS.exists(DATA_FILE) || !SPIFFS.rename(ASIDE_FILE, DATA_FILE)) {
+            // Records in more than one file: keep them all rather than guess
+            Serial.println("Data file migration: leftover files kept, not migrating");
+            return;
+        }
+    }
+
+    File oldFile = SPIFFS.open(LEGACY_DATA_FILE, "r");
+    if (!oldFile) return;
+
+    // Records logged since a failed attempt go after the old ones
+    File curFile = SPIFFS.open(DATA_FILE, "r");
+    size_t oldCount = oldFile.size() / sizeof(LegacyDataPoint);
+    size_t curCount = curFile ? curFile.size() / sizeof(DataPoint) : 0;
+    size_t skip = oldCount + curCount > (size_t)MAX_DATA_POINTS
+                ? std::min(oldCount, oldCount + curCount - MAX_DATA_POINTS) : 0;
+
+    File newFile = SPIFFS.open(TEMP_FILE, "w");
+    bool ok = (bool)newFile;
+    size_t written = 0;
+
+    LegacyDataPoint old;
+    for (size_t i = 0; ok && i < oldCount; i++) {
+        ok = oldFile.read((uint8_t*)&old, sizeof(old)) == sizeof(old);
+        if (!ok || i < skip) continue;
+        DataPoint dp;
+        dp.humidity    = old.humidity;
+        dp.temperature = old.temperature;
+        dp.pressure    = old.pressure;
+        dp.timestamp   = old.timestamp;
+        dp.iaq = dp.voc = dp.co2eq = NAN;
+        ok = newFile.write((uint8_t*)&dp, sizeof(dp)) == sizeof(dp);
+        written += ok;
+    }
+    DataPoint dp;
+    for (size_t i = 0; ok && i < curCount; i++) {
+        ok = curFile.read((uint8_t*)&dp, sizeof(dp)) == sizeof(dp) &&
+             newFile.write((uint8_t*)&dp, sizeof(dp)) == sizeof(dp);
+        written += ok;
+    }
+
+    oldFile.close();
+    if (curFile) curFile.close();
+    if (newFile) newFile.close();
+
+    // Flash full or a short write: keep the old log, try again next boot
+    const size_t expected = oldCount - skip + curCount;
+    if (ok) {
+        File check = SPIFFS.open(TEMP_FILE, "r");
+        ok = check && check.size() == expected * sizeof(DataPoint);
+        if (check) check.close();
+    }
+    if (!ok || written != expected) {
+        SPIFFS.remove(TEMP_FILE);
+        Serial.println("Data file migration failed, old log kept");
+        return;
+    }
+
+    const bool hadCur = SPIFFS.exists(DATA_FILE);
+    if (hadCur && !SPIFFS.rename(DATA_FILE, ASIDE_FILE)) {
+        SPIFFS.remove(TEMP_FILE);
+        Serial.println("Data file migration: rename failed, old log kept");
+        return;
+    }
+    if (!SPIFFS.rename(TEMP_FILE, DATA_FILE)) {
+        // Put the current log back; if even that fails, the next boot
+        // finds it aside with the converted copy and keeps both
+        if (!hadCur || SPIFFS.rename(ASIDE_FILE, DATA_FILE)) {
+            SPIFFS.remove(TEMP_FILE);
+        }
+        Serial.println("Data file migration: rename failed, old log kept");
+        return;
+    }
+    SPIFFS.remove(LEGACY_DATA_FILE);
+    SPIFFS.remove(ASIDE_FILE);
+    Serial.printf("Migrated %u data points\n", (unsigned)expected);
+}
+#endif
+
+// -------------------------------------------------------------------
+// Sensor components (periodic mode)
+// -------------------------------------------------------------------
+void configureSensors() {
+    // Both chips measure on their own; update() only fetches when a
+    // new sample is due and queues it in the component's ring buffer.
+    auto sccfg = sht30.component_config();
+    sccfg.clock       = I2C_CLOCK;
+    sccfg.stored_size = SENSOR_STORED_SIZE;
+    sht30.component_config(sccfg);
+
+    // In low-power mode we only look every LP_WAKE_INTERVAL_MS anyway,
+    // so let the sensors run slower as well.
+    auto scfg = sht30.config();
+    scfg.start_periodic = true;
+    scfg.mps            = LOW_POWER_MODE ? m5::unit::sht30::MPS::Half : m5::unit::sht30::MPS::One;
+    scfg.repeatability  = m5::unit::sht30::Repeatability::High;
+    sht30.config(scfg);
+
+    auto qccfg = qmp.component_config();
+    qccfg.clock       = I2C_CLOCK;
+    qccfg.stored_size = SENSOR_STORED_SIZE;
+    qmp.component_config(qccfg);
+
+    auto qcfg = qmp.config();
+    qcfg.start_periodic = true;
+    qcfg.standby        = LOW_POWER_MODE ? m5::unit::qmp6988::Standby::Time4sec
+                                         : m5::unit::qmp6988::Standby::Time1sec;
+    qmp.config(qcfg);
+
+    // Long or noisy Port A cables fail at 400 kHz: halve the bus clock
+    // when transactions fail and probe back up once it has been clean.
+    m5::unit::UnitUnified::clock_policy_t cp{};
+    cp.enabled       = true;
+    cp.min_clock     = 100000U;
+    // SHT30 NACKs a periodic fetch with no new sample; that is not the bus
+    cp.nack_is_error = false;
+    Units.setClockPolicy(cp);
+
+    // Either sensor may be unplugged or plugged in later: probe the
+    // missing one in the background and begin it when it answers.
+    m5::unit::UnitUnified::attach_policy_t ap{};
+    ap.enabled       = true;
+    ap.scan_interval = 1000;
+    Units.setAttachPolicy(ap);
+
+    fusionSensors[FUSION_SHT30].temperatureOffset  = SHT30_TEMP_OFFSET;
+    fusionSensors[FUSION_SHT30].humidityOffset     = SHT30_RH_OFFSET;
+    fusionSensors[FUSION_BME688].temperatureOffset = BME688_TEMP_OFFSET;
+    fusionSensors[FUSION_BME688].humidityOffset    = BME688_RH_OFFSET;
+}
+
+// Drain everything buffered since last call; the newest sample wins.
+// Returns the number of samples consumed.
+size_t drainSensors() {
+    size_t count = 0;
+
+    // Only the newest sample is kept; read it in place and consume the batch
+    auto sv = sht30.view();
+    if (!sv.empty()) {
+        const auto& d = sv[sv.size() - 1];
+        fusionInputs[FUSION_SHT30].humidity    = d.humidity();
+        fusionInputs[FUSION_SHT30].temperature = d.temperature();
+        count += sv.size();
+        sht30.commit(sv);
+    }
+
+    auto qv = qmp.view();
+    if (!qv.empty()) {
+        current.pressure = qv[qv.size() - 1].pressure() / 100.0; // Pa -> mbar
+        count += qv.size();
+        qmp.commit(qv);
+    }
+
+    // A detached SHT30 has nothing current to offer
+    if (!Units.isAttached(sht30)) {
+        fusionInputs[FUSION_SHT30] = FusionInput();
+    }
+#if BME688_BSEC
+    // Only while BSEC keeps producing samples; its last values would
+    // otherwise be averaged in for good
+    if (airQualityFresh()) {
+        fusionInputs[FUSION_BME688].temperature = airQuality.temperature;
+        fusionInputs[FUSION_BME688].humidity    = airQuality.humidity;
+    } else {
+        fusionInputs[FUSION_BME688] = FusionInput();
+    }
+#endif
+
+    FusionOutput fused = fuseTemperatureHumidity(fusionSensors, fusionInputs, FUSION_COUNT);
+    fusedSources = fused.sources;
+    temperatureLive = !isnan(fused.temperature);
+    if (temperatureLive) current.temperature = fused.temperature;
+    humidityLive = !isnan(fused.humidity);
+    if (humidityLive) current.humidity = fused.humidity;
+
+    return count;
+}
+
+// -------------------------------------------------------------------
+// WiFi AP on/off
+// -------------------------------------------------------------------
+void startAccessPoint() {
+    Serial.println("Setting up WiFi Access Point...");
+    display.wakeup();
+    screenApMode();
+    
+    WiFi.mode(WIFI_AP);
+    WiFi.softAP(ssid, password);
+    
+    IPAddress IP = WiFi.softAPIP();
+    Serial.print("AP IP address: ");
+    Serial.println(IP);
+    
+    String url = "http://" + IP.toString() + "/";
+    if (prepareQrCodes(url.c_str())) {
+        uint32_t t0 = micros();
+        screenApQr(qrWifi, qrCache.url, ssid, IP.toString().c_str());
+        qrStats.drawUs = micros() - t0;
+    } else {
+        screenApReady(ssid, IP.toString().c_str());
+    }
+
+    // The info screen replaced whatever view was up
+    showTrend   = false;
+    apActive    = true;
+    apStartedAt = millis();
+}
+
+void stopAccessPoint() {
+    Serial.println("WiFi AP off");
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(WIFI_OFF);
+    apActive = false;
+}
+
 // -------------------------------------------------------------------
 // setup()
 // -------------------------------------------------------------------
 void setup() {
-    Serial.begin(115200);
+    auto cfg = M5.config();
+    cfg.serial_baudrate = 115200;
+    cfg.external_display_value = 0; // Port A belongs to the ENV III
+    M5.begin(cfg);
     
-    display.begin();
     display.setRotation(0);
     display.setBrightness(128);
     
     canvas.createSprite(display.width(), display.height());
-    canvas.setTextColor(WHITE);
-    canvas.setTextSize(2);
-    canvas.fillScreen(BLACK);
-    canvas.setCursor(5, 5);
-    canvas.println("Starting...");
-    canvas.pushSprite(0, 0);
-    
-    if (!qmp.begin(&Wire, QMP6988_SLAVE_ADDRESS_L, 2, 1, 400000U)) {
-        while (1) {
-            Serial.println("Couldn't find QMP6988");  
-            delay(500);
-        }
+    renderBegin(&display, &canvas);
+#if RENDER_BACK_BUFFER
+    if (!canvas.hasBackBuffer()) {
+        Serial.println("No heap for the canvas back buffer, DMA pushes will wait");
     }
+#endif
+    trendBegin(&canvas, RH_THRESHOLD);
+    screensBegin(&canvas);
+    screenStarting();
+    
+    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL, I2C_CLOCK);
+    configureSensors();
 
-    if (!sht3x.begin(&Wire, SHT3X_I2C_ADDR, 2, 1, 400000U)) {
+    if (!addSensor(qmp) || !addSensor(sht30)) {
         while (1) {
-            Serial.println("Couldn't find SHT3X");
+            Serial.println("Couldn't add QMP6988/SHT30");
             delay(500);
         }
     }
+    // A missing sensor is attached by Units.update() once it answers
+    if (!Units.begin()) {
+        Serial.printf("Waiting for sensor: QMP6988:%s SHT30:%s\n",
+                      Units.isAttached(qmp) ? "ok" : "missing",
+                      Units.isAttached(sht30) ? "ok" : "missing");
+    }
 
     if (!SPIFFS.begin(true)) {
         Serial.println("SPIFFS Mount Failed");
@@ -481,86 +1133,167 @@ void setup() {
         Serial.print("Used space: ");
         Serial.print(SPIFFS.usedBytes());
         Serial.println(" bytes");
+#if BME688_BSEC
+        migrateDataFile();
+#endif
         loadMinMax();
     }
 
-    Serial.println("Setting up WiFi Access Point...");
-    canvas.fillScreen(BLACK);
-    canvas.setTextSize(1);
-    canvas.setCursor(5, 5);
-    canvas.println("WiFi AP Mode");
-    canvas.pushSprite(0, 0);
-    
-    WiFi.mode(WIFI_AP);
-    WiFi.softAP(ssid, password);
-    
-    IPAddress IP = WiFi.softAPIP();
-    Serial.print("AP IP address: ");
-    Serial.println(IP);
-    
-    canvas.fillScreen(BLACK);
-    canvas.setTextSize(1);
-    canvas.setCursor(5, 5);
-    canvas.println("WiFi AP Ready");
-    canvas.setCursor(5, 20);
-    canvas.print("SSID: ");
-    canvas.println(ssid);
-    canvas.setCursor(5, 35);
-    canvas.print("IP: ");
-    canvas.println(IP);
-    canvas.setCursor(5, 50);
-    canvas.println("Connect & browse");
-    canvas.pushSprite(0, 0);
+#if BME688_BSEC
+    // Optional: the ENV III keeps working if no BME688 answers
+    if (!airQualityBegin(Wire, BME688_ADDRESS, LOW_POWER_MODE)) {
+        Serial.println("BME688 not found, IAQ disabled");
+    }
+#endif
+
+    if (LOW_POWER_MODE) {
+        WiFi.mode(WIFI_OFF);
+        screenLowPower();
+        lowPowerBegin(PIN_BUTTON);
+    } else {
+        startAccessPoint();
+    }
     
     server.on("/",       handleRoot);
     server.on("/history",handleHistory);
     server.on("/data",   handleData);
     server.on("/csv",    handleCSV);
+    server.on("/stats",  handleStats);
+    server.on("/chart.png", handleChart);
     server.on("/clear",  HTTP_POST, handleClear);
+#if LGFX_PROFILER
+    server.on("/profile", handleProfile);
+#endif
 
     server.begin();
     Serial.println("HTTP server started");
+
+    qrStats.bootReadyMs = millis();
+    Serial.printf("Boot to ready: %lu ms\n", (unsigned long)qrStats.bootReadyMs);
     
     delay(3000);
 }
 
+// -------------------------------------------------------------------
+// RH display
+// -------------------------------------------------------------------
+void drawHumidity() {
+    // The last value would look current; show "--" instead
+    int humidity = humidityLive ? (int)current.humidity : RH_NONE;
+    if (showTrend) {
+        trendHeader(humidity);
+    } else {
+        renderHumidity(humidity, humidity >= RH_THRESHOLD);
+    }
+}
+
+void toggleView() {
+    showTrend = !showTrend;
+    if (showTrend) {
+        trendShow();
+    } else {
+        renderInvalidate();
+    }
+}
+
 // -------------------------------------------------------------------
 // loop()
 // -------------------------------------------------------------------
 void loop() {
-    server.handleClient();
-    
-    if (sht3x.update()) {
-        // OK
+    M5.update();
+
+    // A button wakeup counts as the press, even if the edge was missed
+    bool pressed = M5.BtnA.wasPressed() || buttonWake;
+    buttonWake = false;
+
+    if (pressed) {
+        if (LOW_POWER_MODE && !apActive) {
+            startAccessPoint();
+        } else {
+            toggleView();
+        }
+    }
+
+    if (LOW_POWER_MODE && apActive && millis() - apStartedAt >= LP_AP_AWAKE_MS) {
+        stopAccessPoint();
     }
 
-    if (qmp.update()) {
-        // OK
+    if (apActive) {
+        server.handleClient();
     }
     
+    Units.update();
+#if BME688_BSEC
+    airQualityUpdate();
+#endif
+    drainSensors();
+    
+    // While a sensor is detached its values are stale; keep them out
+    // of the log and the trend until it is back
+    const bool sensorsReady = Units.isAttached(sht30) && Units.isAttached(qmp);
+
     if (millis() - lastLogTime >= LOG_INTERVAL) {
         lastLogTime = millis();
-        saveDataPoint(sht3x.humidity, sht3x.cTemp, qmp.pressure / 100.0);
+        if (sensorsReady) {
+            saveDataPoint(current.humidity, current.temperature, current.pressure);
+        }
     }
     
-    canvas.fillScreen(BLACK);
-    
-    int humidity = (int)sht3x.humidity;
-    char humidityStr[8];
-    snprintf(humidityStr, sizeof(humidityStr), "%d", humidity);
+    if (millis() - lastRecentTime >= RECENT_INTERVAL_MS) {
+        lastRecentTime = millis();
+        if (sensorsReady) {
+            recent.push(current);
+            if (showTrend && (!LOW_POWER_MODE || apActive)) {
+                trendAppend();
+            }
+        }
+    }
     
-    canvas.setTextSize(2);
-    canvas.setFont(&fonts::Font7);
-    canvas.setTextDatum(middle_center);
+    // In low-power mode the panel is off unless the AP is up
+    if (!LOW_POWER_MODE || apActive) {
+        LGFX_PROFILE_SCOPE(lgfx::prof_frame);
+        drawHumidity();
+    }
+
+#if LGFX_PROFILER || I2C_TRACE
+    if (Serial.available()) {
+        const int cmd = Serial.read();
+#if LGFX_PROFILER
+        if (cmd == 'p') {
+            dumpProfile();
+        }
+#endif
+#if I2C_TRACE
+        if (cmd == 't') {
+            dumpI2CTrace();
+        }
+#endif
+    }
+#endif
     
-    if (humidity >= RH_THRESHOLD) {
-        canvas.setTextColor(RED);
+    if (LOW_POWER_MODE && !apActive) {
+        // Nobody can reach the web UI; blank the panel and sleep until
+        // the next batch of samples is due (or the button is pressed).
+        // The last frame's DMA push still holds the panel bus and CS;
+        // finish it before the panel and the CPU go to sleep.
+        canvas.waitPushDMA();
+        display.sleep();
+#if BME688_BSEC
+        // BSEC expects run() on time, so wake for it as well
+        buttonWake = lowPowerSleep(std::min<uint32_t>(LP_WAKE_INTERVAL_MS,
+                                                      std::max<uint32_t>(10, airQualityIdleMillis())));
+#else
+        buttonWake = lowPowerSleep(LP_WAKE_INTERVAL_MS);
+#endif
+        Serial.printf("LP: duty %.2f%%, wake latency %u us (avg %u us)\n",
+                      lowPowerStats.dutyCycle() * 100.0f,
+                      lowPowerStats.lastLatencyUs, lowPowerStats.avgLatencyUs());
     } else {
-        canvas.setTextColor(WHITE);
+        // Wake early when a sensor sample or a BSEC run is due, but never spin
+        uint32_t idle = Units.idleMillis();
+#if BME688_BSEC
+        idle = std::min<uint32_t>(idle, airQualityIdleMillis());
+#endif
+        delay(std::min<uint32_t>(1000, std::max<uint32_t>(10, idle)));
     }
-    
-    canvas.drawString(humidityStr, display.width() / 2, display.height() / 2);
-    canvas.pushSprite(0, 0);
-    
-    delay(1000);
 }
@@ -0,0 +1,94 @@
+#include "qr.h"
+
+#include <string.h>
+
+#include <lgfx/utility/lgfx_qrcode.h>
+
+QrStats qrStats;
+
+uint32_t qrCacheKey(const char* url) {
+    uint32_t h = 2166136261u;
+    for (; *url; ++url) {
+        h ^= (uint8_t)*url;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Append s, escaping the characters the WIFI: scheme reserves
+static bool appendEscaped(char* out, size_t n, size_t* pos, const char* s) {
+    for (; *s; ++s) {
+        if (strchr("\\;,:\"", *s)) {
+            if (*pos + 1 >= n) return false;
+            out[(*pos)++] = '\\';
+        }
+        if (*pos + 1 >= n) return false;
+        out[(*pos)++] = *s;
+    }
+    return true;
+}
+
+static bool append(char* out, size_t n, size_t* pos, const char* s) {
+    size_t len = strlen(s);
+    if (*pos + len >= n) return false;
+    memcpy(out + *pos, s, len);
+    *pos += len;
+    return true;
+}
+
+bool qrWifiText(char* out, size_t n, const char* ssid, const char* password) {
+    if (!n) return false;
+    size_t pos = 0;
+    bool ok = append(out, n, &pos, "WIFI:T:WPA;S:")
+           && appendEscaped(out, n, &pos, ssid)
+           && append(out, n, &pos, ";P:")
+           && appendEscaped(out, n, &pos, password)
+           && append(out, n, &pos, ";;");
+    out[ok ? pos : 0] = '\0';
+    return ok;
+}
+
+bool qrEncode(const char* text, QrBitmap* out) {
+    for (uint8_t version = 1; version <= QR_MAX_VERSION; ++version) {
+        QRCode qrcode;
+        if (0 != lgfx_qrcode_initText(&qrcode, out->bits, version, 0, text)) continue;
+        out->version = version;
+        out->size    = qrcode.size;
+        return true;
+    }
+    out->version = 0;
+    out->size    = 0;
+    return false;
+}
+
+bool qrBuild(QrCache* cache, uint32_t key, const char* url) {
+    cache->magic = 0;
+    if (!qrEncode(url, &cache->url)) {
+        return false;
+    }
+    cache->key   = key;
+    cache->magic = QR_CACHE_MAGIC;
+    return true;
+}
+
+void qrDraw(LovyanGFX* gfx, const QrBitmap& qr, int32_t x, int32_t y, int32_t w) {
+    gfx->startWrite();
+    gfx->fillRect(x, y, w, w, TFT_WHITE);
+    int32_t thickness = qr.size ? w / qr.size : 0;
+    if (thickness) {
+        int32_t offset = (w - qr.size * thickness) >> 1;
+        int32_t dy = y + offset;
+        // One fillRect per run of dark modules instead of one per module
+        for (uint_fast8_t iy = 0; iy < qr.size; ++iy, dy += thickness) {
+            uint_fast8_t ix = 0;
+            while (ix < qr.size) {
+                if (!qr.get(ix, iy)) { ++ix; continue; }
+                uint_fast8_t start = ix;
+                while (++ix < qr.size && qr.get(ix, iy)) {}
+                gfx->fillRect(x + offset + start * thickness, dy,
+                              (ix - start) * thickness, thickness, TFT_BLACK);
+            }
+        }
+    }
+    gfx->endWrite();
+}
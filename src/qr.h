@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <M5GFX.h>
+
+// -------------------------------------------------------------------
+// QR codes for the AP screen (WiFi join + dashboard URL).
+//
+// The dashboard code is encoded once and its packed module bitmap is
+// kept in a QrCache that main.cpp stores in SPIFFS, keyed by a hash of
+// the URL, so later boots load it instead of encoding it. The WiFi
+// code contains the password in clear ("P:<password>"), so it is only
+// ever held in RAM and encoded at boot; nothing derived from the
+// password (not even a hash) is written to flash.
+// Arduino-free so the native env can test and benchmark it.
+// -------------------------------------------------------------------
+
+// Version 10 (57x57) holds 271 bytes at ECC low, enough for a 32 char
+// SSID and 63 char password even when every character is escaped.
+const uint8_t QR_MAX_VERSION = 10;
+const uint8_t QR_MAX_SIZE    = QR_MAX_VERSION * 4 + 17;
+const size_t  QR_MAX_BYTES   = ((size_t)QR_MAX_SIZE * QR_MAX_SIZE + 7) / 8;
+
+// Same bit order as lgfx_qrcode's module buffer: row-major, MSB first,
+// 1 = dark module
+struct QrBitmap {
+    uint8_t version = 0;
+    uint8_t size    = 0; // modules per side, 0 = empty
+    uint8_t bits[QR_MAX_BYTES];
+
+    bool get(uint_fast8_t x, uint_fast8_t y) const {
+        uint32_t offset = y * size + x;
+        return bits[offset >> 3] & (0x80 >> (offset & 7));
+    }
+};
+
+const uint32_t QR_CACHE_MAGIC = 0x32435251; // "QRC2", URL code only
+
+struct QrCache {
+    uint32_t magic = 0;
+    uint32_t key   = 0;
+    QrBitmap url;
+
+    bool valid(uint32_t k) const { return magic == QR_CACHE_MAGIC && key == k; }
+};
+
+struct QrStats {
+    bool     cacheHit = false; // URL code loaded from flash
+    uint32_t buildUs  = 0; // WiFi encode + URL load or encode
+    uint32_t drawUs   = 0;
+    uint32_t bootReadyMs = 0; // setup() start -> AP screen up
+};
+
+extern QrStats qrStats;
+
+// FNV-1a over the URL
+uint32_t qrCacheKey(const char* url);
+
+// "WIFI:T:WPA;S:<ssid>;P:<password>;;" with \ ; , : " escaped.
+// Returns false if it does not fit in n bytes.
+bool qrWifiText(char* out, size_t n, const char* ssid, const char* password);
+
+// Smallest version (ECC low) that holds text; false if none up to
+// QR_MAX_VERSION does
+bool qrEncode(const char* text, QrBitmap* out);
+
+// Encode the URL code into cache and stamp it with key
+bool qrBuild(QrCache* cache, uint32_t key, const char* url);
+
+// Same layout as LGFXBase::qrcode(text, x, y, w) without margin: a w*w
+// white square with the modules centred, each w / size pixels wide
+void qrDraw(LovyanGFX* gfx, const QrBitmap& qr, int32_t x, int32_t y, int32_t w);
@@ -0,0 +1,3 @@
+#include "recent.h"
+
+RecentWindow<Reading, RECENT_SIZE> recent;
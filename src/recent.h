@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+
+// -------------------------------------------------------------------
+// In-memory recent window: the last RECENT_SIZE readings, one every
+// RECENT_INTERVAL_MS, kept in RAM for on-device views.
+// -------------------------------------------------------------------
+
+// Latest values drained from the sensor components
+struct Reading {
+    float humidity    = 0.0;
+    float temperature = 0.0;
+    float pressure    = 0.0; // mbar
+};
+
+// Fixed-size ring, index 0 is the oldest entry
+template <typename T, size_t N>
+struct RecentWindow {
+    T items[N];
+    size_t head  = 0; // next slot to write
+    size_t count = 0;
+
+    void push(const T& v) {
+        items[head] = v;
+        head = (head + 1) % N;
+        if (count < N) count++;
+    }
+
+    const T& at(size_t i) const { return items[(head + N - count + i) % N]; }
+    const T& newest() const { return at(count - 1); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { head = count = 0; }
+
+    static constexpr size_t capacity() { return N; }
+};
+
+// One column per entry on the 128 px wide panel
+const size_t RECENT_SIZE = 128;
+const unsigned long RECENT_INTERVAL_MS = 60000UL;
+
+extern RecentWindow<Reading, RECENT_SIZE> recent;
@@ -0,0 +1,174 @@
+#include "render.h"
+
+#include <algorithm>
+#include <string.h>
+
+RenderStats renderStats;
+
+static LovyanGFX* panel   = nullptr;
+static M5Canvas*  sprite  = nullptr;
+
+static bool     valid     = false;
+static char     lastText[8];
+static uint16_t lastColor = 0;
+static int32_t  lastX = 0, lastY = 0, lastW = 0, lastH = 0;
+
+// A couple of pixels of slack around the text box: datum rounding and
+// the 7-segment glyphs may touch a pixel outside textWidth()/fontHeight().
+static const int32_t PAD = 2;
+
+// Font7 at size 2 is 64x96 px per digit, 12 KiB at 16bpp. Room for a
+// three-digit reading plus the next digit to appear: up to 48 KiB of
+// heap to save ~12 us per changed frame, so only with RENDER_GLYPH_CACHE.
+#if RENDER_GLYPH_CACHE
+static const size_t GLYPH_CACHE_BYTES = 4 * 64 * 96 * 2;
+#else
+static const size_t GLYPH_CACHE_BYTES = 0;
+#endif
+static lgfx::GlyphCache glyphCache;
+
+struct Rect {
+    int32_t x, y, w, h;
+};
+
+static uint32_t bytesPerPixel() {
+    return (sprite->getColorDepth() & lgfx::color_depth_t::bit_mask) >> 3;
+}
+
+static void pushRect(Rect r) {
+    // Clip to the panel
+    if (r.x < 0) { r.w += r.x; r.x = 0; }
+    if (r.y < 0) { r.h += r.y; r.y = 0; }
+    if (r.x + r.w > sprite->width())  r.w = sprite->width()  - r.x;
+    if (r.y + r.h > sprite->height()) r.h = sprite->height() - r.y;
+    if (r.w <= 0 || r.h <= 0) return;
+
+    // pushImage honours the destination clip, so only this rectangle
+    // goes over the bus.
+    panel->setClipRect(r.x, r.y, r.w, r.h);
+    sprite->pushSpriteDMA(0, 0);
+    panel->clearClipRect();
+
+    renderStats.rectsPushed++;
+    renderStats.bytesPushed += (uint64_t)r.w * r.h * bytesPerPixel();
+}
+
+static void redrawRect(const Rect& r, const char* text, int32_t cx, int32_t cy) {
+    sprite->setClipRect(r.x, r.y, r.w, r.h);
+    sprite->fillRect(r.x, r.y, r.w, r.h, BLACK);
+    sprite->drawString(text, cx, cy);
+    sprite->clearClipRect();
+    pushRect(r);
+}
+
+void renderBegin(LovyanGFX* display, M5Canvas* canvas) {
+    panel  = display;
+    sprite = canvas;
+    valid  = false;
+    if (GLYPH_CACHE_BYTES && glyphCache.init(GLYPH_CACHE_BYTES, 8)) {
+        sprite->setGlyphCache(&glyphCache);
+    }
+#if RENDER_BACK_BUFFER
+    // Second canvas buffer: pushes return while DMA sends the frame and
+    // the next one is drawn into the other buffer. Costs another canvas
+    // (32 KB at 128x128 16bpp) of contiguous heap, for a few us per frame
+    // at 1 Hz. Without it pushes just wait for the transfer.
+    sprite->createBackBuffer();
+#endif
+}
+
+const lgfx::GlyphCache& renderGlyphCache() {
+    return glyphCache;
+}
+
+void renderInvalidate() {
+    valid = false;
+}
+
+void renderPushFull() {
+    sprite->pushSpriteDMA(0, 0);
+    renderStats.framesPushed++;
+    renderStats.rectsPushed++;
+    renderStats.bytesPushed += (uint64_t)sprite->width() * sprite->height() * bytesPerPixel();
+    valid = false;
+}
+
+void renderPushRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+    pushRect({ x, y, w, h });
+    renderStats.framesPushed++;
+}
+
+void renderHumidity(int humidity, bool alert) {
+    char text[8];
+    if (humidity == RH_NONE) {
+        strcpy(text, "--");
+        alert = false;
+    } else {
+        snprintf(text, sizeof(text), "%d", humidity);
+    }
+    uint16_t color = alert ? RED : WHITE;
+
+    if (valid && color == lastColor && strcmp(text, lastText) == 0) {
+        renderStats.framesSkipped++;
+        return;
+    }
+
+    sprite->setTextSize(2);
+    sprite->setFont(&fonts::Font7);
+    sprite->setTextDatum(middle_center);
+    // Opaque text (the box is cleared to black anyway) so the glyphs
+    // come from the cache as one blit each
+    sprite->setTextColor(color, BLACK);
+
+    int32_t cx = sprite->width()  / 2;
+    int32_t cy = sprite->height() / 2;
+    int32_t w  = sprite->textWidth(text);
+    int32_t h  = sprite->fontHeight();
+    int32_t x  = cx - w / 2;
+    int32_t y  = cy - h / 2;
+
+    if (!valid) {
+        // Unknown panel contents: full frame
+        sprite->fillScreen(BLACK);
+        sprite->drawString(text, cx, cy);
+        renderPushFull();
+    } else if (color != lastColor || strlen(text) != strlen(lastText) || w != lastW) {
+        // Layout or colour changed: union of old and new text boxes
+        int32_t l = std::min(x, lastX) - PAD;
+        int32_t t = std::min(y, lastY) - PAD;
+        int32_t r = std::max(x + w, lastX + lastW) + PAD;
+        int32_t b = std::max(y + h, lastY + lastH) + PAD;
+        redrawRect({ l, t, r - l, b - t }, text, cx, cy);
+        renderStats.framesPushed++;
+    } else {
+        // Same layout: only the glyph cells whose character changed.
+        // Neighbouring changed cells are merged into one rectangle.
+        size_t len = strlen(text);
+        int32_t cellX = x;
+        int32_t runStart = -1;
+        char prefix[8];
+        for (size_t i = 0; i <= len; ++i) {
+            bool changed = (i < len) && text[i] != lastText[i];
+            if (changed && runStart < 0) {
+                runStart = cellX;
+            } else if (!changed && runStart >= 0) {
+                redrawRect({ runStart - PAD, y - PAD, cellX - runStart + 2 * PAD, h + 2 * PAD }, text, cx, cy);
+                runStart = -1;
+            }
+            if (i < len) {
+                memcpy(prefix, text, i + 1);
+                prefix[i + 1] = 0;
+                cellX = x + sprite->textWidth(prefix);
+            }
+        }
+        renderStats.framesPushed++;
+    }
+
+    strcpy(lastText, text);
+    lastColor = color;
+    lastX = x;
+    lastY = y;
+    lastW = w;
+    lastH = h;
+    valid = true;
+}
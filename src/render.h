@@ -0,0 +1,41 @@
+#pragma once
+
+#include <M5GFX.h>
+
+// -------------------------------------------------------------------
+// Dirty-region renderer for the big RH number.
+//
+// Remembers what is on the panel and only redraws/pushes the glyph
+// cells that changed. Everything that pushes the canvas to the panel
+// should go through here so the counters stay honest. Pushes are DMA
+// transfers (LGFX_Sprite::pushSpriteDMA), double buffered when built
+// with RENDER_BACK_BUFFER and the second buffer could be allocated.
+// -------------------------------------------------------------------
+
+struct RenderStats {
+    uint32_t framesPushed  = 0; // frames that sent anything to the panel
+    uint32_t framesSkipped = 0; // nothing changed, nothing sent
+    uint32_t rectsPushed   = 0;
+    uint64_t bytesPushed   = 0; // pixel payload over SPI
+};
+
+extern RenderStats renderStats;
+
+// Pre-rendered Font7 digits, empty unless built with RENDER_GLYPH_CACHE
+const lgfx::GlyphCache& renderGlyphCache();
+
+void renderBegin(LovyanGFX* display, M5Canvas* canvas);
+
+// Forget what is on the panel (after status screens etc.)
+void renderInvalidate();
+
+// Push the whole canvas and invalidate the RH cache
+void renderPushFull();
+
+// Push one rectangle of the canvas as a frame of its own
+void renderPushRect(int32_t x, int32_t y, int32_t w, int32_t h);
+
+// No reading (sensor missing): shown as "--"
+const int RH_NONE = -1;
+
+void renderHumidity(int humidity, bool alert);
@@ -0,0 +1,76 @@
+#include "screens.h"
+#include "render.h"
+
+static M5Canvas* sprite = nullptr;
+
+void screensBegin(M5Canvas* canvas) {
+    sprite = canvas;
+}
+
+void screenStarting() {
+    sprite->setTextColor(WHITE);
+    sprite->setTextSize(2);
+    sprite->fillScreen(BLACK);
+    sprite->setCursor(5, 5);
+    sprite->println("Starting...");
+    renderPushFull();
+}
+
+void screenLowPower() {
+    sprite->fillScreen(BLACK);
+    sprite->setTextSize(1);
+    sprite->setCursor(5, 5);
+    sprite->println("Low power mode");
+    sprite->setCursor(5, 20);
+    sprite->println("Press for WiFi AP");
+    renderPushFull();
+}
+
+void screenApMode() {
+    sprite->setFont(&fonts::Font0);
+    sprite->fillScreen(BLACK);
+    sprite->setTextColor(WHITE);
+    sprite->setTextDatum(top_left);
+    sprite->setTextSize(1);
+    sprite->setCursor(5, 5);
+    sprite->println("WiFi AP Mode");
+    renderPushFull();
+}
+
+void screenApReady(const char* ssid, const char* ip) {
+    sprite->fillScreen(BLACK);
+    sprite->setTextSize(1);
+    sprite->setCursor(5, 5);
+    sprite->println("WiFi AP Ready");
+    sprite->setCursor(5, 20);
+    sprite->print("SSID: ");
+    sprite->println(ssid);
+    sprite->setCursor(5, 35);
+    sprite->print("IP: ");
+    sprite->println(ip);
+    sprite->setCursor(5, 50);
+    sprite->println("Connect & browse");
+    renderPushFull();
+}
+
+void screenApQr(const QrBitmap& wifi, const QrBitmap& url, const char* ssid, const char* ip) {
+    const int32_t qrSize = 62;
+
+    sprite->fillScreen(BLACK);
+    qrDraw(sprite, wifi, 1, 1, qrSize);
+    qrDraw(sprite, url, 65, 1, qrSize);
+
+    sprite->setFont(&fonts::Font0);
+    sprite->setTextColor(WHITE);
+    sprite->setTextSize(1);
+    sprite->setTextDatum(top_center);
+    sprite->drawString("Join WiFi", 32, 68);
+    sprite->drawString("Dashboard", 96, 68);
+    // Long SSIDs do not fit behind a "SSID: " prefix at 6 px per char
+    sprite->setTextColor(LIGHTGREY);
+    sprite->drawString(ssid, 64, 88);
+    sprite->drawString(ip, 64, 102);
+    sprite->setTextColor(WHITE);
+    sprite->setTextDatum(top_left);
+    renderPushFull();
+}
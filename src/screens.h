@@ -0,0 +1,22 @@
+#pragma once
+
+#include <M5GFX.h>
+
+#include "qr.h"
+
+// -------------------------------------------------------------------
+// Text status screens shown by setup() and the WiFi AP code.
+//
+// Arduino-free so the native env can render them headless; each one
+// draws the whole canvas and pushes it with renderPushFull().
+// -------------------------------------------------------------------
+
+void screensBegin(M5Canvas* canvas);
+
+void screenStarting();
+void screenLowPower();
+void screenApMode();
+void screenApReady(const char* ssid, const char* ip);
+
+// Join QR (left) and dashboard QR (right) with SSID and IP underneath
+void screenApQr(const QrBitmap& wifi, const QrBitmap& url, const char* ssid, const char* ip);
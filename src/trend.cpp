@@ -0,0 +1,92 @@
+#include "trend.h"
+#include "render.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static M5Canvas* sprite = nullptr;
+static int threshold    = 50;
+static int lastHeader   = INT_MIN; // nothing drawn
+
+static const int32_t HEADER_H = 20;
+
+static int32_t plotTop()    { return HEADER_H; }
+static int32_t plotHeight() { return sprite->height() - HEADER_H; }
+
+static int32_t valueToY(float rh) {
+    if (rh < 0)   rh = 0;
+    if (rh > 100) rh = 100;
+    int32_t h = plotHeight();
+    return plotTop() + (h - 1) - (int32_t)lroundf(rh * (h - 1) / 100.0f);
+}
+
+// Draw one column; 'prev' joins it to the previous sample (NAN = none)
+static void drawColumn(int32_t x, float prev, float cur) {
+    sprite->drawFastVLine(x, plotTop(), plotHeight(), BLACK);
+    sprite->drawPixel(x, valueToY(threshold), DARKGREY);
+
+    int32_t y0 = valueToY(cur);
+    int32_t y1 = isnan(prev) ? y0 : valueToY(prev);
+    if (y1 < y0) { int32_t t = y0; y0 = y1; y1 = t; }
+    sprite->drawFastVLine(x, y0, y1 - y0 + 1, cur >= threshold ? RED : CYAN);
+}
+
+static void drawHeader(int humidity) {
+    sprite->fillRect(0, 0, sprite->width(), HEADER_H, BLACK);
+    sprite->setFont(&fonts::Font2);
+    sprite->setTextSize(1);
+    sprite->setTextDatum(middle_left);
+    char text[12];
+    if (humidity == RH_NONE) {
+        sprite->setTextColor(WHITE);
+        strcpy(text, "RH --");
+    } else {
+        sprite->setTextColor(humidity >= threshold ? RED : WHITE);
+        snprintf(text, sizeof(text), "RH %d%%", humidity);
+    }
+    sprite->drawString(text, 4, HEADER_H / 2);
+    lastHeader = humidity;
+}
+
+void trendBegin(M5Canvas* canvas, int rhThreshold) {
+    sprite    = canvas;
+    threshold = rhThreshold;
+}
+
+void trendShow() {
+    sprite->fillScreen(BLACK);
+    sprite->setScrollRect(0, plotTop(), sprite->width(), plotHeight());
+
+    // Newest sample at the right edge
+    int32_t w = sprite->width();
+    size_t n  = recent.size() < (size_t)w ? recent.size() : (size_t)w;
+    size_t first = recent.size() - n;
+    float prev = first ? recent.at(first - 1).humidity : NAN;
+    for (size_t i = 0; i < n; ++i) {
+        float cur = recent.at(first + i).humidity;
+        drawColumn(w - n + i, prev, cur);
+        prev = cur;
+    }
+
+    drawHeader(recent.empty() ? RH_NONE : (int)recent.newest().humidity);
+    renderPushFull();
+}
+
+void trendAppend() {
+    if (recent.empty()) return;
+
+    float cur  = recent.newest().humidity;
+    float prev = recent.size() > 1 ? recent.at(recent.size() - 2).humidity : NAN;
+
+    sprite->scroll(-1, 0);
+    drawColumn(sprite->width() - 1, prev, cur);
+    renderPushRect(0, plotTop(), sprite->width(), plotHeight());
+}
+
+void trendHeader(int humidity) {
+    if (humidity == lastHeader) return;
+    drawHeader(humidity);
+    renderPushRect(0, 0, sprite->width(), HEADER_H);
+}
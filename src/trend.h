@@ -0,0 +1,25 @@
+#pragma once
+
+#include <M5GFX.h>
+#include "recent.h"
+
+// -------------------------------------------------------------------
+// RH trend view: small header with the current value and a sparkline
+// fed from the recent window.
+//
+// Entering the view draws the whole history once; after that each new
+// sample scrolls the plot one column left (canvas.scroll) and draws a
+// single column, so a sample costs O(height) drawing.
+// -------------------------------------------------------------------
+
+void trendBegin(M5Canvas* canvas, int rhThreshold);
+
+// Full redraw from the recent window (on entering the view)
+void trendShow();
+
+// A sample was appended to the recent window
+void trendAppend();
+
+// Update the header value (pushes only the header if it changed);
+// RH_NONE shows "RH --"
+void trendHeader(int humidity);
@@ -0,0 +1,126 @@
+// Host test + benchmark for the /chart.png renderer.
+// Run with: pio test -e native -f native/test_chart
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "chart.h"
+
+// One day of 5-minute samples
+static const size_t N = 288;
+static float values[N];
+
+void setUp() {
+    for (size_t i = 0; i < N; i++) {
+        values[i] = 45.0f + 10.0f * sinf(i * 0.05f);
+    }
+    chartInvalidate();
+}
+
+void tearDown() {}
+
+static uint32_t be32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static bool hasColor(LGFX_Sprite& s, uint32_t rgb) {
+    for (int32_t y = 0; y < s.height(); y++) {
+        for (int32_t x = 0; x < s.width(); x++) {
+            if (s.readPixelRGB(x, y).RGB888() == rgb) return true;
+        }
+    }
+    return false;
+}
+
+void test_parse() {
+    ChartChannel ch;
+    TEST_ASSERT_TRUE(chartParseChannel("pressure", &ch));
+    TEST_ASSERT_EQUAL(CHART_PRESSURE, ch);
+    TEST_ASSERT_FALSE(chartParseChannel("dewpoint", &ch));
+    TEST_ASSERT_EQUAL(90, chartParseSpan("90"));
+    TEST_ASSERT_EQUAL(90, chartParseSpan("90m"));
+    TEST_ASSERT_EQUAL(360, chartParseSpan("6h"));
+    TEST_ASSERT_EQUAL(2880, chartParseSpan("2d"));
+    TEST_ASSERT_EQUAL(0, chartParseSpan("x"));
+    TEST_ASSERT_EQUAL(0, chartParseSpan("5w"));
+}
+
+void test_png_decodes() {
+    size_t len = 0;
+    const uint8_t* png = chartRender(CHART_HUMIDITY, 24 * 60, values, N, &len);
+    TEST_ASSERT_NOT_NULL(png);
+    TEST_ASSERT_GREATER_THAN(33, len);
+    static const uint8_t SIG[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    TEST_ASSERT_EQUAL_MEMORY(SIG, png, 8);
+    TEST_ASSERT_EQUAL(CHART_WIDTH,  be32(png + 16));
+    TEST_ASSERT_EQUAL(CHART_HEIGHT, be32(png + 20));
+
+    // Palette colours survive the round trip
+    LGFX_Sprite out;
+    out.setColorDepth(24);
+    out.createSprite(CHART_WIDTH, CHART_HEIGHT);
+    TEST_ASSERT_TRUE(out.drawPng(png, len, 0, 0));
+    TEST_ASSERT_EQUAL(0x2A2A2Au, out.readPixelRGB(CHART_WIDTH - 1, CHART_HEIGHT - 1).RGB888());
+    TEST_ASSERT_TRUE(hasColor(out, 0x444444u));  // grid
+    TEST_ASSERT_TRUE(hasColor(out, 0x888888u));  // labels
+    TEST_ASSERT_TRUE(hasColor(out, 0x4BC0C0u));  // humidity line
+    TEST_ASSERT_FALSE(hasColor(out, 0xFF6384u)); // not the temperature colour
+}
+
+void test_cache_until_invalidated() {
+    size_t len = 0;
+    TEST_ASSERT_NULL(chartCached(CHART_PRESSURE, 60, &len));
+    const uint8_t* a = chartRender(CHART_PRESSURE, 60, values, 12, &len);
+    TEST_ASSERT_NOT_NULL(a);
+    size_t len2 = 0;
+    TEST_ASSERT_TRUE(chartCached(CHART_PRESSURE, 60, &len2) == a);
+    TEST_ASSERT_EQUAL(len, len2);
+    TEST_ASSERT_NULL(chartCached(CHART_PRESSURE, 120, &len2));
+    TEST_ASSERT_NULL(chartCached(CHART_HUMIDITY, 60, &len2));
+    chartInvalidate();
+    TEST_ASSERT_NULL(chartCached(CHART_PRESSURE, 60, &len2));
+}
+
+void test_empty_series() {
+    size_t len = 0;
+    TEST_ASSERT_NOT_NULL(chartRender(CHART_TEMPERATURE, 60, values, 0, &len));
+    TEST_ASSERT_NOT_NULL(chartRender(CHART_TEMPERATURE, 60, values, 1, &len));
+}
+
+void test_benchmark() {
+    const int RUNS = 50;
+    size_t len = 0;
+    double renderUs = 0, encodeUs = 0;
+    for (int i = 0; i < RUNS; i++) {
+        chartInvalidate();
+        chartRender(CHART_HUMIDITY, 24 * 60, values, N, &len);
+        renderUs += chartStats.lastRenderUs;
+        encodeUs += chartStats.lastEncodeUs;
+    }
+
+    const int HITS = 100000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < HITS; i++) {
+        chartCached(CHART_HUMIDITY, 24 * 60, &len);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%dx%d, %u pts: draw %.0f us, png %.0f us, %u bytes; cached lookup %.3f us",
+             (int)CHART_WIDTH, (int)CHART_HEIGHT, (unsigned)N, renderUs / RUNS, encodeUs / RUNS, (unsigned)len,
+             std::chrono::duration<double, std::micro>(t1 - t0).count() / HITS);
+    TEST_MESSAGE(msg);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_parse);
+    RUN_TEST(test_png_decodes);
+    RUN_TEST(test_cache_until_invalidated);
+    RUN_TEST(test_empty_series);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
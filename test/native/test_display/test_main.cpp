@@ -0,0 +1,304 @@
+// Headless render of the firmware UI: golden-image regression tests and
+// frame-time benchmark for the status screens and the RH views.
+// Run with: pio test -e native -f native/test_display
+// Regenerate the golden images with GOLDEN_UPDATE=1 in the environment.
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "qr.h"
+#include "recent.h"
+#include "render.h"
+#include "screens.h"
+#include "trend.h"
+
+// AtomS3 panel: 128x128, 16bpp
+static const int32_t PANEL_W = 128;
+static const int32_t PANEL_H = 128;
+static const int RH_THRESHOLD = 50;
+
+// The in-memory panel stands in for M5.Display; the canvas is set up
+// the way setup() does it.
+static LGFX_Sprite panel;
+static M5Canvas* canvas = nullptr;
+
+static std::string goldenPath(const char* name) {
+    std::string dir = __FILE__;
+    size_t slash = dir.find_last_of('/');
+    dir = (slash == std::string::npos) ? "test/native/test_display" : dir.substr(0, slash);
+    return dir + "/golden/" + name + ".png";
+}
+
+static bool fileWrite(const void* data, size_t len, void* user) {
+    return fwrite(data, 1, len, (FILE*)user) == len;
+}
+
+static bool savePng(LGFX_Sprite& s, const std::string& path) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = s.writePng(fileWrite, f) > 0;
+    fclose(f);
+    return ok;
+}
+
+static std::vector<uint8_t> readFile(const std::string& path) {
+    std::vector<uint8_t> data;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return data;
+}
+
+// Compare the panel against golden/<name>.png. On mismatch the actual
+// frame is written next to it as <name>.actual.png.
+static void checkGolden(const char* name) {
+    std::string path = goldenPath(name);
+    if (getenv("GOLDEN_UPDATE")) {
+        TEST_ASSERT_TRUE_MESSAGE(savePng(panel, path), path.c_str());
+        return;
+    }
+
+    std::vector<uint8_t> png = readFile(path);
+    TEST_ASSERT_TRUE_MESSAGE(!png.empty(), ("missing " + path).c_str());
+
+    LGFX_Sprite golden;
+    golden.setColorDepth(panel.getColorDepth());
+    TEST_ASSERT_NOT_NULL(golden.createSprite(PANEL_W, PANEL_H));
+    golden.fillScreen(TFT_MAGENTA);
+    TEST_ASSERT_TRUE(golden.drawPng(png.data(), png.size()));
+
+    int32_t diff = 0;
+    for (int32_t y = 0; y < PANEL_H; y++) {
+        for (int32_t x = 0; x < PANEL_W; x++) {
+            if (panel.readPixel(x, y) != golden.readPixel(x, y)) diff++;
+        }
+    }
+    if (diff) {
+        std::string actual = path.substr(0, path.size() - 4) + ".actual.png";
+        savePng(panel, actual);
+        char msg[256];
+        snprintf(msg, sizeof(msg), "%s: %d pixels differ, see %s", name, (int)diff, actual.c_str());
+        TEST_FAIL_MESSAGE(msg);
+    }
+}
+
+static void fillRecent(size_t n) {
+    recent.clear();
+    for (size_t i = 0; i < n; i++) {
+        Reading r;
+        r.humidity    = 48.0f + 12.0f * sinf(i * 0.09f);
+        r.temperature = 21.0f;
+        r.pressure    = 1013.0f;
+        recent.push(r);
+    }
+}
+
+void setUp() {
+    panel.setColorDepth(16);
+    panel.createSprite(PANEL_W, PANEL_H);
+    panel.fillScreen(TFT_MAGENTA);
+
+    // Fresh canvas per test so text state does not leak between scenes
+    delete canvas;
+    canvas = new M5Canvas(&panel);
+    canvas->createSprite(PANEL_W, PANEL_H);
+    renderBegin(&panel, canvas);
+    trendBegin(canvas, RH_THRESHOLD);
+    screensBegin(canvas);
+    renderStats = RenderStats();
+    recent.clear();
+}
+
+void tearDown() {}
+
+// setup() with the AP enabled
+void test_boot_ap() {
+    screenStarting();
+    checkGolden("starting");
+    screenApMode();
+    checkGolden("ap_mode");
+    screenApReady("AtomS3-RH-Sensor", "192.168.4.1");
+    checkGolden("ap_ready");
+
+    static QrBitmap wifiQr;
+    static QrCache qr;
+    char wifi[128];
+    TEST_ASSERT_TRUE(qrWifiText(wifi, sizeof(wifi), "AtomS3-RH-Sensor", "12345678"));
+    TEST_ASSERT_TRUE(qrEncode(wifi, &wifiQr));
+    TEST_ASSERT_TRUE(qrBuild(&qr, 1, "http://192.168.4.1/"));
+    screenApQr(wifiQr, qr.url, "AtomS3-RH-Sensor", "192.168.4.1");
+    checkGolden("ap_qr");
+}
+
+// setup() in low-power mode
+void test_boot_low_power() {
+    screenStarting();
+    screenLowPower();
+    checkGolden("low_power");
+}
+
+// loop(): big number, partial updates, alert colour, width changes,
+// and "--" while the SHT30 is detached
+void test_rh_number() {
+    screenStarting();
+    renderInvalidate();
+    renderHumidity(45, false);
+    checkGolden("rh_45");
+    renderHumidity(46, false);
+    renderHumidity(56, true);
+    checkGolden("rh_56_alert");
+    renderHumidity(100, true);
+    checkGolden("rh_100");
+    renderHumidity(9, false);
+    checkGolden("rh_9");
+    renderHumidity(RH_NONE, true);
+    checkGolden("rh_missing");
+}
+
+// loop(): trend view with scrolling sparkline and header updates
+void test_trend() {
+    fillRecent(90);
+    trendShow();
+    checkGolden("trend");
+    for (int i = 0; i < 5; i++) {
+        Reading r;
+        r.humidity = 55.0f + i;
+        recent.push(r);
+        trendAppend();
+        trendHeader((int)r.humidity);
+    }
+    checkGolden("trend_scrolled");
+}
+
+// Every partial update must leave the panel as a full redraw would
+void test_partial_matches_full() {
+    const int vals[] = { 45, 45, 46, 56, 50, 9, 10, 99, 100, RH_NONE, 51, 49, RH_NONE, 9 };
+    const size_t bytes = PANEL_W * PANEL_H * 2;
+    std::vector<uint8_t> partial(bytes);
+    for (size_t i = 1; i < sizeof(vals) / sizeof(vals[0]); i++) {
+        renderInvalidate();
+        renderHumidity(vals[i - 1], vals[i - 1] >= RH_THRESHOLD);
+        renderHumidity(vals[i], vals[i] >= RH_THRESHOLD);
+        memcpy(partial.data(), panel.getBuffer(), bytes);
+
+        renderInvalidate();
+        renderHumidity(vals[i], vals[i] >= RH_THRESHOLD);
+        TEST_ASSERT_EQUAL_MEMORY(panel.getBuffer(), partial.data(), bytes);
+    }
+}
+
+// pushSpriteDMA flips buffers but the canvas keeps its contents
+void test_double_buffer() {
+#if !RENDER_BACK_BUFFER
+    // renderBegin() only sets one up in RENDER_BACK_BUFFER builds
+    TEST_ASSERT_FALSE(canvas->hasBackBuffer());
+    TEST_ASSERT_NOT_NULL(canvas->createBackBuffer());
+#endif
+    TEST_ASSERT_TRUE(canvas->hasBackBuffer());
+    canvas->resetDMAPushStats();
+
+    canvas->fillScreen(TFT_NAVY);
+    canvas->fillRect(10, 10, 20, 20, TFT_YELLOW);
+    void* before = canvas->getBuffer();
+    canvas->pushSpriteDMA(0, 0);
+    canvas->waitPushDMA();
+    TEST_ASSERT_TRUE(canvas->getBuffer() != before);
+    TEST_ASSERT_EQUAL_MEMORY(panel.getBuffer(), canvas->getBuffer(), PANEL_W * PANEL_H * 2);
+
+    // Drawing after the flip starts from the frame that was sent
+    canvas->fillRect(40, 40, 8, 8, TFT_RED);
+    canvas->pushSpriteDMA(0, 0);
+    TEST_ASSERT_EQUAL(canvas->getBuffer(), before);
+    TEST_ASSERT_EQUAL(0xFFFF00u, panel.readPixelRGB(15, 15).RGB888());
+    TEST_ASSERT_EQUAL(0xFF0000u, panel.readPixelRGB(44, 44).RGB888());
+    TEST_ASSERT_EQUAL_MEMORY(panel.getBuffer(), canvas->getBuffer(), PANEL_W * PANEL_H * 2);
+    TEST_ASSERT_EQUAL(2u, canvas->getDMAPushStats().frames);
+
+    // A clipped push copies only that rectangle into the next buffer
+    canvas->fillRect(61, 70, 9, 5, TFT_GREEN);
+    panel.setClipRect(61, 70, 9, 5);
+    canvas->pushSpriteDMA(0, 0);
+    panel.clearClipRect();
+    TEST_ASSERT_TRUE(canvas->getBuffer() != before);
+    TEST_ASSERT_EQUAL(0x00FF00u, panel.readPixelRGB(65, 72).RGB888());
+    TEST_ASSERT_EQUAL_MEMORY(panel.getBuffer(), canvas->getBuffer(), PANEL_W * PANEL_H * 2);
+
+    // Without a back buffer the push is synchronous and nothing flips
+    canvas->deleteBackBuffer();
+    canvas->createSprite(PANEL_W, PANEL_H);
+    TEST_ASSERT_FALSE(canvas->hasBackBuffer());
+    before = canvas->getBuffer();
+    canvas->fillScreen(TFT_GREEN);
+    canvas->pushSpriteDMA(0, 0);
+    TEST_ASSERT_FALSE(canvas->pushDMABusy());
+    TEST_ASSERT_EQUAL(canvas->getBuffer(), before);
+    TEST_ASSERT_EQUAL_MEMORY(panel.getBuffer(), canvas->getBuffer(), PANEL_W * PANEL_H * 2);
+    TEST_ASSERT_EQUAL(0u, canvas->getDMAPushStats().saved_us);
+}
+
+template <typename F>
+static double usPerFrame(int n, F&& frame) {
+    frame(0);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) frame(i + 1);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+}
+
+static void report(const char* name, double us) {
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%-24s %8.1f us/frame", name, us);
+    TEST_MESSAGE(msg);
+}
+
+void test_benchmark() {
+    const int N = 2000;
+    report("status screen", usPerFrame(N, [](int) {
+        screenApReady("AtomS3-RH-Sensor", "192.168.4.1");
+    }));
+    report("rh full frame", usPerFrame(N, [](int i) {
+        renderInvalidate();
+        renderHumidity(40 + i % 20, false);
+    }));
+    report("rh one digit", usPerFrame(N, [](int i) {
+        renderHumidity(40 + i % 10, false);
+    }));
+    report("rh unchanged", usPerFrame(N, [](int) {
+        renderHumidity(42, false);
+    }));
+    fillRecent(RECENT_SIZE);
+    report("trend full", usPerFrame(N, [](int) {
+        trendShow();
+    }));
+    report("trend append", usPerFrame(N, [](int i) {
+        Reading r;
+        r.humidity = 40.0f + i % 20;
+        recent.push(r);
+        trendAppend();
+        trendHeader((int)r.humidity);
+    }));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_boot_ap);
+    RUN_TEST(test_boot_low_power);
+    RUN_TEST(test_rh_number);
+    RUN_TEST(test_trend);
+    RUN_TEST(test_partial_matches_full);
+    RUN_TEST(test_double_buffer);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
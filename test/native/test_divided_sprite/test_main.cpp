@@ -0,0 +1,187 @@
+// Host test + benchmark for LGFX_Sprite backed by DividedFrameBuffer blocks.
+// Run with: pio test -e native -f native/test_divided_sprite
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+static const int32_t W = 320;
+static const int32_t H = 240;
+
+void setUp() {}
+void tearDown() {}
+
+// Crosses block boundaries on purpose
+static void drawScene(LGFX_Sprite& s) {
+    s.fillScreen(0x202040u);
+    for (int32_t y = 0; y < H; y += 7) {
+        s.drawFastHLine(0, y, W, 0x444444u);
+    }
+    s.drawLine(0, 0, W - 1, H - 1, 0xFF6384u);
+    s.drawLine(0, H - 1, W - 1, 0, 0x4BC0C0u);
+    s.fillCircle(W / 2, H / 2, 50, 0xFFCD56u);
+    s.fillRect(10, 14, 100, 37, 0x00FF00u);
+    s.setFont(&fonts::Font4);
+    s.setTextColor(TFT_WHITE);
+    s.drawString("Divided 123", 20, 100);
+    s.scroll(-3, 5);
+    for (int32_t x = 0; x < W; x++) {
+        s.drawPixel(x, (x * 37) % H, (uint32_t)(x * 0x010203u));
+    }
+}
+
+static bool samePixels(LGFX_Sprite& a, LGFX_Sprite& b) {
+    for (int32_t y = 0; y < H; y++) {
+        for (int32_t x = 0; x < W; x++) {
+            if (a.readPixelValue(x, y) != b.readPixelValue(x, y)) return false;
+        }
+    }
+    return true;
+}
+
+static void checkDepth(int depth) {
+    LGFX_Sprite plain, divided;
+    plain.setColorDepth(depth);
+    divided.setColorDepth(depth);
+    TEST_ASSERT_NOT_NULL(plain.createSprite(W, H));
+    TEST_ASSERT_TRUE(divided.createDividedSprite(W, H, 16));
+    TEST_ASSERT_TRUE(divided.isDivided());
+    TEST_ASSERT_NULL(divided.getBuffer());
+    TEST_ASSERT_EQUAL(15u, divided.getBlockCount());
+    TEST_ASSERT_EQUAL(W, divided.width());
+    TEST_ASSERT_EQUAL(H, divided.height());
+
+    drawScene(plain);
+    drawScene(divided);
+    TEST_ASSERT_TRUE(samePixels(plain, divided));
+
+    // pushSprite, opaque and with a transparent colour
+    LGFX_Sprite a, b;
+    a.setColorDepth(16);
+    b.setColorDepth(16);
+    a.createSprite(W + 20, H + 20);
+    b.createSprite(W + 20, H + 20);
+    plain.pushSprite(&a, 7, 9);
+    divided.pushSprite(&b, 7, 9);
+    TEST_ASSERT_EQUAL_MEMORY(a.getBuffer(), b.getBuffer(), a.bufferLength());
+    plain.pushSprite(&a, -5, 3, 0x202040u);
+    divided.pushSprite(&b, -5, 3, 0x202040u);
+    TEST_ASSERT_EQUAL_MEMORY(a.getBuffer(), b.getBuffer(), a.bufferLength());
+
+    // As a destination
+    a.pushSprite(&plain, -3, -4);
+    a.pushSprite(&divided, -3, -4);
+    TEST_ASSERT_TRUE(samePixels(plain, divided));
+}
+
+void test_rgb332()  { checkDepth(8); }
+void test_rgb565()  { checkDepth(16); }
+void test_rgb888()  { checkDepth(24); }
+
+void test_palette_rejected() {
+    LGFX_Sprite s;
+    s.setColorDepth(4);
+    TEST_ASSERT_FALSE(s.createDividedSprite(W, H, 16));
+    TEST_ASSERT_FALSE(s.isDivided());
+    s.setColorDepth(1);
+    TEST_ASSERT_FALSE(s.createDividedSprite(W, H, 16));
+}
+
+// Switching between storage kinds releases the old one
+void test_recreate() {
+    LGFX_Sprite s;
+    s.setColorDepth(16);
+    TEST_ASSERT_TRUE(s.createDividedSprite(W, H, 32));
+    TEST_ASSERT_EQUAL(8u, s.getBlockCount());
+    TEST_ASSERT_NOT_NULL(s.createSprite(64, 64));
+    TEST_ASSERT_FALSE(s.isDivided());
+    TEST_ASSERT_EQUAL(64, s.width());
+    TEST_ASSERT_TRUE(s.createDividedSprite(W, H, 0)); // 0: one block
+    TEST_ASSERT_EQUAL(1u, s.getBlockCount());
+    s.setColorDepth(24);                              // drops the storage
+    TEST_ASSERT_FALSE(s.isDivided());
+    s.deleteSprite();
+}
+
+struct Sink { std::vector<uint8_t> bytes; };
+static bool sinkWrite(const void* data, size_t len, void* user) {
+    auto s = (Sink*)user;
+    s->bytes.insert(s->bytes.end(), (const uint8_t*)data, (const uint8_t*)data + len);
+    return true;
+}
+
+void test_png_identical() {
+    LGFX_Sprite plain, divided;
+    plain.setColorDepth(16);
+    divided.setColorDepth(16);
+    plain.createSprite(W, H);
+    divided.createDividedSprite(W, H, 16);
+    drawScene(plain);
+    drawScene(divided);
+    Sink a, b;
+    TEST_ASSERT_GREATER_THAN(0, plain.writePng(sinkWrite, &a));
+    TEST_ASSERT_GREATER_THAN(0, divided.writePng(sinkWrite, &b));
+    TEST_ASSERT_EQUAL(a.bytes.size(), b.bytes.size());
+    TEST_ASSERT_EQUAL_MEMORY(a.bytes.data(), b.bytes.data(), a.bytes.size());
+}
+
+template <typename F>
+static double usPer(int n, F&& f) {
+    f();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+}
+
+static void bench(const char* name, LGFX_Sprite& s, size_t largest) {
+    LGFX_Sprite panel;
+    panel.setColorDepth(16);
+    panel.createSprite(W, H);
+    double push = usPer(200, [&] { s.pushSprite(&panel, 0, 0); });
+    double draw = usPer(200, [&] { drawScene(s); });
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%-18s blocks %3u, largest alloc %6u B | pushSprite %6.1f us (%5.0f Mpx/s) | draw %6.1f us",
+             name, (unsigned)s.getBlockCount(), (unsigned)largest, push, W * H / push, draw);
+    TEST_MESSAGE(msg);
+}
+
+void test_benchmark() {
+    const size_t lineBytes = W * 2;
+    LGFX_Sprite plain;
+    plain.setColorDepth(16);
+    plain.createSprite(W, H);
+    bench("contiguous", plain, lineBytes * H);
+
+    const int32_t blockLines[] = { 60, 16, 8, 1 };
+    for (int32_t lines : blockLines) {
+        LGFX_Sprite d;
+        d.setColorDepth(16);
+        d.createDividedSprite(W, H, lines);
+        char name[24];
+        snprintf(name, sizeof(name), "divided %d lines", (int)lines);
+        bench(name, d, lineBytes * lines);
+    }
+
+    // Fragmentation: the biggest free block a 320x240x16bpp canvas needs
+    // to fit in. A heap whose largest free block is 16 KB can still hold
+    // the divided sprite (with 16-line blocks), never the contiguous one.
+    char msg[128];
+    snprintf(msg, sizeof(msg), "largest free block needed: contiguous %u B, divided(16) %u B (%.1f%%)",
+             (unsigned)(lineBytes * H), (unsigned)(lineBytes * 16), 100.0 * 16 / H);
+    TEST_MESSAGE(msg);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_rgb332);
+    RUN_TEST(test_rgb565);
+    RUN_TEST(test_rgb888);
+    RUN_TEST(test_palette_rejected);
+    RUN_TEST(test_recreate);
+    RUN_TEST(test_png_identical);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
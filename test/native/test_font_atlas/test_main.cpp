@@ -0,0 +1,273 @@
+// Host test + benchmark for the LFA font atlas (lgfx::LFAfont).
+// Run with: pio test -e native -f native/test_font_atlas
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../../tools/vlw2lfa/vlw2lfa.hpp"
+
+static const int32_t W = 128;
+static const int32_t H = 128;
+static const char* VLW_PATH = "/tmp/test_font_atlas.vlw";
+
+static std::vector<uint8_t> vlw;
+static std::vector<uint8_t> lfa;
+
+static void be32(std::vector<uint8_t>& v, uint32_t x) {
+    v.push_back(x >> 24);
+    v.push_back(x >> 16);
+    v.push_back(x >> 8);
+    v.push_back(x);
+}
+
+// Synthetic VLW: printable ASCII plus a few codes on other pages, each
+// glyph a distinct anti-aliased pattern so any mix-up changes pixels.
+static std::vector<uint8_t> makeVlw() {
+    std::vector<uint16_t> codes;
+    for (uint16_t c = 0x20; c < 0x7F; c++) codes.push_back(c);
+    codes.push_back(0x00B0);  // degree sign
+    codes.push_back(0x2103);  // degree Celsius
+    codes.push_back(0x3000);  // ideographic space, excluded from metrics
+
+    std::vector<uint8_t> head, glyphs, bitmaps;
+    be32(head, codes.size());
+    be32(head, 11);
+    be32(head, 16);
+    be32(head, 0);
+    be32(head, 12);
+    be32(head, 4);
+    for (uint16_t c : codes) {
+        uint32_t w = (c == 0x20) ? 0 : 4 + c % 7;
+        uint32_t h = (c == 0x20) ? 0 : 6 + c % 9;
+        int32_t dy = 3 + c % 11;
+        int32_t dx = (int32_t)(c % 3) - 1;
+        be32(glyphs, c);
+        be32(glyphs, h);
+        be32(glyphs, w);
+        be32(glyphs, w + 2);
+        be32(glyphs, (uint32_t)dy);
+        be32(glyphs, (uint32_t)dx);
+        be32(glyphs, 0);
+        for (uint32_t y = 0; y < h; y++) {
+            for (uint32_t x = 0; x < w; x++) {
+                uint32_t v = (x * 37 + y * 53 + c * 11) & 0xFF;
+                bitmaps.push_back(v < 64 ? 0 : (v > 200 ? 0xFF : v));
+            }
+        }
+    }
+    head.insert(head.end(), glyphs.begin(), glyphs.end());
+    head.insert(head.end(), bitmaps.begin(), bitmaps.end());
+    return head;
+}
+
+static void setupSprite(M5Canvas& s) {
+    s.setColorDepth(16);
+    s.createSprite(W, H);
+    s.fillScreen(TFT_NAVY);
+}
+
+static void drawSample(M5Canvas& s, float size, bool opaque) {
+    s.fillScreen(TFT_NAVY);
+    s.setTextSize(size);
+    if (opaque) s.setTextColor(TFT_YELLOW, TFT_DARKGREEN);
+    else s.setTextColor(TFT_WHITE);
+    s.setCursor(2, 2);
+    s.print("Temp 23.4\xC2\xB0""C");
+    s.setCursor(2, 40);
+    s.print("RH 45% {x}\xE2\x84\x83\xE3\x80\x80!");
+    s.drawString("qjpg@", 64, 90);
+}
+
+static std::vector<uint16_t> pixels(M5Canvas& s) {
+    auto p = (const uint16_t*)s.getBuffer();
+    return std::vector<uint16_t>(p, p + W * H);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_convert_header() {
+    TEST_ASSERT_TRUE(lgfx::LFAfont::isAtlas(lfa.data()));
+    TEST_ASSERT_FALSE(lgfx::LFAfont::isAtlas(vlw.data()));
+    auto h = (const lgfx::LFAfont::header_t*)lfa.data();
+    TEST_ASSERT_EQUAL(98, h->glyph_count);
+    TEST_ASSERT_EQUAL(3, h->page_count);
+    TEST_ASSERT_EQUAL(lfa.size(), h->file_size);
+    TEST_ASSERT_EQUAL(0, h->glyph_offset % 4);
+}
+
+// LFA must put every pixel exactly where VLW does
+static void checkIdentical(float size, bool opaque) {
+    M5Canvas a, b;
+    setupSprite(a);
+    setupSprite(b);
+    TEST_ASSERT_TRUE(a.loadFont(vlw.data()));
+    TEST_ASSERT_TRUE(b.loadFont(lfa.data()));
+    TEST_ASSERT_EQUAL(lgfx::IFont::ft_vlw, a.getFont()->getType());
+    TEST_ASSERT_EQUAL(lgfx::IFont::ft_lfa, b.getFont()->getType());
+    TEST_ASSERT_EQUAL(a.fontHeight(), b.fontHeight());
+    TEST_ASSERT_EQUAL(a.textWidth("Temp 23.4"), b.textWidth("Temp 23.4"));
+    drawSample(a, size, opaque);
+    drawSample(b, size, opaque);
+    auto pa = pixels(a);
+    TEST_ASSERT_TRUE(pa != std::vector<uint16_t>(W * H, pa[W * H - 1]));
+    TEST_ASSERT_TRUE(pa == pixels(b));
+    a.unloadFont();  // VLW reads through a's own wrapper; release it first
+}
+
+static void test_identical_opaque() { checkIdentical(1, true); }
+static void test_identical_transparent() { checkIdentical(1, false); }
+static void test_identical_scaled() {
+    checkIdentical(2, true);
+    checkIdentical(1.5f, false);
+}
+
+static void test_lookup() {
+    lgfx::LFAfont f;
+    TEST_ASSERT_TRUE(f.setData(lfa.data(), lfa.size()));
+    for (uint16_t c = 0x21; c < 0x7F; c++) {
+        auto g = f.getGlyph(c);
+        TEST_ASSERT_NOT_NULL(g);
+        TEST_ASSERT_EQUAL(c, g->code);
+        TEST_ASSERT_EQUAL(4 + c % 7, g->width);
+    }
+    TEST_ASSERT_EQUAL(0x2103, f.getGlyph(0x2103)->code);
+    TEST_ASSERT_NULL(f.getGlyph(0x7F));
+    TEST_ASSERT_NULL(f.getGlyph(0x2104));
+    TEST_ASSERT_NULL(f.getGlyph(0xFFFF));
+}
+
+// setData reads the atlas in place; nothing is copied
+static void test_zero_copy() {
+    lgfx::LFAfont f;
+    TEST_ASSERT_TRUE(f.setData(lfa.data(), lfa.size()));
+    auto h = (const lgfx::LFAfont::header_t*)lfa.data();
+    auto g = f.getGlyph('A');
+    auto glyph0 = (const lgfx::LFAfont::glyph_t*)(lfa.data() + h->glyph_offset);
+    TEST_ASSERT_TRUE(g >= glyph0 && g < glyph0 + h->glyph_count);
+}
+
+static void test_reject_bad() {
+    lgfx::LFAfont f;
+    TEST_ASSERT_FALSE(f.setData(lfa.data(), lfa.size() - 1));  // truncated
+    TEST_ASSERT_FALSE(f.setData(vlw.data(), vlw.size()));      // not an atlas
+
+    auto bad = lfa;
+    auto h = (lgfx::LFAfont::header_t*)bad.data();
+    auto g = (lgfx::LFAfont::glyph_t*)(bad.data() + h->glyph_offset);
+    g[5].bitmap = h->file_size;  // bitmap past the end
+    TEST_ASSERT_FALSE(f.setData(bad.data(), bad.size()));
+
+    bad = lfa;
+    h = (lgfx::LFAfont::header_t*)bad.data();
+    h->page_count = 200;  // tables overrun the file
+    TEST_ASSERT_FALSE(f.setData(bad.data(), bad.size()));
+
+    TEST_ASSERT_TRUE(vlw2lfa::convert(vlw.data(), 20).empty());
+    TEST_ASSERT_TRUE(vlw2lfa::convert(vlw.data(), vlw.size() - 1).empty());
+
+    // Fields the atlas keeps in 8 bits must not wrap (a width past 255
+    // also overruns this font's bitmaps, so xAdvance and dx stand in)
+    auto wide = vlw;
+    wide[24 + 28 + 12 + 2] = 1;  // xAdvance of '!' = 256 + n
+    TEST_ASSERT_TRUE(vlw2lfa::convert(wide.data(), wide.size()).empty());
+    wide = vlw;
+    memcpy(&wide[24 + 28 + 20], "\0\0\0\xC8", 4);  // dx of '!' = 200
+    TEST_ASSERT_TRUE(vlw2lfa::convert(wide.data(), wide.size()).empty());
+}
+
+// Misaligned memory is refused in place; loadFont() copies it instead
+static void test_misaligned() {
+    std::vector<uint8_t> buf(lfa.size() + 4);
+    uint8_t* odd = buf.data() + 1;
+    if (lgfx::LFAfont::isAligned(odd)) odd++;
+    memcpy(odd, lfa.data(), lfa.size());
+
+    lgfx::LFAfont f;
+    TEST_ASSERT_TRUE(lgfx::LFAfont::isAligned(lfa.data()));
+    TEST_ASSERT_FALSE(lgfx::LFAfont::isAligned(odd));
+    TEST_ASSERT_FALSE(f.setData(odd, lfa.size()));
+
+    M5Canvas a, b;
+    setupSprite(a);
+    setupSprite(b);
+    TEST_ASSERT_TRUE(a.loadFont(odd));
+    TEST_ASSERT_EQUAL(lgfx::IFont::ft_lfa, a.getFont()->getType());
+    TEST_ASSERT_TRUE(b.loadFont(lfa.data()));
+    drawSample(a, 1, true);
+    drawSample(b, 1, true);
+    TEST_ASSERT_TRUE(pixels(a) == pixels(b));
+}
+
+// Loading through a DataWrapper copies the file into one block
+static void test_load_from_file() {
+    FILE* fp = fopen("/tmp/test_font_atlas.lfa", "wb");
+    fwrite(lfa.data(), 1, lfa.size(), fp);
+    fclose(fp);
+    fp = fopen("/tmp/test_font_atlas.lfa", "rb");
+    lgfx::DataWrapperT<FILE> file(fp);
+
+    M5Canvas a, b;
+    setupSprite(a);
+    setupSprite(b);
+    TEST_ASSERT_TRUE(a.loadFont(&file));  // reads everything, then closes fp
+    TEST_ASSERT_TRUE(b.loadFont(vlw.data()));
+    drawSample(a, 1, true);
+    drawSample(b, 1, true);
+    TEST_ASSERT_TRUE(pixels(a) == pixels(b));
+    b.unloadFont();
+}
+
+static double usPerFrame(M5Canvas& s, int n) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) drawSample(s, 1, false);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+}
+
+static void test_benchmark() {
+    FILE* fp = fopen(VLW_PATH, "wb");
+    fwrite(vlw.data(), 1, vlw.size(), fp);
+    fclose(fp);
+    fp = fopen(VLW_PATH, "rb");
+    lgfx::DataWrapperT<FILE> file(fp);
+
+    M5Canvas a, b;
+    setupSprite(a);
+    setupSprite(b);
+    TEST_ASSERT_TRUE(a.loadFont(&file));
+    TEST_ASSERT_TRUE(b.loadFont(lfa.data()));
+
+    const int n = 300;
+    double vlwUs = 1e9, lfaUs = 1e9;
+    for (int r = 0; r < 5; r++) {
+        vlwUs = std::min(vlwUs, usPerFrame(a, n));
+        lfaUs = std::min(lfaUs, usPerFrame(b, n));
+    }
+    a.unloadFont();  // closes fp
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "VLW file %.1f us/frame, LFA atlas %.1f us/frame (%.1fx), atlas %zu bytes",
+             vlwUs, lfaUs, vlwUs / lfaUs, lfa.size());
+    TEST_MESSAGE(msg);
+}
+
+int main(int, char**) {
+    vlw = makeVlw();
+    lfa = vlw2lfa::convert(vlw.data(), vlw.size());
+    UNITY_BEGIN();
+    RUN_TEST(test_convert_header);
+    RUN_TEST(test_identical_opaque);
+    RUN_TEST(test_identical_transparent);
+    RUN_TEST(test_identical_scaled);
+    RUN_TEST(test_lookup);
+    RUN_TEST(test_zero_copy);
+    RUN_TEST(test_reject_bad);
+    RUN_TEST(test_misaligned);
+    RUN_TEST(test_load_from_file);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+// Host test for the temperature/humidity fusion (src/fusion.cpp):
+// offsets, weights, missing sensors and clamping.
+// Run with: pio test -e native -f native/test_fusion
+
+#include <unity.h>
+#include <math.h>
+
+#include "fusion.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_single_sensor() {
+    FusionSensor s;
+    s.temperatureOffset = -0.5f;
+    s.humidityOffset    = 2.0f;
+    FusionInput in;
+    in.temperature = 22.0f;
+    in.humidity    = 40.0f;
+
+    FusionOutput out = fuseTemperatureHumidity(&s, &in, 1);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, out.temperature);
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, out.humidity);
+    TEST_ASSERT_EQUAL(1, out.sources);
+}
+
+void test_weighted() {
+    // SHT30 trusted 3:1 over a BME688 that reads 1.5 °C warm
+    FusionSensor s[2];
+    s[0].weight            = 3.0f;
+    s[1].weight            = 1.0f;
+    s[1].temperatureOffset = -1.5f;
+    FusionInput in[2];
+    in[0].temperature = 21.0f;
+    in[0].humidity    = 50.0f;
+    in[1].temperature = 23.5f;
+    in[1].humidity    = 46.0f;
+
+    FusionOutput out = fuseTemperatureHumidity(s, in, 2);
+    TEST_ASSERT_EQUAL_FLOAT((21.0f * 3 + 22.0f) / 4, out.temperature);
+    TEST_ASSERT_EQUAL_FLOAT((50.0f * 3 + 46.0f) / 4, out.humidity);
+    TEST_ASSERT_EQUAL(2, out.sources);
+
+    // Weight 0 ignores the sensor
+    s[1].weight = 0.0f;
+    out = fuseTemperatureHumidity(s, in, 2);
+    TEST_ASSERT_EQUAL_FLOAT(21.0f, out.temperature);
+    TEST_ASSERT_EQUAL(1, out.sources);
+}
+
+void test_missing() {
+    FusionSensor s[2];
+    FusionInput in[2];
+    FusionOutput out = fuseTemperatureHumidity(s, in, 2);
+    TEST_ASSERT_TRUE(isnan(out.temperature));
+    TEST_ASSERT_TRUE(isnan(out.humidity));
+    TEST_ASSERT_EQUAL(0, out.sources);
+
+    // Each quantity from whichever sensor has it
+    in[0].temperature = 20.0f;
+    in[1].humidity    = 55.0f;
+    out = fuseTemperatureHumidity(s, in, 2);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, out.temperature);
+    TEST_ASSERT_EQUAL_FLOAT(55.0f, out.humidity);
+    TEST_ASSERT_EQUAL(2, out.sources);
+}
+
+void test_clamp() {
+    FusionSensor s;
+    s.humidityOffset = 3.0f;
+    FusionInput in;
+    in.humidity = 99.0f;
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, fuseTemperatureHumidity(&s, &in, 1).humidity);
+    s.humidityOffset = -3.0f;
+    in.humidity      = 1.0f;
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fuseTemperatureHumidity(&s, &in, 1).humidity);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_sensor);
+    RUN_TEST(test_weighted);
+    RUN_TEST(test_missing);
+    RUN_TEST(test_clamp);
+    return UNITY_END();
+}
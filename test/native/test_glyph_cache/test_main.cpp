@@ -0,0 +1,151 @@
+// Host test + benchmark for the M5GFX glyph cache.
+// Run with: pio test -e native -f native/test_glyph_cache
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+static const int32_t W = 128;
+static const int32_t H = 128;
+
+static void setupSprite(M5Canvas& s, int depth) {
+    s.setColorDepth(depth);
+    s.createSprite(W, H);
+    s.fillScreen(TFT_BLACK);
+    s.setFont(&fonts::Font7);
+    s.setTextSize(2);
+    s.setTextDatum(middle_center);
+    s.setTextColor(TFT_WHITE, TFT_BLACK);
+}
+
+static size_t frameBytes(M5Canvas& s) {
+    return (size_t)W * H * ((s.getColorDepth() & lgfx::color_depth_t::bit_mask) >> 3);
+}
+
+static double usPerDraw(M5Canvas& s, const char* text, int n) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        s.drawString(text, W / 2, H / 2);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Cached glyphs must be pixel-identical to the RLE path, on miss and on hit
+static void checkIdentical(int depth) {
+    M5Canvas plain, cached;
+    setupSprite(plain, depth);
+    setupSprite(cached, depth);
+    lgfx::GlyphCache cache;
+    TEST_ASSERT_TRUE(cache.init(256 * 1024));
+    cached.setGlyphCache(&cache);
+
+    const char* texts[] = { "42", "100", "7", "0", "42" };
+    for (const char* t : texts) {
+        plain.fillScreen(TFT_BLACK);
+        cached.fillScreen(TFT_BLACK);
+        plain.setTextColor(TFT_RED, TFT_NAVY);
+        cached.setTextColor(TFT_RED, TFT_NAVY);
+        plain.drawString(t, W / 2, H / 2);
+        cached.drawString(t, W / 2, H / 2);
+        TEST_ASSERT_EQUAL_MEMORY(plain.getBuffer(), cached.getBuffer(), frameBytes(plain));
+    }
+    TEST_ASSERT_GREATER_THAN(0, cache.getHitCount());
+}
+
+void test_identical_rgb565() { checkIdentical(16); }
+void test_identical_rgb888() { checkIdentical(24); }
+
+void test_clipped_glyph_identical() {
+    M5Canvas plain, cached;
+    setupSprite(plain, 16);
+    setupSprite(cached, 16);
+    lgfx::GlyphCache cache;
+    TEST_ASSERT_TRUE(cache.init(64 * 1024));
+    cached.setGlyphCache(&cache);
+
+    plain.setClipRect(20, 40, 50, 30);
+    cached.setClipRect(20, 40, 50, 30);
+    for (int i = 0; i < 2; i++) {
+        plain.drawString("58", 10, H / 2);
+        cached.drawString("58", 10, H / 2);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(plain.getBuffer(), cached.getBuffer(), frameBytes(plain));
+}
+
+void test_transparent_text_bypasses_cache() {
+    M5Canvas s;
+    setupSprite(s, 16);
+    lgfx::GlyphCache cache;
+    TEST_ASSERT_TRUE(cache.init(64 * 1024));
+    s.setGlyphCache(&cache);
+    s.setTextColor(TFT_WHITE);
+    s.drawString("42", W / 2, H / 2);
+    TEST_ASSERT_EQUAL(0, cache.getMissCount());
+    TEST_ASSERT_EQUAL(0, cache.getUsedBytes());
+}
+
+void test_lru_eviction() {
+    M5Canvas s;
+    setupSprite(s, 16);
+    // Font7 at size 2 is 64x96 px per digit: 12 KiB at 16bpp
+    const size_t glyph = 64 * 96 * 2;
+    lgfx::GlyphCache cache;
+    TEST_ASSERT_TRUE(cache.init(2 * glyph));
+    s.setGlyphCache(&cache);
+
+    s.drawString("1", W / 2, H / 2);
+    s.drawString("2", W / 2, H / 2);
+    s.drawString("1", W / 2, H / 2);   // 1 is now most recent
+    s.drawString("3", W / 2, H / 2);   // evicts 2
+    TEST_ASSERT_EQUAL(1, cache.getEvictCount());
+    TEST_ASSERT_LESS_OR_EQUAL(cache.getMaxBytes(), cache.getUsedBytes());
+
+    cache.resetStats();
+    s.drawString("1", W / 2, H / 2);
+    TEST_ASSERT_EQUAL(1, cache.getHitCount());
+    s.drawString("2", W / 2, H / 2);
+    TEST_ASSERT_EQUAL(1, cache.getMissCount());
+}
+
+void test_benchmark_drawString() {
+    const int N = 20000;
+    M5Canvas plain, cached;
+    setupSprite(plain, 16);
+    setupSprite(cached, 16);
+    lgfx::GlyphCache cache;
+    TEST_ASSERT_TRUE(cache.init(64 * 1024));
+    cached.setGlyphCache(&cache);
+
+    usPerDraw(plain, "88", 100);
+    usPerDraw(cached, "88", 100);
+    cache.resetStats();
+    double a = usPerDraw(plain, "88", N);
+    double b = usPerDraw(cached, "88", N);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "drawString(\"88\") Font7x2 rgb565: %.2f us uncached, %.2f us cached (%.1fx)",
+             a, b, a / b);
+    TEST_MESSAGE(msg);
+
+    // Timings are only reported; every timed glyph must be a hit
+    TEST_ASSERT_EQUAL(2 * N, cache.getHitCount());
+    TEST_ASSERT_EQUAL(0, cache.getMissCount());
+    TEST_ASSERT_EQUAL_MEMORY(plain.getBuffer(), cached.getBuffer(), W * H * 2);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_identical_rgb565);
+    RUN_TEST(test_identical_rgb888);
+    RUN_TEST(test_clipped_glyph_identical);
+    RUN_TEST(test_transparent_text_bypasses_cache);
+    RUN_TEST(test_lru_eviction);
+    RUN_TEST(test_benchmark_drawString);
+    return UNITY_END();
+}
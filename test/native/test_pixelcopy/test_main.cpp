@@ -0,0 +1,217 @@
+// Host test + benchmark for the vectorized pixelcopy fast paths.
+// Run with: pio test -e native -f native/test_pixelcopy
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+typedef uint32_t (*copy_fn)(void*, uint32_t, uint32_t, lgfx::pixelcopy_t*);
+
+static const uint32_t BENCH_PIXELS = 320 * 240;
+static const int BENCH_ROUNDS = 50;
+
+void setUp() {}
+void tearDown() {}
+
+// Runs a non-affine copy the way Panel_Sprite does: one call per run, src
+// position carried in positions[0].
+static void runCopy(copy_fn fn, void* dst, const void* src, uint32_t start, uint32_t len,
+                    const void* palette = nullptr, uint8_t srcBits = 0) {
+    lgfx::pixelcopy_t pc;
+    pc.src_data = src;
+    pc.palette = palette;
+    pc.src_bits = srcBits;
+    pc.src_mask = (1 << srcBits) - 1;
+    pc.positions[0] = start;
+    fn(dst, 0, len, &pc);
+}
+
+template <typename TDst, typename TSrc>
+static void reference(TDst* dst, const TSrc* src, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        dst[i].set(lgfx::color_convert<TDst, TSrc>(src[i].get()));
+    }
+}
+
+// Every source value, at every start offset mod 16 and with ragged tails
+template <typename TDst, typename TSrc>
+static void checkRgb(const std::vector<TSrc>& src) {
+    copy_fn fn = lgfx::pixelcopy_t::copy_rgb_fast<TDst, TSrc>;
+    std::vector<TDst> want(src.size()), got(src.size());
+    reference(want.data(), src.data(), src.size());
+    runCopy(fn, got.data(), src.data(), 0, src.size());
+    TEST_ASSERT_EQUAL_MEMORY(want.data(), got.data(), src.size() * sizeof(TDst));
+
+    for (uint32_t start = 0; start < 16; start++) {
+        for (uint32_t len = 1; len < 70; len += 3) {
+            std::vector<TDst> part(len);
+            runCopy(fn, part.data(), src.data(), start, len);
+            TEST_ASSERT_EQUAL_MEMORY(&want[start], part.data(), len * sizeof(TDst));
+        }
+    }
+}
+
+template <typename T565>
+static std::vector<T565> all565() {
+    std::vector<T565> v(65536);
+    for (uint32_t i = 0; i < 65536; i++) v[i].raw = i;
+    return v;
+}
+
+template <typename T888>
+static std::vector<T888> all888() {
+    std::vector<T888> v(1 << 24);
+    for (uint32_t i = 0; i < (1u << 24); i++) {
+        v[i].r = i >> 16;
+        v[i].g = i >> 8;
+        v[i].b = i;
+    }
+    return v;
+}
+
+void test_888_to_565() {
+    auto bgr = all888<lgfx::bgr888_t>();
+    checkRgb<lgfx::swap565_t>(bgr);
+    checkRgb<lgfx::rgb565_t>(bgr);
+    auto rgb = all888<lgfx::rgb888_t>();
+    checkRgb<lgfx::swap565_t>(rgb);
+    checkRgb<lgfx::rgb565_t>(rgb);
+}
+
+void test_565_to_888() {
+    auto swapped = all565<lgfx::swap565_t>();
+    checkRgb<lgfx::bgr888_t>(swapped);
+    checkRgb<lgfx::rgb888_t>(swapped);
+    auto native = all565<lgfx::rgb565_t>();
+    checkRgb<lgfx::bgr888_t>(native);
+    checkRgb<lgfx::rgb888_t>(native);
+}
+
+template <typename TDst>
+static void checkPalette4() {
+    lgfx::bgr888_t pal[16];
+    for (int i = 0; i < 16; i++) {
+        pal[i].set(lgfx::color888(i * 17, 255 - i * 13, i * 7 + 3));
+    }
+    std::vector<uint8_t> src(4096);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 37 + (i >> 4));
+
+    copy_fn fn = lgfx::pixelcopy_t::copy_palette_fast<TDst, lgfx::bgr888_t>;
+    uint32_t total = src.size() * 2;
+    std::vector<TDst> want(total);
+    for (uint32_t i = 0; i < total; i++) {
+        uint8_t idx = (i & 1) ? (src[i >> 1] & 0x0F) : (src[i >> 1] >> 4);
+        want[i].set(lgfx::color_convert<TDst, lgfx::bgr888_t>(pal[idx].get()));
+    }
+    // odd starts begin on a low nibble
+    for (uint32_t start = 0; start < 8; start++) {
+        for (uint32_t len = 1; len < 200; len += 7) {
+            std::vector<TDst> got(len);
+            runCopy(fn, got.data(), src.data(), start, len, pal, 4);
+            TEST_ASSERT_EQUAL_MEMORY(&want[start], got.data(), len * sizeof(TDst));
+        }
+    }
+}
+
+void test_palette4_to_565() {
+    checkPalette4<lgfx::swap565_t>();
+    checkPalette4<lgfx::rgb565_t>();
+}
+
+// Sprite to sprite through pushSprite, which picks the fast path itself
+void test_sprite_push_identical() {
+    M5Canvas src, dst, ref;
+    src.setColorDepth(24);
+    src.createSprite(97, 31);
+    for (int y = 0; y < 31; y++) {
+        for (int x = 0; x < 97; x++) {
+            src.drawPixel(x, y, lgfx::color888(x * 3, y * 8, x ^ y));
+        }
+    }
+    dst.setColorDepth(16);
+    dst.createSprite(97, 31);
+    src.pushSprite(&dst, 0, 0);
+
+    ref.setColorDepth(16);
+    ref.createSprite(97, 31);
+    for (int y = 0; y < 31; y++) {
+        for (int x = 0; x < 97; x++) {
+            ref.drawPixel(x, y, lgfx::color888(x * 3, y * 8, x ^ y));
+        }
+    }
+    TEST_ASSERT_EQUAL_MEMORY(ref.getBuffer(), dst.getBuffer(), 97 * 31 * 2);
+}
+
+template <typename F>
+static double mpixPerSec(F&& f) {
+    f();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ROUNDS; i++) f();
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    return (double)BENCH_PIXELS * BENCH_ROUNDS / us;
+}
+
+template <typename TDst, typename TSrc>
+static void benchPair(const char* name) {
+    std::vector<TSrc> src(BENCH_PIXELS);
+    for (uint32_t i = 0; i < BENCH_PIXELS; i++) {
+        src[i].set(lgfx::color_convert<TSrc, lgfx::bgr888_t>(lgfx::color888(i, i >> 3, i >> 7)));
+    }
+    std::vector<TDst> dst(BENCH_PIXELS);
+    copy_fn fn = lgfx::pixelcopy_t::copy_rgb_fast<TDst, TSrc>;
+    double ref = mpixPerSec([&] { reference(dst.data(), src.data(), BENCH_PIXELS); });
+    double fast = mpixPerSec([&] { runCopy(fn, dst.data(), src.data(), 0, BENCH_PIXELS); });
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%-20s scalar %7.1f Mpx/s  pixelcopy %7.1f Mpx/s  (x%.1f)",
+             name, ref, fast, fast / ref);
+    TEST_MESSAGE(msg);
+}
+
+template <typename TDst>
+static void benchPalette4(const char* name) {
+    lgfx::bgr888_t pal[16];
+    for (int i = 0; i < 16; i++) pal[i].set(lgfx::color888(i * 16, i * 8, 255 - i * 16));
+    std::vector<uint8_t> src(BENCH_PIXELS / 2);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 37);
+    std::vector<TDst> dst(BENCH_PIXELS);
+    double ref = mpixPerSec([&] {
+        for (uint32_t i = 0; i < BENCH_PIXELS; i++) {
+            uint8_t idx = (i & 1) ? (src[i >> 1] & 0x0F) : (src[i >> 1] >> 4);
+            dst[i].set(lgfx::color_convert<TDst, lgfx::bgr888_t>(pal[idx].get()));
+        }
+    });
+    copy_fn fn = lgfx::pixelcopy_t::copy_palette_fast<TDst, lgfx::bgr888_t>;
+    double fast = mpixPerSec([&] { runCopy(fn, dst.data(), src.data(), 0, BENCH_PIXELS, pal, 4); });
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%-20s scalar %7.1f Mpx/s  pixelcopy %7.1f Mpx/s  (x%.1f)",
+             name, ref, fast, fast / ref);
+    TEST_MESSAGE(msg);
+}
+
+void test_benchmark() {
+    char msg[64];
+    snprintf(msg, sizeof(msg), "LGFX_PIXELCOPY_SIMD=%d, %u px x %d rounds",
+             LGFX_PIXELCOPY_SIMD, (unsigned)BENCH_PIXELS, BENCH_ROUNDS);
+    TEST_MESSAGE(msg);
+    benchPair<lgfx::swap565_t, lgfx::bgr888_t>("bgr888 -> swap565");
+    benchPair<lgfx::swap565_t, lgfx::rgb888_t>("rgb888 -> swap565");
+    benchPair<lgfx::rgb565_t , lgfx::bgr888_t>("bgr888 -> rgb565");
+    benchPair<lgfx::bgr888_t, lgfx::swap565_t>("swap565 -> bgr888");
+    benchPair<lgfx::rgb888_t, lgfx::rgb565_t >("rgb565 -> rgb888");
+    benchPalette4<lgfx::swap565_t>("pal4 -> swap565");
+    benchPalette4<lgfx::rgb565_t >("pal4 -> rgb565");
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_888_to_565);
+    RUN_TEST(test_565_to_888);
+    RUN_TEST(test_palette4_to_565);
+    RUN_TEST(test_sprite_push_identical);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+// Host test + benchmark for LGFXBase::writePng (streaming PNG encoder).
+// Run with: pio test -e native -f native/test_png_stream
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <lgfx/utility/lgfx_miniz.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct Sink {
+    std::vector<uint8_t> bytes;
+    size_t calls    = 0;
+    size_t maxPiece = 0;
+    size_t failAt   = 0; // fail on this call (1-based), 0 = never
+};
+
+static bool sinkWrite(const void* data, size_t len, void* user) {
+    Sink* s = (Sink*)user;
+    if (++s->calls == s->failAt) return false;
+    if (len > s->maxPiece) s->maxPiece = len;
+    s->bytes.insert(s->bytes.end(), (const uint8_t*)data, (const uint8_t*)data + len);
+    return true;
+}
+
+static void drawScene(LGFX_Sprite& s) {
+    s.fillScreen(0x2A2A2Au);
+    for (int32_t y = 0; y < s.height(); y += 7) {
+        s.drawFastHLine(0, y, s.width(), 0x444444u);
+    }
+    for (int32_t x = 0; x < s.width(); x++) {
+        s.drawPixel(x, (x * 37) % s.height(), (uint32_t)(x * 0x010203u));
+    }
+    s.fillCircle(s.width() / 2, s.height() / 2, s.height() / 4, 0xFF6384u);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_roundtrip() {
+    LGFX_Sprite src;
+    src.setColorDepth(24);
+    src.createSprite(200, 120);
+    drawScene(src);
+
+    Sink sink;
+    size_t n = src.writePng(sinkWrite, &sink);
+    TEST_ASSERT_GREATER_THAN(0, n);
+    TEST_ASSERT_EQUAL(sink.bytes.size(), n);
+
+    LGFX_Sprite out;
+    out.setColorDepth(24);
+    out.createSprite(200, 120);
+    TEST_ASSERT_TRUE(out.drawPng(sink.bytes.data(), sink.bytes.size(), 0, 0));
+    TEST_ASSERT_EQUAL_MEMORY(src.getBuffer(), out.getBuffer(), 200 * 120 * 3);
+}
+
+void test_region() {
+    LGFX_Sprite src;
+    src.setColorDepth(16);
+    src.createSprite(64, 64);
+    drawScene(src);
+
+    Sink sink;
+    TEST_ASSERT_GREATER_THAN(0, src.writePng(sinkWrite, &sink, 16, 8, 0, 0));
+    // IHDR width/height: 48 x 56 (0 = to the edge)
+    TEST_ASSERT_EQUAL(48, sink.bytes[19]);
+    TEST_ASSERT_EQUAL(56, sink.bytes[23]);
+
+    LGFX_Sprite out;
+    out.setColorDepth(16);
+    out.createSprite(48, 56);
+    TEST_ASSERT_TRUE(out.drawPng(sink.bytes.data(), sink.bytes.size(), 0, 0));
+    for (int32_t y = 0; y < 56; y++) {
+        for (int32_t x = 0; x < 48; x++) {
+            TEST_ASSERT_EQUAL(src.readPixel(x + 16, y + 8), out.readPixel(x, y));
+        }
+    }
+}
+
+void test_writer_failure() {
+    LGFX_Sprite src;
+    src.setColorDepth(16);
+    src.createSprite(64, 64);
+    drawScene(src);
+
+    Sink sink;
+    sink.failAt = 3;
+    TEST_ASSERT_EQUAL(0, src.writePng(sinkWrite, &sink));
+    TEST_ASSERT_EQUAL(0, src.writePng(nullptr, nullptr));
+}
+
+void test_benchmark() {
+    // A full 320x240 panel: createPng needs (1 + 3 * 320) * 240 = 230 KB of output buffer
+    const int32_t W = 320, H = 240;
+    const int RUNS = 20;
+    LGFX_Sprite src;
+    src.setColorDepth(16);
+    src.createSprite(W, H);
+    drawScene(src);
+
+    size_t lenA = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < RUNS; i++) {
+        void* p = src.createPng(&lenA, 0, 0, W, H);
+        free(p);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    Sink sink;
+    size_t lenB = 0;
+    for (int i = 0; i < RUNS; i++) {
+        sink.bytes.clear();
+        lenB = src.writePng(sinkWrite, &sink);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "%dx%d: createPng %.2f ms %u B, heap %u B | writePng %.2f ms %u B, heap %u B, largest piece %u B",
+             (int)W, (int)H,
+             std::chrono::duration<double, std::milli>(t1 - t0).count() / RUNS, (unsigned)lenA,
+             (unsigned)(sizeof(tdefl_compressor) + 57 + (1 + 3 * W) * H + 3 * W),
+             std::chrono::duration<double, std::milli>(t2 - t1).count() / RUNS, (unsigned)lenB,
+             (unsigned)(sizeof(tdefl_compressor) + 3 * W), (unsigned)sink.maxPiece);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN(0, lenB);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_roundtrip);
+    RUN_TEST(test_region);
+    RUN_TEST(test_writer_failure);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,203 @@
+// Host test + benchmark for LGFXBase::drawPolyline: matches drawWideLine
+// per segment, blends joints once, honours the clip rect.
+// Run with: pio test -e native -f native/test_polyline
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const int32_t W = 100;
+static const int32_t H = 100;
+
+static void makeSprite(lgfx::LGFX_Sprite& s, int32_t w = W, int32_t h = H) {
+    s.setColorDepth(16);
+    TEST_ASSERT_NOT_NULL(s.createSprite(w, h));
+    s.fillScreen(TFT_BLACK);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Two points draw exactly what drawWideLine draws
+void test_segment_matches_wide_line() {
+    const int32_t segs[][4] = {
+        { 20, 50, 80, 50 }, { 50, 20, 50, 80 }, { 20, 20, 80, 75 },
+        { 78, 22, 23, 61 }, { 30, 40, 31, 70 }, { 50, 50, 50, 50 },
+    };
+    const float radii[] = { 0.5f, 1.0f, 2.5f, 6.0f };
+    for (auto& sg : segs) {
+        for (float r : radii) {
+            lgfx::LGFX_Sprite a, b;
+            makeSprite(a);
+            makeSprite(b);
+            a.drawWideLine(sg[0], sg[1], sg[2], sg[3], r, TFT_WHITE);
+            lgfx::polyline_point_t pts[] = { { (float)sg[0], (float)sg[1] }, { (float)sg[2], (float)sg[3] } };
+            b.drawPolyline(pts, 2, r, TFT_WHITE);
+            TEST_ASSERT_EQUAL_MEMORY(a.getBuffer(), b.getBuffer(), W * H * 2);
+        }
+    }
+}
+
+// Each pixel gets the strongest single segment, not a pile of blends
+void test_joint_blended_once() {
+    const lgfx::polyline_point_t pts[] = { { 10, 80 }, { 30, 20 }, { 50, 80 }, { 70, 20 }, { 90, 60 }, { 60, 60 } };
+    const size_t n = sizeof(pts) / sizeof(pts[0]);
+    const float r = 1.5f;
+
+    lgfx::LGFX_Sprite poly, stacked;
+    makeSprite(poly);
+    makeSprite(stacked);
+    poly.drawPolyline(pts, n, r, TFT_WHITE);
+
+    std::vector<uint8_t> best(W * H, 0);
+    int32_t overdrawn = 0;
+    for (size_t i = 0; i + 1 < n; i++) {
+        lgfx::LGFX_Sprite one;
+        makeSprite(one);
+        one.drawWideLine(pts[i].x, pts[i].y, pts[i + 1].x, pts[i + 1].y, r, TFT_WHITE);
+        stacked.drawWideLine(pts[i].x, pts[i].y, pts[i + 1].x, pts[i + 1].y, r, TFT_WHITE);
+        for (int32_t y = 0; y < H; y++) {
+            for (int32_t x = 0; x < W; x++) {
+                uint8_t g = one.readPixelRGB(x, y).G8();
+                if (g > best[y * W + x]) best[y * W + x] = g;
+            }
+        }
+    }
+    for (int32_t y = 0; y < H; y++) {
+        for (int32_t x = 0; x < W; x++) {
+            TEST_ASSERT_EQUAL(best[y * W + x], poly.readPixelRGB(x, y).G8());
+            if (stacked.readPixelRGB(x, y).G8() != best[y * W + x]) overdrawn++;
+        }
+    }
+    // Drawing segment by segment does over-blend the joints
+    TEST_ASSERT_TRUE(overdrawn > 0);
+}
+
+// Splitting a straight line into collinear pieces changes nothing
+void test_collinear_split() {
+    const lgfx::polyline_point_t whole[] = { { 10, 15 }, { 90, 85 } };
+    const lgfx::polyline_point_t split[] = { { 10, 15 }, { 26, 29 }, { 58, 57 }, { 90, 85 } };
+    lgfx::LGFX_Sprite a, b;
+    makeSprite(a);
+    makeSprite(b);
+    a.drawPolyline(whole, 2, 2.0f, TFT_WHITE);
+    b.drawPolyline(split, 4, 2.0f, TFT_WHITE);
+    for (int32_t y = 0; y < H; y++) {
+        for (int32_t x = 0; x < W; x++) {
+            int d = (int)a.readPixelRGB(x, y).G8() - (int)b.readPixelRGB(x, y).G8();
+            TEST_ASSERT_TRUE(abs(d) <= 4); // rounding of the distance only
+        }
+    }
+}
+
+void test_clip_rect() {
+    const lgfx::polyline_point_t pts[] = { { 0, 0 }, { 100, 100 }, { 100, 0 } };
+    lgfx::LGFX_Sprite s;
+    makeSprite(s);
+    s.setClipRect(20, 30, 40, 25);
+    s.drawPolyline(pts, 3, 3.0f, TFT_WHITE);
+
+    int32_t cx, cy, cw, ch;
+    s.getClipRect(&cx, &cy, &cw, &ch);
+    TEST_ASSERT_EQUAL(20, cx);
+    TEST_ASSERT_EQUAL(30, cy);
+    TEST_ASSERT_EQUAL(40, cw);
+    TEST_ASSERT_EQUAL(25, ch);
+
+    int32_t inside = 0;
+    for (int32_t y = 0; y < H; y++) {
+        for (int32_t x = 0; x < W; x++) {
+            bool in = x >= 20 && x < 60 && y >= 30 && y < 55;
+            uint32_t c = s.readPixel(x, y);
+            if (!in) TEST_ASSERT_EQUAL(0, c);
+            else if (c) inside++;
+        }
+    }
+    TEST_ASSERT_TRUE(inside > 0);
+
+    // Nothing at all inside the clip rect: no-op
+    s.fillScreen(TFT_BLACK);
+    const lgfx::polyline_point_t away[] = { { 80, 80 }, { 95, 90 } };
+    s.drawPolyline(away, 2, 1.0f, TFT_WHITE);
+    s.clearClipRect();
+    TEST_ASSERT_EQUAL(0, s.readPixel(88, 85));
+
+    // Degenerate input
+    s.drawPolyline(nullptr, 5, 1.0f, TFT_WHITE);
+    s.drawPolyline(away, 0, 1.0f, TFT_WHITE);
+    const lgfx::polyline_point_t spot[] = { { 50, 50 } };
+    s.drawPolyline(spot, 1, 3.0f, TFT_WHITE);
+    TEST_ASSERT_NOT_EQUAL(0, s.readPixel(50, 50));
+}
+
+template <typename F>
+static double batchUs(int n, F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+}
+
+// Alternates batches of both and keeps the best of each, so clock and
+// load drift on a shared host hits both sides alike
+template <typename FA, typename FB>
+static void compare(const char* nameA, FA&& fa, const char* nameB, FB&& fb) {
+    const int N = 20;
+    double a = 1e30, b = 1e30;
+    fa();
+    fb();
+    for (int k = 0; k < 15; k++) {
+        double ta = batchUs(N, fa);
+        double tb = batchUs(N, fb);
+        if (ta < a) a = ta;
+        if (tb < b) b = tb;
+    }
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%-30s %9.1f us/trace", nameA, a);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "%-30s %9.1f us/trace (%.2fx)", nameB, b, a / b);
+    TEST_MESSAGE(msg);
+}
+
+// 1000-point sensor trace across a chart-sized sprite
+void test_benchmark() {
+    const size_t n = 1000;
+    const int32_t cw = 320, ch = 160;
+    std::vector<lgfx::polyline_point_t> pts(n);
+    for (size_t i = 0; i < n; i++) {
+        pts[i].x = roundf(i * (cw - 1) / (float)(n - 1));
+        pts[i].y = roundf(ch / 2 + 55 * sinf(i * 0.013f) + 8 * sinf(i * 0.31f));
+    }
+
+    lgfx::LGFX_Sprite s;
+    makeSprite(s, cw, ch);
+    const float radii[] = { 0.5f, 1.0f, 1.5f };
+    for (float r : radii) {
+        char nameA[48], nameB[48];
+        snprintf(nameA, sizeof(nameA), "drawWideLine x999 r=%.1f", r);
+        snprintf(nameB, sizeof(nameB), "drawPolyline r=%.1f", r);
+        compare(nameA, [&]() {
+            s.startWrite();
+            for (size_t i = 0; i + 1 < n; i++) {
+                s.drawWideLine(pts[i].x, pts[i].y, pts[i + 1].x, pts[i + 1].y, r, TFT_WHITE);
+            }
+            s.endWrite();
+        }, nameB, [&]() {
+            s.drawPolyline(pts.data(), n, r, TFT_WHITE);
+        });
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_segment_matches_wide_line);
+    RUN_TEST(test_joint_blended_once);
+    RUN_TEST(test_collinear_split);
+    RUN_TEST(test_clip_rect);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,224 @@
+// Host test + benchmark for the M5GFX profiler (LGFX_PROFILER=1).
+// Run with: pio test -e native_profile -f native/test_profiler
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <lgfx/v1/Bus.hpp>
+#include <lgfx/v1/panel/Panel_ST7789.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if LGFX_PROFILER
+
+static const int32_t W = 128;
+static const int32_t H = 128;
+
+// Stands in for the SPI bus and counts every byte the panel sends
+struct CountingBus : public lgfx::IBus {
+    uint64_t bytes = 0;
+    std::vector<uint8_t> dma;
+
+    lgfx::bus_type_t busType(void) const override { return lgfx::bus_type_t::bus_spi; }
+    bool init(void) override { return true; }
+    void release(void) override {}
+    void beginTransaction(void) override {}
+    void endTransaction(void) override {}
+    void wait(void) override {}
+    bool busy(void) const override { return false; }
+    void initDMA(void) override {}
+    void addDMAQueue(const uint8_t*, uint32_t length) override { bytes += length; }
+    void execDMAQueue(void) override {}
+    uint8_t* getDMABuffer(uint32_t length) override {
+        dma.resize(length);
+        return dma.data();
+    }
+    void flush(void) override {}
+    bool writeCommand(uint32_t, uint_fast8_t bit_length) override {
+        bytes += bit_length >> 3;
+        return true;
+    }
+    void writeData(uint32_t, uint_fast8_t bit_length) override { bytes += bit_length >> 3; }
+    void writeDataRepeat(uint32_t, uint_fast8_t bit_length, uint32_t count) override {
+        bytes += (uint64_t)(bit_length >> 3) * count;
+    }
+    void writePixels(lgfx::pixelcopy_t* pc, uint32_t length) override {
+        std::vector<uint8_t> buf(length * (pc->dst_bits >> 3));
+        pc->fp_copy(buf.data(), 0, length, pc);
+        bytes += buf.size();
+    }
+    void writeBytes(const uint8_t*, uint32_t length, bool, bool) override { bytes += length; }
+    void beginRead(void) override {}
+    void endRead(void) override {}
+    uint32_t readData(uint_fast8_t) override { return 0; }
+    bool readBytes(uint8_t*, uint32_t, bool) override { return false; }
+    void readPixels(void*, lgfx::pixelcopy_t*, uint32_t) override {}
+};
+
+static CountingBus bus;
+static lgfx::Panel_ST7789 panel;
+static lgfx::LGFX_Device lcd;
+
+static const lgfx::profile_entry_t& entry(lgfx::profile_id_t id) {
+    return lgfx::Profiler::entries[id];
+}
+
+void setUp() {
+    bus.bytes = 0;
+    lgfx::Profiler::reset();
+}
+void tearDown() {}
+
+static void test_fill_screen() {
+    lcd.fillScreen(TFT_RED);
+    TEST_ASSERT_EQUAL(1, entry(lgfx::prof_fill_rect).calls);
+    TEST_ASSERT_GREATER_OR_EQUAL(W * H * 2, entry(lgfx::prof_bus).bytes);
+    // every byte the panel sent was seen, and credited to fillRect
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_bus).bytes);
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_fill_rect).bytes);
+    TEST_ASSERT_GREATER_THAN(0, entry(lgfx::prof_fill_rect).cycles);
+}
+
+static void test_push_sprite() {
+    M5Canvas s(&lcd);
+    s.setColorDepth(16);
+    s.createSprite(64, 40);
+    s.fillScreen(TFT_BLUE);
+    lgfx::Profiler::reset();
+    bus.bytes = 0;
+
+    s.pushSprite(10, 20);
+    TEST_ASSERT_EQUAL(1, entry(lgfx::prof_push_sprite).calls);
+    TEST_ASSERT_EQUAL(1, entry(lgfx::prof_push_image).calls);
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_bus).bytes);
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_push_sprite).bytes);
+    // nested primitive is timed but its bytes belong to the outer call
+    TEST_ASSERT_EQUAL_UINT64(0, entry(lgfx::prof_push_image).bytes);
+    TEST_ASSERT_GREATER_OR_EQUAL(entry(lgfx::prof_push_image).cycles, entry(lgfx::prof_push_sprite).cycles);
+}
+
+static void test_nested_text() {
+    lcd.setFont(&fonts::Font2);
+    lcd.setTextColor(TFT_WHITE, TFT_BLACK);
+    lcd.drawString("RH 45%", 4, 4);
+    TEST_ASSERT_EQUAL(1, entry(lgfx::prof_draw_string).calls);
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_draw_string).bytes);
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_bus).bytes);
+    TEST_ASSERT_EQUAL_UINT64(0, entry(lgfx::prof_fill_rect).bytes);
+    TEST_ASSERT_EQUAL(lgfx::prof_max, lgfx::Profiler::current);
+
+    lcd.setCursor(0, 40);
+    lcd.print("ab");
+    TEST_ASSERT_EQUAL(2, entry(lgfx::prof_print).calls);
+}
+
+// Probes on sprites count time but no bus bytes
+static void test_sprite_no_bus() {
+    M5Canvas s;
+    s.setColorDepth(16);
+    s.createSprite(32, 32);
+    s.fillRect(0, 0, 8, 8, TFT_GREEN);
+    TEST_ASSERT_EQUAL(1, entry(lgfx::prof_fill_rect).calls);
+    TEST_ASSERT_EQUAL_UINT64(0, entry(lgfx::prof_bus).bytes);
+}
+
+static void test_frame_scope() {
+    {
+        LGFX_PROFILE_SCOPE(lgfx::prof_frame);
+        lcd.fillRect(0, 0, 10, 10, TFT_YELLOW);
+        lcd.fillRect(0, 10, 10, 10, TFT_YELLOW);
+    }
+    TEST_ASSERT_EQUAL(1, entry(lgfx::prof_frame).calls);
+    TEST_ASSERT_EQUAL(2, entry(lgfx::prof_fill_rect).calls);
+    TEST_ASSERT_EQUAL_UINT64(bus.bytes, entry(lgfx::prof_frame).bytes);
+    TEST_ASSERT_GREATER_OR_EQUAL(entry(lgfx::prof_fill_rect).cycles, entry(lgfx::prof_frame).cycles);
+}
+
+static void test_dump() {
+    lcd.fillScreen(TFT_BLACK);
+    char buf[1024];
+    size_t n = lgfx::Profiler::printTo(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(strlen(buf), n);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "fillRect"));
+    TEST_ASSERT_NULL(strstr(buf, "drawString"));  // not called since reset
+
+    n = lgfx::Profiler::printJson(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(strlen(buf), n);
+    TEST_ASSERT_EQUAL('{', buf[0]);
+    TEST_ASSERT_EQUAL('}', buf[n - 1]);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"fillRect\":{\"calls\":1,"));
+
+    // A short buffer drops whole members and still closes the object
+    char small[100];
+    n = lgfx::Profiler::printJson(small, sizeof(small));
+    TEST_ASSERT_EQUAL(strlen(small), n);
+    TEST_ASSERT_EQUAL(0, strncmp(small, "{\"cpuMHz\":1000,\"frame\":{", 24));
+    TEST_ASSERT_NULL(strstr(small, "fillRect"));
+    TEST_ASSERT_EQUAL_STRING("}}", small + n - 2);
+
+    n = lgfx::Profiler::printJson(small, 16);
+    TEST_ASSERT_EQUAL_STRING("{\"cpuMHz\":1000}", small);
+    TEST_ASSERT_EQUAL(15, n);
+    n = lgfx::Profiler::printJson(small, 8);
+    TEST_ASSERT_EQUAL_STRING("{}", small);
+    TEST_ASSERT_EQUAL(2, n);
+}
+
+static void test_benchmark() {
+    M5Canvas s;
+    s.setColorDepth(16);
+    s.createSprite(W, H);
+
+    const int n = 200000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        LGFX_PROFILE_SCOPE(lgfx::prof_frame);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        s.fillRect(i & 63, 0, 2, 2, TFT_WHITE);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double scopeNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    double fillNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / n;
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "probe %.1f ns/scope, 2x2 fillRect %.1f ns incl. probe", scopeNs, fillNs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL(n, entry(lgfx::prof_frame).calls);
+}
+
+int main(int, char**) {
+    auto cfg = panel.config();
+    cfg.panel_width = W;
+    cfg.panel_height = H;
+    cfg.memory_width = W;
+    cfg.memory_height = H;
+    cfg.pin_rst = -1;
+    cfg.pin_cs = -1;
+    panel.config(cfg);
+    panel.setBus(&bus);
+    lcd.setPanel(&panel);
+    lcd.init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_screen);
+    RUN_TEST(test_push_sprite);
+    RUN_TEST(test_nested_text);
+    RUN_TEST(test_sprite_no_bus);
+    RUN_TEST(test_frame_scope);
+    RUN_TEST(test_dump);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
+
+#else
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    TEST_MESSAGE("built without LGFX_PROFILER, nothing to test");
+    return UNITY_END();
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Host test + benchmark for the AP screen QR codes (src/qr.cpp): WIFI:
+// escaping, cache keys, and encode + draw against a cached blit.
+// Run with: pio test -e native -f native/test_qr
+
+#include <unity.h>
+#include <M5GFX.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "qr.h"
+
+static const char* SSID = "AtomS3-RH-Sensor";
+static const char* PASS = "12345678";
+static const char* URL  = "http://192.168.4.1/";
+
+void setUp() {}
+void tearDown() {}
+
+void test_wifi_text() {
+    char buf[128];
+    TEST_ASSERT_TRUE(qrWifiText(buf, sizeof(buf), SSID, PASS));
+    TEST_ASSERT_EQUAL_STRING("WIFI:T:WPA;S:AtomS3-RH-Sensor;P:12345678;;", buf);
+
+    TEST_ASSERT_TRUE(qrWifiText(buf, sizeof(buf), "a;b,c", "p:\"q\\"));
+    TEST_ASSERT_EQUAL_STRING("WIFI:T:WPA;S:a\\;b\\,c;P:p\\:\\\"q\\\\;;", buf);
+
+    // Too small: fails and leaves an empty string
+    TEST_ASSERT_FALSE(qrWifiText(buf, 20, SSID, PASS));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+}
+
+void test_cache_key() {
+    uint32_t k = qrCacheKey(URL);
+    TEST_ASSERT_EQUAL(k, qrCacheKey(URL));
+    TEST_ASSERT_NOT_EQUAL(k, qrCacheKey("http://192.168.4.2/"));
+
+    static QrCache cache;
+    TEST_ASSERT_FALSE(cache.valid(k));
+    TEST_ASSERT_TRUE(qrBuild(&cache, k, URL));
+    TEST_ASSERT_TRUE(cache.valid(k));
+    TEST_ASSERT_FALSE(cache.valid(k + 1));
+}
+
+void test_encode_limits() {
+    static QrBitmap bm;
+    TEST_ASSERT_TRUE(qrEncode(URL, &bm));
+    TEST_ASSERT_EQUAL(2, bm.version);
+    TEST_ASSERT_EQUAL(25, bm.size);
+
+    // Longest SSID and password with every character escaped
+    char ssid[33], pass[64], text[256];
+    memset(ssid, ';', 32); ssid[32] = 0;
+    memset(pass, ':', 63); pass[63] = 0;
+    TEST_ASSERT_TRUE(qrWifiText(text, sizeof(text), ssid, pass));
+    TEST_ASSERT_TRUE(qrEncode(text, &bm));
+    TEST_ASSERT_TRUE(bm.version <= QR_MAX_VERSION);
+
+    char tooLong[400];
+    memset(tooLong, 'x', sizeof(tooLong) - 1); tooLong[sizeof(tooLong) - 1] = 0;
+    TEST_ASSERT_FALSE(qrEncode(tooLong, &bm));
+    TEST_ASSERT_EQUAL(0, bm.size);
+}
+
+// The cached blit must match LGFXBase::qrcode() pixel for pixel
+void test_draw_matches_qrcode() {
+    static QrBitmap bm;
+    const char* texts[] = { URL, "WIFI:T:WPA;S:AtomS3-RH-Sensor;P:12345678;;" };
+    const int32_t widths[] = { 62, 100, 128 };
+    for (const char* text : texts) {
+        TEST_ASSERT_TRUE(qrEncode(text, &bm));
+        for (int32_t w : widths) {
+            lgfx::LGFX_Sprite a, b;
+            a.setColorDepth(16);
+            b.setColorDepth(16);
+            TEST_ASSERT_NOT_NULL(a.createSprite(130, 130));
+            TEST_ASSERT_NOT_NULL(b.createSprite(130, 130));
+            a.fillScreen(TFT_RED);
+            b.fillScreen(TFT_RED);
+            a.qrcode(text, 1, 1, w, 1, false);
+            qrDraw(&b, bm, 1, 1, w);
+            TEST_ASSERT_EQUAL_MEMORY(a.getBuffer(), b.getBuffer(), 130 * 130 * 2);
+        }
+    }
+}
+
+template <typename F>
+static double usPer(int n, F&& f) {
+    f();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / n;
+}
+
+static void report(const char* name, double us) {
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%-28s %8.1f us", name, us);
+    TEST_MESSAGE(msg);
+}
+
+// Boot path before (qrcode() encodes both codes on every draw) and after
+// (WiFi code encoded once into RAM, URL code loaded from the cache)
+void test_benchmark() {
+    const int N = 2000;
+    char wifi[128];
+    qrWifiText(wifi, sizeof(wifi), SSID, PASS);
+
+    lgfx::LGFX_Sprite s;
+    s.setColorDepth(16);
+    s.createSprite(128, 128);
+
+    report("qrcode() both", usPer(N, [&]() {
+        s.qrcode(wifi, 1, 1, 62, 1, false);
+        s.qrcode(URL, 65, 1, 62, 1, false);
+    }));
+
+    static QrBitmap wifiBm;
+    static QrCache cache;
+    report("encode WiFi", usPer(N, [&]() {
+        qrEncode(wifi, &wifiBm);
+    }));
+    report("encode URL (cache miss)", usPer(N, [&]() {
+        qrBuild(&cache, 1, URL);
+    }));
+    report("blit both", usPer(N, [&]() {
+        qrDraw(&s, wifiBm, 1, 1, 62);
+        qrDraw(&s, cache.url, 65, 1, 62);
+    }));
+    char msg[64];
+    snprintf(msg, sizeof(msg), "cache file %u bytes", (unsigned)sizeof(QrCache));
+    TEST_MESSAGE(msg);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_wifi_text);
+    RUN_TEST(test_cache_key);
+    RUN_TEST(test_encode_limits);
+    RUN_TEST(test_draw_matches_qrcode);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
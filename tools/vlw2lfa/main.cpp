@@ -0,0 +1,38 @@
+// Converts a Processing .vlw font into an LFA atlas for SPIFFS.
+// Build: g++ -std=c++17 -O2 -o vlw2lfa main.cpp
+// Usage: vlw2lfa in.vlw data/font.lfa
+
+#include <cstdio>
+#include <vector>
+#include "vlw2lfa.hpp"
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s in.vlw out.lfa\n", argv[0]);
+        return 2;
+    }
+    FILE* in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> vlw;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) vlw.insert(vlw.end(), buf, buf + n);
+    fclose(in);
+
+    std::vector<uint8_t> lfa = vlw2lfa::convert(vlw.data(), vlw.size());
+    if (lfa.empty()) {
+        fprintf(stderr, "%s: not a usable VLW font\n", argv[1]);
+        return 1;
+    }
+    FILE* out = fopen(argv[2], "wb");
+    if (!out || fwrite(lfa.data(), 1, lfa.size(), out) != lfa.size()) {
+        perror(argv[2]);
+        return 1;
+    }
+    fclose(out);
+    printf("%s: %zu glyphs, %zu -> %zu bytes\n", argv[2], (size_t)(lfa[4] | lfa[5] << 8), vlw.size(), lfa.size());
+    return 0;
+}
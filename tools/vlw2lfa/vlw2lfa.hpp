@@ -0,0 +1,125 @@
+// VLW -> LFA font atlas conversion (see lgfx::LFAfont for the layout).
+// Header-only so the host tests can convert fonts in memory.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace vlw2lfa {
+
+static inline uint32_t readBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+template <typename T>
+static inline void put(std::vector<uint8_t>& out, size_t pos, T v) {
+    memcpy(&out[pos], &v, sizeof(T));
+}
+
+// Returns an empty vector if the input is not a usable VLW font.
+// Metrics are derived exactly like VLWfont::loadFont so both render
+// the same text at the same positions.
+static inline std::vector<uint8_t> convert(const uint8_t* vlw, size_t length) {
+    std::vector<uint8_t> out;
+    if (length < 24) return out;
+
+    uint32_t count = readBE32(vlw);
+    int yAdvance = (int)readBE32(vlw + 8);
+    int ascent = std::abs((int32_t)readBE32(vlw + 16));
+    int descent = std::abs((int32_t)readBE32(vlw + 20));
+    if (count == 0 || count > 0xFFFE || 24 + (size_t)count * 28 > length) return out;
+
+    int maxAscent = ascent;
+    int maxDescent = descent;
+    yAdvance = std::max(yAdvance, ascent + descent);
+    int spaceWidth = yAdvance * 2 / 7;
+
+    // Glyph records, in file order (VLW stores them sorted by code)
+    struct Rec { uint16_t code, height; uint8_t width, xAdvance; int8_t dx; int16_t dy; size_t src; };
+    std::vector<Rec> recs(count);
+    size_t bitmapPtr = 24 + (size_t)count * 28;
+    size_t bitmapBytes = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* g = vlw + 24 + i * 28;
+        Rec& r = recs[i];
+        r.code = (uint16_t)readBE32(g);
+        uint32_t h = readBE32(g + 4);
+        uint32_t w = readBE32(g + 8);
+        uint32_t xAdvance = readBE32(g + 12);
+        int32_t dy = (int32_t)readBE32(g + 16);
+        int32_t dx = (int32_t)readBE32(g + 20);
+        // The atlas stores these in 8/16 bits; refuse rather than wrap
+        if (h > 255 || w > 255 || xAdvance > 255) return out;
+        if (dx < INT8_MIN || dx > INT8_MAX || dy < INT16_MIN || dy > INT16_MAX) return out;
+        r.height = (uint16_t)h;
+        r.width = (uint8_t)w;
+        r.xAdvance = (uint8_t)xAdvance;
+        r.dy = (int16_t)dy;
+        r.dx = (int8_t)dx;
+        r.src = bitmapPtr;
+        bitmapPtr += (size_t)r.width * r.height;
+        bitmapBytes += (size_t)r.width * r.height;
+        if (bitmapPtr > length) return out;
+
+        if ((r.code > 0xFF) || ((r.code > 0x20) && (r.code < 0xA0) && (r.code != 0x7F))) {
+            if (maxAscent < r.dy && r.code != 0x3000) maxAscent = r.dy;
+            if (maxDescent < (r.height - r.dy) && r.code != 0x3000) maxDescent = r.height - r.dy;
+        }
+    }
+    yAdvance = maxAscent + maxDescent;
+
+    // Two-level code table: one 256-entry page per used high byte
+    std::vector<uint16_t> pageIndex(256, 0xFFFF);
+    uint16_t pageCount = 0;
+    for (auto& r : recs) {
+        if (pageIndex[r.code >> 8] == 0xFFFF) pageIndex[r.code >> 8] = pageCount++;
+    }
+
+    const size_t headerSize = 32;
+    const size_t glyphSize = 12;
+    size_t pagesOffset = headerSize + 256 * 2;
+    size_t glyphOffset = pagesOffset + (size_t)pageCount * 256 * 2;
+    size_t bitmapOffset = glyphOffset + (size_t)count * glyphSize;
+    size_t fileSize = bitmapOffset + bitmapBytes;
+
+    out.assign(fileSize, 0);
+    memcpy(&out[0], "LFA1", 4);
+    put<uint16_t>(out, 4, (uint16_t)count);
+    put<uint16_t>(out, 6, pageCount);
+    put<uint16_t>(out, 8, (uint16_t)yAdvance);
+    put<uint16_t>(out, 10, (uint16_t)spaceWidth);
+    put<uint16_t>(out, 12, (uint16_t)maxAscent);
+    put<uint16_t>(out, 14, (uint16_t)maxDescent);
+    put<uint32_t>(out, 16, (uint32_t)glyphOffset);
+    put<uint32_t>(out, 20, (uint32_t)bitmapOffset);
+    put<uint32_t>(out, 24, (uint32_t)fileSize);
+
+    for (int i = 0; i < 256; i++) put<uint16_t>(out, headerSize + i * 2, pageIndex[i]);
+    for (size_t i = 0; i < (size_t)pageCount * 256; i++) put<uint16_t>(out, pagesOffset + i * 2, 0xFFFF);
+
+    uint32_t bitmap = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const Rec& r = recs[i];
+        size_t slot = pagesOffset + ((size_t)pageIndex[r.code >> 8] * 256 + (r.code & 0xFF)) * 2;
+        put<uint16_t>(out, slot, (uint16_t)i);
+
+        size_t g = glyphOffset + i * glyphSize;
+        put<uint32_t>(out, g, bitmap);
+        out[g + 4] = r.width;
+        out[g + 5] = (uint8_t)r.height;
+        out[g + 6] = r.xAdvance;
+        out[g + 7] = (uint8_t)r.dx;
+        put<int16_t>(out, g + 8, r.dy);
+        put<uint16_t>(out, g + 10, r.code);
+
+        size_t n = (size_t)r.width * r.height;
+        memcpy(&out[bitmapOffset + bitmap], vlw + r.src, n);
+        bitmap += n;
+    }
+    return out;
+}
+
+}  // namespace vlw2lfa